@@ -7,7 +7,8 @@
  * To create a new one, you have to provide several things:
  *   - a vector of hosts on which the activity will execute
  *   - a vector of values, the amount of computation for each of the hosts (in flops)
- *   - a matrix of values, the amount of communication between each pair of hosts (in bytes)
+ *   - a matrix of values, the amount of communication between each pair of hosts (in bytes). When only a few pairs
+ *     of hosts communicate, this can also be given as a sparse list of transfers with Exec::set_transfers()
  *
  * Each of these operation will be processed at the same relative speed.
  * This means that at some point in time, all sub-executions and all sub-communications will be at 20% of completion.
@@ -102,9 +103,8 @@ static void runner()
   activity->suspend();
 
   XBT_INFO("  - Now, simulate the reconfiguration (modeled as a comm from the removed host to the remaining ones).");
-  std::vector<double> rescheduling_comp{0, 0, 0};
-  std::vector<double> rescheduling_comm{0, 0, 0, 0, 0, 0, 25000, 25000, 0};
-  sg4::this_actor::parallel_execute(hosts, rescheduling_comp, rescheduling_comm);
+  // Only two pairs of hosts communicate here, so give these transfers as a sparse list instead of a 3x3 matrix
+  sg4::Exec::init()->set_transfers({{2, 0, 25000}, {2, 1, 25000}})->set_hosts(hosts)->wait();
 
   XBT_INFO("  - Now, let's cancel the old task and create a new task with modified comm and computation vectors:");
   XBT_INFO("    What was already done is removed, and the load of the removed host is shared between remaining ones.");
@@ -243,6 +243,7 @@ class Timer;
 namespace routing {
 class NetPoint;
 class NetZoneImpl;
+class PlatformSnapshot;
 }
 namespace profile {
 class Event;
@@ -55,7 +55,18 @@ public:
    */
   using UpdateCb = void(std::vector<DatedValue>& values);
 
+  /** @brief Loads a profile from a file, or retrieves it if that file was already loaded.
+   *
+   * The deterministic profiles are read progressively as the simulation advances, and the binary profiles written by
+   * to_binary_file() are mapped in memory. The events are stored only once, whatever the amount of resources using
+   * that profile.
+   */
   static Profile* from_file(const std::string& path);
+  /** @brief Converts a deterministic profile file into a binary file, that from_file() maps in memory without parsing.
+   *
+   * The binary form can only be read on machines with the same byte order.
+   */
+  static void to_binary_file(const std::string& path, const std::string& binary_path);
   static Profile* from_string(const std::string& name, const std::string& input, double periodicity);
 
   static Profile* from_void();
@@ -86,6 +86,7 @@ protected:
  */
 class XBT_PRIVATE ClusterBase : public ClusterZone {
   friend s4u::NetZone;
+  friend PlatformSnapshot;
   /* We use a map instead of a std::vector here because that's a sparse vector. Some values may not exist */
   /* The pair is {link_up, link_down} */
   std::unordered_map<unsigned long, std::pair<resource::StandardLinkImpl*, resource::StandardLinkImpl*>> private_links_;
@@ -94,6 +95,8 @@ class XBT_PRIVATE ClusterBase : public ClusterZone {
   NetPoint* router_                     = nullptr;
   bool has_limiter_                     = false;
   bool has_loopback_                    = false;
+  bool lazy_links_                      = false;
+  std::unordered_map<unsigned long, unsigned long> leaf_positions_; //!< netpoint id -> leaf position (lazy mode only)
   int tot_elements_                     = 0;
   std::vector<unsigned long> dims_;
   // Callbacks
@@ -139,6 +142,8 @@ class XBT_PRIVATE ClusterBase : public ClusterZone {
 
   unsigned long num_links_per_node_ = 1; /* may be 1 (if only a private link), 2 or 3 (if limiter and loopback) */
 
+  std::vector<unsigned long> index_to_dims(unsigned long index) const;
+
   s4u::Link::SharingPolicy link_sharing_policy_ =
       s4u::Link::SharingPolicy::SPLITDUPLEX; //!< cluster links: sharing policy
   double link_bw_  = 0.0;                    //!< cluster links: bandwidth
@@ -148,14 +153,25 @@ protected:
   using ClusterZone::ClusterZone;
   void set_cluster_dimensions(const std::vector<unsigned long>& dimensions) { dims_ = dimensions; }
   void set_num_links_per_node(unsigned long num) { num_links_per_node_ = num; }
-  resource::StandardLinkImpl* get_uplink_from(unsigned long position) const
-  {
-    return private_links_.at(position).first;
-  }
-  resource::StandardLinkImpl* get_downlink_to(unsigned long position) const
-  {
-    return private_links_.at(position).second;
-  }
+  unsigned long get_num_links_per_node() const { return num_links_per_node_; }
+  resource::StandardLinkImpl* get_uplink_from(unsigned long position) { return get_private_link_at(position).first; }
+  resource::StandardLinkImpl* get_downlink_to(unsigned long position) { return get_private_link_at(position).second; }
+  const std::pair<resource::StandardLinkImpl*, resource::StandardLinkImpl*>&
+  get_private_link_at(unsigned long position);
+
+  /** @brief Whether the user asked for lazy links (see the routing/lazy-cluster-links configuration flag) */
+  static bool lazy_links_requested();
+  /** @brief In lazy mode, the loopback, limiter and private links are only created when a route first uses them */
+  void set_lazy_links(bool lazy) { lazy_links_ = lazy; }
+  bool has_lazy_links() const { return lazy_links_; }
+  /** @brief Gets the position of the leaf that was given that netpoint id by fill_leaf_from_cb() (lazy mode only) */
+  unsigned long get_leaf_position(unsigned long id) const { return leaf_positions_.at(id); }
+  /** @brief Creates the links that should be stored at that position of private_links_, in lazy mode.
+   *
+   * The default implementation handles the loopback and limiter links of the leaves. The zones with lazy links must
+   * override it to create their own links, and call this one for the other positions. */
+  virtual void create_lazy_links_at(unsigned long position);
+  bool has_reentrant_routing() const override { return not lazy_links_; }
 
   double get_link_latency() const { return link_lat_; }
   double get_link_bandwidth() const { return link_bw_; }
@@ -8,6 +8,9 @@
 
 #include <simgrid/kernel/routing/RoutedZone.hpp>
 
+#include <cstdint>
+#include <unordered_set>
+
 namespace simgrid::kernel::routing {
 
 /** @ingroup ROUTING_API
@@ -18,20 +21,38 @@ namespace simgrid::kernel::routing {
  *
  *  This result in rather small platform file, very fast initialization, and very low memory requirements, but somehow
  * long path resolution times.
+ *
+ *  The one-hop routes are compiled into a compressed (CSR) adjacency when the zone gets sealed, and the shortest paths
+ *  are computed with an indexed binary heap. When the routing/dijkstra-precompute option is set, cached zones compute
+ *  the routes from every source in parallel at seal time.
  */
 class XBT_PRIVATE DijkstraZone : public RoutedZone {
-  static void route_graph_delete(xbt_graph_t);
+  friend PlatformSnapshot;
+  /* One-hop routes, in declaration order, and their extremities (as NetPoint ids) */
+  std::vector<std::unique_ptr<Route>> edge_routes_;
+  std::vector<std::pair<unsigned long, unsigned long>> edge_ends_;
+  std::unordered_set<uint64_t> declared_edges_;
+
+  /* Graph vertices, numbered in order of appearance in the routes */
+  std::vector<unsigned long> graph_nodes_; // graph index -> NetPoint id
+  std::vector<long> graph_index_;          // NetPoint id -> graph index (-1 if the NetPoint has no route)
+
+  /* CSR adjacency built at seal time: the out-edges of node i are in [adj_offsets_[i], adj_offsets_[i+1]) */
+  std::vector<uint32_t> adj_offsets_;
+  std::vector<uint32_t> adj_targets_;
+  std::vector<uint32_t> adj_costs_;
+  std::vector<const Route*> adj_routes_;
 
-  std::unique_ptr<s_xbt_graph_t, decltype(&DijkstraZone::route_graph_delete)> route_graph_{
-      xbt_graph_new_graph(1, nullptr), &DijkstraZone::route_graph_delete};
-  std::map<unsigned long, xbt_node_t> graph_node_map_;
   bool cached_;
-  std::map<unsigned long, std::vector<unsigned long>> route_cache_;
+  std::vector<std::vector<uint32_t>> route_cache_; // graph index of the source -> predecessors in the paths
 
-  xbt_node_t route_graph_new_node(unsigned long id);
-  xbt_node_t node_map_search(unsigned long id);
   void new_edge(unsigned long src_id, unsigned long dst_id, Route* e_route);
+  long get_graph_index(unsigned long id) const;
+  const Route* get_edge_route(uint32_t src, uint32_t dst) const;
+  void compute_predecessors(uint32_t src, std::vector<uint32_t>& pred_arr) const;
   void do_seal() override;
+  bool has_local_seal() const override { return true; }
+  bool has_reentrant_routing() const override;
 
 public:
   DijkstraZone(const std::string& name, bool cached) : RoutedZone(name), cached_(cached) {}
@@ -61,6 +61,8 @@ public:
  *    Aries can handle, thus it should use several routers.
  */
 class XBT_PUBLIC DragonflyZone : public ClusterBase {
+  friend PlatformSnapshot;
+
 public:
   struct Coords {
     unsigned long group;
@@ -101,6 +103,7 @@ private:
   unsigned int num_links_blue_         = 0;
   unsigned int num_links_per_link_     = 1; // splitduplex -> 2, only for local link
   std::vector<DragonflyRouter> routers_;
+  std::vector<Coords> node_coords_; // coordinates of each node id, precomputed at seal time
 };
 } // namespace simgrid::kernel::routing
 #endif
@@ -103,6 +103,7 @@ public:
  * Routing is made using a destination-mod-k scheme.
  */
 class XBT_PRIVATE FatTreeZone : public ClusterBase {
+  friend PlatformSnapshot;
   /** @brief Generate the fat tree
    *
    * Once all processing nodes have been added, this will make sure the fat
@@ -116,6 +117,8 @@ class XBT_PRIVATE FatTreeZone : public ClusterBase {
   std::vector<unsigned int> num_port_lower_level_;  // ports between each level l and l-1
 
   std::map<unsigned long, std::shared_ptr<FatTreeNode>> compute_nodes_;
+  std::vector<const FatTreeNode*> compute_nodes_by_id_; // same content as compute_nodes_, for faster lookups
+  std::vector<unsigned int> parent_strides_;             // product of num_parents_per_node_ on the lower levels
   std::vector<std::shared_ptr<FatTreeNode>> nodes_;
   std::vector<std::shared_ptr<FatTreeLink>> links_;
   std::vector<unsigned int> nodes_by_level_;
@@ -8,6 +8,9 @@
 
 #include <simgrid/kernel/routing/RoutedZone.hpp>
 
+#include <cstdint>
+#include <unordered_map>
+
 namespace simgrid::kernel::routing {
 
 /** @ingroup ROUTING_API
@@ -18,15 +21,22 @@ namespace simgrid::kernel::routing {
  *
  *  This result in rather small platform file, slow initialization time,  and intermediate memory requirements
  *  (somewhere between the one of @{DijkstraZone} and the one of @{FullZone}).
+ *
+ *  The relaxation is split over several threads (see routing/nthreads) for large zones. Only the predecessor table
+ *  (32 bits per pair of vertices) is kept once the zone is sealed.
  */
 class XBT_PRIVATE FloydZone : public RoutedZone {
-  /* vars to compute the Floyd algorithm. */
-  std::vector<std::vector<long>> predecessor_table_;
-  std::vector<std::vector<unsigned long>> cost_table_;
-  std::vector<std::vector<std::unique_ptr<Route>>> link_table_;
-
-  void init_tables(unsigned int table_size);
+  friend PlatformSnapshot;
+  /* flat table_size x table_size matrix: predecessor_table_[src * table_size + dst] (-1 if there is no route) */
+  std::vector<int32_t> predecessor_table_;
+  bool restored_predecessors_ = false; // the predecessors come from a platform snapshot, no need to compute them
+  /* one-hop routes only, indexed by route_key(src, dst) */
+  std::unordered_map<uint64_t, std::unique_ptr<Route>> link_table_;
+
+  static uint64_t route_key(unsigned long src, unsigned long dst) { return (uint64_t{src} << 32) | dst; }
+  void relax_rows(std::vector<uint32_t>& cost_table, unsigned long pivot, unsigned long first, unsigned long last);
   void do_seal() override;
+  bool has_local_seal() const override { return true; }
 
 public:
   using RoutedZone::RoutedZone;
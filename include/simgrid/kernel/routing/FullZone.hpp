@@ -8,6 +8,9 @@
 
 #include <simgrid/kernel/routing/RoutedZone.hpp>
 
+#include <cstdint>
+#include <unordered_map>
+
 namespace simgrid::kernel::routing {
 
 /** @ingroup ROUTING_API
@@ -15,12 +18,32 @@ namespace simgrid::kernel::routing {
  *
  *  The full communication matrix is provided at creation, so this model has the highest expressive power and the lowest
  *  computational requirements, but also the highest memory requirements (both in platform file and in memory).
+ *
+ *  Identical routes (same gateways and same link sequence) are only stored once, so the memory used by the routes is
+ *  proportional to the number of distinct paths. The matrix itself only holds 32-bit indexes.
  */
 class XBT_PRIVATE FullZone : public RoutedZone {
-  std::vector<std::vector<std::unique_ptr<Route>>> routing_table_;
+  friend PlatformSnapshot;
+  struct RouteHash {
+    size_t operator()(const Route* route) const;
+  };
+  struct RouteEqual {
+    bool operator()(const Route* a, const Route* b) const;
+  };
+
+  /* flat matrix: routing_table_[src * table_stride_ + dst] is 0 if there is no route, or 1 + the route index */
+  std::vector<uint32_t> routing_table_;
+  unsigned long table_stride_ = 0;
+  std::vector<std::unique_ptr<Route>> distinct_routes_;
+  std::unordered_map<const Route*, uint32_t, RouteHash, RouteEqual> route_index_;
+
   void do_seal() override;
+  bool has_local_seal() const override { return true; }
   /** @brief Check and resize (if necessary) the routing table */
   void check_routing_table();
+  uint32_t& table_entry(unsigned long src, unsigned long dst) { return routing_table_[src * table_stride_ + dst]; }
+  /** @brief Get the table entry of a route identical to the given one, storing it if there is no such route yet */
+  uint32_t intern_route(Route* route);
 
 public:
   using RoutedZone::RoutedZone;
@@ -30,6 +53,8 @@ public:
   void get_local_route(const NetPoint* src, const NetPoint* dst, Route* into, double* latency) override;
   void add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoint* gw_dst,
                  const std::vector<s4u::LinkInRoute>& link_list, bool symmetrical) override;
+  /** @brief Amount of routes actually stored, the identical ones being shared by several pairs of elements */
+  size_t get_distinct_route_count() const { return distinct_routes_.size(); }
 };
 } // namespace simgrid::kernel::routing
 
@@ -8,6 +8,7 @@
 
 #include <xbt/Extendable.hpp>
 #include <xbt/base.h>
+#include <xbt/intern.hpp>
 #include <xbt/signal.hpp>
 
 #include <simgrid/kernel/routing/NetZoneImpl.hpp>
@@ -31,12 +32,14 @@ public:
 
   // Our rank in the vertices_ array of the netzone that contains us.
   unsigned long id() const { return id_; }
-  const std::string& get_name() const { return name_; }
+  const std::string& get_name() const { return name_.str(); }
   const char* get_cname() const { return name_.c_str(); }
+  /** @brief The interned name, that is cheaper to hash and compare than a std::string */
+  xbt::InternedString get_interned_name() const { return name_; }
   /** @brief the NetZone in which this NetPoint is included */
   NetZoneImpl* get_englobing_zone() const { return englobing_zone_; }
   /** @brief Returns the NetZones that contain the NetPoint, from root to leaf */
-  std::vector<NetZoneImpl*> get_all_englobing_zones() const;
+  const std::vector<NetZoneImpl*>& get_all_englobing_zones() const { return englobing_zones_; }
   /** @brief Set the NetZone in which this NetPoint is included */
   NetPoint* set_englobing_zone(NetZoneImpl* netzone_p);
   NetPoint* set_coordinates(const std::string& coords);
@@ -51,9 +54,13 @@ public:
 
 private:
   unsigned long id_ = -1;
-  std::string name_;
+  xbt::InternedString name_;
   NetPoint::Type component_type_;
   NetZoneImpl* englobing_zone_ = nullptr;
+  std::vector<NetZoneImpl*> englobing_zones_; // Cached, as every route lookup needs it
+
+  friend NetZoneImpl; // Refreshes englobing_zones_ when a netzone gets a new parent
+  void update_englobing_zones();
 };
 } // namespace kernel::routing
 } // namespace simgrid
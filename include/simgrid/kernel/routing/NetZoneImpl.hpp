@@ -13,7 +13,9 @@
 #include <xbt/PropertyHolder.hpp>
 #include <xbt/graph.h>
 
+#include <functional>
 #include <map>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -75,25 +77,34 @@ public:
  */
 class XBT_PUBLIC NetZoneImpl : public xbt::PropertyHolder, public xbt::Extendable<NetZoneImpl> {
   friend EngineImpl; // it destroys netRoot_
+  friend PlatformSnapshot;
   s4u::NetZone piface_;
 
   // our content, as known to our graph routing algorithm (maps vertex_id -> vertex)
   std::vector<NetPoint*> vertices_;
-  std::map<std::string, resource::StandardLinkImpl*, std::less<>> links_;
+  /* The keys of the following maps are views on the (interned) names of the resources, that live until the end */
+  std::map<std::string_view, resource::StandardLinkImpl*, std::less<>> links_;
   /* save split-duplex links separately, keep links_ with only LinkImpl* seen by the user
    * members of a split-duplex are saved in the links_ */
-  std::map<std::string, std::unique_ptr<resource::SplitDuplexLinkImpl>, std::less<>> split_duplex_links_;
-  std::map<std::string, resource::HostImpl*, std::less<>> hosts_;
+  std::map<std::string_view, std::unique_ptr<resource::SplitDuplexLinkImpl>, std::less<>> split_duplex_links_;
+  std::map<std::string_view, resource::HostImpl*, std::less<>> hosts_;
   std::map<std::string, NetPoint*, std::less<>> gateways_;
 
   NetZoneImpl* parent_ = nullptr;
   std::vector<NetZoneImpl*> children_; // sub-netzones
   std::string name_;
-  bool sealed_ = false; // We cannot add more content when sealed
+  bool sealed_     = false; // We cannot add more content when sealed
+  bool pre_sealed_ = false; // do_seal() was already run concurrently with the other zones (see seal_local_zones())
 
   std::map<std::pair<const NetPoint*, const NetPoint*>, BypassRoute*> bypass_routes_; // src x dst -> route
   NetPoint* netpoint_ = nullptr; // Our representative in the parent NetZone
 
+  void update_englobing_zones(); // Refresh the chain of netzones cached by the netpoints below us
+  /* Common part of get_global_route() and get_global_route_with_netzones(), that do not fill netzones when nullptr */
+  static void find_global_route(const NetPoint* src, const NetPoint* dst,
+                                /* OUT */ std::vector<resource::StandardLinkImpl*>& links, double* latency,
+                                std::unordered_set<NetZoneImpl*>* netzones);
+
 protected:
   explicit NetZoneImpl(const std::string& name);
   NetZoneImpl(const NetZoneImpl&)            = delete;
@@ -113,7 +124,7 @@ protected:
   /* returns whether we found a bypass path */
   bool get_bypass_route(const routing::NetPoint* src, const routing::NetPoint* dst,
                         /* OUT */ std::vector<resource::StandardLinkImpl*>& links, double* latency,
-                        std::unordered_set<NetZoneImpl*>& netzones);
+                        std::unordered_set<NetZoneImpl*>* netzones);
 
   /** @brief Get the NetZone that is represented by the netpoint */
   const NetZoneImpl* get_netzone_recursive(const NetPoint* netpoint) const;
@@ -122,6 +133,11 @@ protected:
   std::vector<resource::StandardLinkImpl*> get_link_list_impl(const std::vector<s4u::LinkInRoute>& link_list,
                                                               bool backroute) const;
 
+  /** @brief Runs @c create as if this netzone was not sealed yet, without firing the seal/unseal signals.
+   *
+   * This is meant for the zones that instantiate some of their resources on need, after the sealing. */
+  void create_lazily(const std::function<void()>& create);
+
   static xbt_node_t new_xbt_graph_node(const s_xbt_graph_t* graph, const char* name,
                                        std::map<std::string, xbt_node_t, std::less<>>* nodes);
   static xbt_edge_t new_xbt_graph_edge(const s_xbt_graph_t* graph, xbt_node_t src, xbt_node_t dst,
@@ -241,7 +257,15 @@ public:
   virtual void add_bypass_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoint* gw_dst,
                                 const std::vector<s4u::LinkInRoute>& link_list);
 
-  /** @brief Seal your netzone once you're done adding content, and before routing stuff through it */
+  /** @brief Number of threads used to precompute the routing tables and to batch route queries (see routing/nthreads) */
+  static unsigned get_nthreads();
+
+  /** @brief Seal your netzone once you're done adding content, and before routing stuff through it
+   *
+   * The zones of that subtree whose sealing only computes their own routing tables (see has_local_seal()) run their
+   * do_seal() concurrently on get_nthreads() threads first. Everything else (such as the resources created by the
+   * clusters, and the signals) is then done sequentially, in the same order as if the zones were sealed one by one.
+   */
   void seal();
   /** @brief Unseal your netzone if you want to add more stuff, and do not forget to re-seal once you're done */
   void unseal();
@@ -271,7 +295,24 @@ public:
 
   static void get_interzone_route(const NetPoint* netpoint, NetPoint* gw, const bool gateway_to_netpoint,
                                   std::vector<kernel::resource::StandardLinkImpl*>& links, double* latency,
-                                  std::vector<NetZoneImpl*>* zones_path);
+                                  std::vector<NetZoneImpl*>::const_iterator zones_begin,
+                                  std::vector<NetZoneImpl*>::const_iterator zones_end);
+
+  /** @brief Computes the global routes between many pairs of netpoints at once
+   *
+   * The routes are computed on get_nthreads() threads when every netzone of the platform allows concurrent route
+   * lookups (see has_reentrant_routing()), and sequentially otherwise.
+   *
+   * @param pairs the {src, dst} netpoints of each route
+   * @param links if not nullptr, receives the links of each route (in the order of @c pairs)
+   * @param latencies if not nullptr, receives the latency of each route (in the order of @c pairs)
+   */
+  static void get_global_routes(const std::vector<std::pair<const NetPoint*, const NetPoint*>>& pairs,
+                                /* OUT */ std::vector<std::vector<resource::StandardLinkImpl*>>* links,
+                                /* OUT */ std::vector<double>* latencies);
+
+  /** @brief Check whether get_local_route() can be called concurrently on that netzone and all its children */
+  bool can_route_concurrently() const;
 
   /** @brief Similar to get_global_route but get the NetZones traversed by route */
   static void get_global_route_with_netzones(const NetPoint* src, const NetPoint* dst,
@@ -296,6 +337,12 @@ private:
   std::shared_ptr<resource::HostModel> host_model_;
   /** @brief Perform sealing procedure for derived classes, if necessary */
   virtual void do_seal() { /* obviously nothing to do by default */ }
+  /** @brief Whether get_local_route() can run concurrently, i.e. does not fill any cache or create any resource */
+  virtual bool has_reentrant_routing() const { return true; }
+  /** @brief Whether do_seal() only modifies this zone, so that it can run concurrently with the one of other zones */
+  virtual bool has_local_seal() const { return false; }
+  void seal_local_zones();
+  void seal_recursively();
   /** @brief Allows subclasses (wi-fi) to have their own create link method, but keep links_ updated */
   virtual resource::StandardLinkImpl* do_create_link(const std::string& name, const std::vector<double>& bandwidths);
   void add_child(NetZoneImpl* new_zone);
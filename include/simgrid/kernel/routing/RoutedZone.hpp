@@ -31,7 +31,7 @@ namespace simgrid::kernel::routing {
  * <tr><td><b>Memory usage</b></td>
  * <td>1-hop routes (+ cache of routes)</td>
  * <td>O(n^2) data (intermediate)</td>
- * <td>O(n^2) + sum of path lengths (very large)</td>
+ * <td>O(n^2) + sum of distinct path lengths (large)</td>
  * </tr>
  * <tr><td><b>Lookup time</b></td>
  * <td>Dijkstra Algo: O(n^3)</td>
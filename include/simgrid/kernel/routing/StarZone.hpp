@@ -59,6 +59,8 @@ namespace simgrid::kernel::routing {
  *  Note that the backbone only appears once in the link list.
  */
 class StarZone : public ClusterZone { // implements the old ClusterZone
+  friend PlatformSnapshot;
+
 public:
   explicit StarZone(const std::string& name);
 
@@ -69,6 +71,7 @@ public:
   void add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoint* gw_dst,
                  const std::vector<s4u::LinkInRoute>& link_list, bool symmetrical) override;
   void do_seal() override;
+  bool has_local_seal() const override { return true; }
 
 private:
   class StarRoute {
@@ -83,9 +86,9 @@ private:
     bool has_links_up() const { return links_up_set; }
     bool has_links_down() const { return links_down_set; }
   };
-  /** @brief Auxiliary method to add links to a route */
+  /** @brief Auxiliary method to add links to a route, skipping the ones already added since position @c first */
   void add_links_to_route(const std::vector<resource::StandardLinkImpl*>& links, Route* route, double* latency,
-                          std::unordered_set<resource::StandardLinkImpl*>& added_links) const;
+                          size_t first) const;
   /** @brief Auxiliary methods to check params received in add_route method */
   void check_add_route_param(const NetPoint* src, const NetPoint* dst, const NetPoint* gw_src, const NetPoint* gw_dst,
                              bool symmetrical) const;
@@ -18,7 +18,15 @@ namespace simgrid::kernel::routing {
  */
 
 class XBT_PRIVATE TorusZone : public ClusterBase {
+  friend PlatformSnapshot;
   std::vector<unsigned long> dimensions_;
+  std::vector<unsigned long> dim_products_; // product of the previous dimensions, i.e. the id stride of each dimension
+  std::vector<unsigned long> coords_;       // coordinates of each node, dimensions_.size() values per node id
+
+  void create_torus_link(unsigned long id, unsigned long rank, unsigned long position, unsigned long j);
+
+protected:
+  void create_lazy_links_at(unsigned long position) override;
 
 public:
   explicit TorusZone(const std::string& name) : ClusterBase(name){};
@@ -87,6 +87,17 @@ public:
    * specialized zones (such as clusters) are more efficient than the one with fully explicit routing used here.
    */
   std::string flatify_platform() const;
+  /** @brief Save the platform into a binary snapshot, that load_platform() accepts and loads much faster.
+   *
+   * The platform is sealed first. The snapshot contains the netzones, hosts, disks, links, routers, routes and
+   * gateways, along with the routing tables that are long to compute. It is only meant to be loaded by the same version
+   * of SimGrid on the same kind of machine. The resources must not have any profile, as they cannot be saved.
+   *
+   * @beginrst
+   * See also: :ref:`platform_snapshots`.
+   * @endrst
+   */
+  void save_platform_snapshot(const std::string& path) const;
 
   /** @verbatim embed:rst:inline Bind an actor name that could be found in :ref:`pf_tag_actor` tag to a function taking classical argc/argv parameters. See the :ref:`example <s4u_ex_actors_create>`. @endverbatim */
   void register_function(const std::string& name, const std::function<void(int, char**)>& code);
@@ -121,8 +132,9 @@ public:
   /** If non-null, the provided set will be filled with all activities that fail to start because of a veto */
   void track_vetoed_activities(std::set<Activity*>* vetoed_activities) const;
 
-  /** Load a deployment file, launching the actors that it contains.
-   *  @verbatim embed:rst:inline See:ref:`deploy` and the :ref:`example <s4u_ex_actors_create>`. @endverbatim */
+  /** Load a deployment file, launching the actors that it contains. Files ending with ".csv" use the compact format of
+   *  large deployments.
+   *  @verbatim embed:rst:inline See:ref:`deploy`, :ref:`deploy_csv` and the :ref:`example <s4u_ex_actors_create>`. @endverbatim */
   void load_deployment(const std::string& deploy) const;
 
 protected:
@@ -174,6 +186,21 @@ public:
   /** Find a link from its name, or @c nullptr if it does not exist. */
   s4u::Link* link_by_name_or_null(const std::string& name) const;
 
+  /**
+   * @brief Computes the routes between many pairs of hosts at once, as Host::route_to() would.
+   *
+   * The routes are computed in parallel (see the routing/nthreads configuration flag) when all the netzones of the
+   * platform allow it. The results are given in the order of @a pairs, as {links, latency}.
+   */
+  std::vector<std::pair<std::vector<Link*>, double>>
+  get_routes(const std::vector<std::pair<const Host*, const Host*>>& pairs) const;
+  /**
+   * @brief Computes the latency of the route between every pair of the given hosts, in parallel when possible.
+   *
+   * The result is a row-major matrix: the latency from hosts[i] to hosts[j] is at position i * hosts.size() + j.
+   */
+  std::vector<double> get_latency_matrix(const std::vector<Host*>& hosts) const;
+
   /** Find a mailbox from its name, creating it if it does not exist yet. */
   s4u::Mailbox* mailbox_by_name_or_create(const std::string& name) const;
   /** Find a message queue from its name, creating it if it does not exist yet. */
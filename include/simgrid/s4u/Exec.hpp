@@ -47,6 +47,14 @@ public:
   Exec(Exec const&) = delete;
   Exec& operator=(Exec const&) = delete;
 #endif
+  /** @brief One communication of a parallel execution: @c bytes sent from the host at index @c src in the host list
+   *  of the execution to the host at index @c dst. See set_transfers(). */
+  struct Transfer {
+    size_t src;
+    size_t dst;
+    double bytes;
+  };
+
   /*! \static Initiate the creation of an Exec. Setters have to be called afterwards */
   static ExecPtr init();
 
@@ -87,6 +95,12 @@ public:
    * specifies the amount of bytes to send from host i to host j. See also set_flops_amounts() to specify the
    * computations happening on each host. */
   ExecPtr set_bytes_amounts(const std::vector<double>& bytes_amounts);
+  /** @brief Set the communications between the hosts of a parallel execution, as a sparse list.
+   *
+   * This is equivalent to set_bytes_amounts(), but only the pairs of hosts that actually exchange data are given. It
+   * is the way to go on large parallel executions where each host only talks to a few others, as the host_count-square
+   * matrix never gets built. Replaces the matrix given to set_bytes_amounts(), if any. */
+  ExecPtr set_transfers(const std::vector<Transfer>& transfers);
 
   /** @brief Change the amount of threads that this execution uses on its host.
    *
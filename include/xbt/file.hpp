@@ -16,6 +16,8 @@ void path_push(std::string const& str);
 void path_pop();
 FILE* path_fopen(const std::string& name, const char* mode);
 std::ifstream* path_ifsopen(const std::string& name);
+/** Returns the name of the file that path_fopen() would open, or an empty string if it cannot be found */
+std::string path_find(const std::string& name);
 std::string path_to_string();
 
 class Path {
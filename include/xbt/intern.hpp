@@ -0,0 +1,75 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_INTERN_HPP
+#define SIMGRID_XBT_INTERN_HPP
+
+#include "xbt/base.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace simgrid::xbt {
+
+/** @brief A name stored once in a process-wide pool
+ *
+ * Interning the same characters twice gives the same entry, so copying and comparing interned strings boils down to
+ * copying and comparing pointers, and hashing them to reading their identifier. The entries are never freed, so the
+ * string and the string_view returned by an InternedString remain valid until the end of the process.
+ *
+ * Use it for the names of the many simulated entities (hosts, links, netpoints, mailboxes), that are stored as keys of
+ * the lookup tables and that are read much more often than they are created. The pool is protected by a lock, so that
+ * names can be interned from several threads at once.
+ *
+ * @ingroup XBT_str
+ */
+class XBT_PUBLIC InternedString {
+  struct Entry {
+    std::string str;
+    uint32_t id;
+  };
+  class Pool;
+  const Entry* entry_;
+
+  explicit InternedString(const Entry* entry) : entry_(entry) {}
+  static Pool& get_pool();
+
+public:
+  /** The empty string */
+  InternedString();
+  /** Interns these characters (or retrieves their existing entry) */
+  explicit InternedString(std::string_view str);
+
+  /** Retrieves the entry of a string that was already interned, without interning it */
+  static std::optional<InternedString> find(std::string_view str);
+  /** Interns @c prefix+number+suffix (as in "node-42.cluster") without building any temporary std::string */
+  static InternedString from_pattern(std::string_view prefix, long number, std::string_view suffix);
+  /** Amount of distinct strings that were interned so far */
+  static size_t get_pool_size();
+
+  const std::string& str() const { return entry_->str; }
+  std::string_view view() const { return entry_->str; }
+  const char* c_str() const { return entry_->str.c_str(); }
+  bool empty() const { return entry_->str.empty(); }
+  /** Identifier of that string, which is dense and stable for the whole process */
+  uint32_t id() const { return entry_->id; }
+
+  operator const std::string&() const { return entry_->str; }
+
+  bool operator==(const InternedString& rhs) const { return entry_ == rhs.entry_; }
+  /** Lexicographic order, not the order of the identifiers */
+  bool operator<(const InternedString& rhs) const { return entry_ != rhs.entry_ && entry_->str < rhs.entry_->str; }
+};
+
+} // namespace simgrid::xbt
+
+template <> struct std::hash<simgrid::xbt::InternedString> {
+  size_t operator()(const simgrid::xbt::InternedString& str) const noexcept { return str.id(); }
+};
+
+#endif
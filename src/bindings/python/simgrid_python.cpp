@@ -318,6 +318,21 @@ PYBIND11_MODULE(simgrid, m)
                              "Returns the list of all actors found in the platform")
       .def_property_readonly("netzone_root", &Engine::get_netzone_root,
                              "Retrieve the root netzone, containing all others.")
+      .def("get_routes", &Engine::get_routes, py::arg("pairs"),
+           "Computes the routes between many (src, dst) pairs of hosts at once, in parallel when possible. Returns a "
+           "list of (links, latency) tuples, in the order of the pairs.")
+      .def(
+          "get_latency_matrix",
+          [](const Engine& e, const std::vector<Host*>& hosts) {
+            std::vector<double> latencies = e.get_latency_matrix(hosts);
+            auto n                        = static_cast<py::ssize_t>(hosts.size());
+            py::array_t<double> res({n, n});
+            std::copy(latencies.begin(), latencies.end(), res.mutable_data());
+            return res;
+          },
+          py::arg("hosts"),
+          "Computes the latency of the route between every pair of the given hosts, in parallel when possible. "
+          "Returns a NumPy matrix in which ``m[i][j]`` is the latency from ``hosts[i]`` to ``hosts[j]``.")
       .def("netpoint_by_name", &Engine::netpoint_by_name_or_null,
            "Retrieve a netpoint by its name, or None if it does not exist in the platform.")
       .def("netzone_by_name", &Engine::netzone_by_name_or_null,
@@ -328,6 +343,8 @@ PYBIND11_MODULE(simgrid, m)
       .def("load_platform", &Engine::load_platform,
            "Creates a new platform, including hosts, links, and the routing table (see also: the documentation on "
            "platform files).")
+      .def("save_platform_snapshot", &Engine::save_platform_snapshot, py::arg("path"),
+           "Save the sealed platform into a binary snapshot, that load_platform() loads much faster")
       .def("load_deployment", &Engine::load_deployment, "Load a deployment file and launch the actors that it contains")
       .def("mailbox_by_name_or_create", &Engine::mailbox_by_name_or_create, py::arg("name"),
            "Find a mailbox from its name or create one if it does not exist")
@@ -366,6 +366,8 @@ static void on_host_creation(s4u::Host const& host)
 static void on_action_state_change(kernel::resource::Action const& action,
                                    kernel::resource::Action::State /* previous */)
 {
+  if (action.get_variable() == nullptr) // Not shared by the LMM (e.g. with the Multicore CPU model): nothing to trace
+    return;
   auto n = static_cast<unsigned>(action.get_variable()->get_number_of_constraint());
 
   for (unsigned i = 0; i < n; i++) {
@@ -18,6 +18,7 @@
 #include "src/kernel/activity/SemaphoreImpl.hpp"
 #include "src/kernel/resource/StandardLinkImpl.hpp"
 #include "src/kernel/resource/profile/Profile.hpp"
+#include "src/kernel/routing/PlatformSnapshot.hpp"
 #include "src/kernel/xml/platf.hpp"
 #include "src/mc/mc.h"
 #include "src/mc/mc_config.hpp"
@@ -332,6 +333,8 @@ void EngineImpl::load_platform(const std::string& platf)
     const char* dlsym_error = dlerror();
     xbt_assert(not dlsym_error, "Error: %s", dlsym_error);
     callable(*simgrid::s4u::Engine::get_instance());
+  } else if (routing::PlatformSnapshot::is_snapshot(platf)) {
+    routing::PlatformSnapshot::load(platf);
   } else {
     parse_platform_file(platf);
   }
@@ -344,6 +347,11 @@ void EngineImpl::load_deployment(const std::string& file) const
 {
   sg_platf_parser_finalize();
 
+  if (boost::algorithm::ends_with(file, ".csv")) {
+    parse_csv_deployment(file);
+    return;
+  }
+
   simgrid_parse_open(file);
   simgrid_parse(false);
   simgrid_parse_close();
@@ -12,6 +12,7 @@
 #include <simgrid/simcall.hpp>
 #include <xbt/dynar.h>
 #include <xbt/functional.hpp>
+#include <xbt/intern.hpp>
 
 #include "src/kernel/activity/ExecImpl.hpp"
 #include "src/kernel/activity/IoImpl.hpp"
@@ -31,9 +32,10 @@
 namespace simgrid::kernel {
 
 class EngineImpl {
-  std::unordered_map<std::string, routing::NetPoint*> netpoints_;
-  std::unordered_map<std::string, activity::MailboxImpl*> mailboxes_;
-  std::unordered_map<std::string, activity::MessageQueueImpl*> mqueues_;
+  // Keyed by the interned names of the entities, so that the keys are not copies of the names and hash for free
+  std::unordered_map<xbt::InternedString, routing::NetPoint*> netpoints_;
+  std::unordered_map<xbt::InternedString, activity::MailboxImpl*> mailboxes_;
+  std::unordered_map<xbt::InternedString, activity::MessageQueueImpl*> mqueues_;
 
   std::unordered_map<std::string, actor::ActorCodeFactory> registered_functions; // Maps function names to actor code
   actor::ActorCodeFactory default_function; // Function to use as a fallback when the provided name matches nothing
@@ -59,6 +61,8 @@ class EngineImpl {
 
   std::vector<std::string> cmdline_; // Copy of the argv we got (including argv[0])
 
+  unsigned long platform_version_ = 0; // Changes whenever the routes between the hosts may have changed
+
 public:
   EngineImpl() = default;
 
@@ -122,6 +126,9 @@ public:
   }
 
   routing::NetZoneImpl* get_netzone_root() const { return netzone_root_; }
+  /** @brief Invalidates what the models memoized about the routes (on seal, unseal and netpoint destruction) */
+  void on_platform_change() { platform_version_++; }
+  unsigned long get_platform_version() const { return platform_version_; }
 
   void add_daemon(actor::ActorImpl* d) { daemons_.insert(d); }
   void remove_daemon(actor::ActorImpl* d);
@@ -56,6 +56,15 @@ ExecImpl& ExecImpl::set_flops_amounts(const std::vector<double>& flops_amounts)
 ExecImpl& ExecImpl::set_bytes_amounts(const std::vector<double>& bytes_amounts)
 {
   bytes_amounts_ = bytes_amounts;
+  transfers_.clear();
+
+  return *this;
+}
+
+ExecImpl& ExecImpl::set_transfers(const std::vector<s4u::Exec::Transfer>& transfers)
+{
+  transfers_ = transfers;
+  bytes_amounts_.clear();
 
   return *this;
 }
@@ -93,7 +102,10 @@ ExecImpl* ExecImpl::start()
     } else {
       // get the model from first host since we have only 1 by now
       auto host_model = get_host()->get_netpoint()->get_englobing_zone()->get_host_model();
-      model_action_   = host_model->execute_parallel(get_hosts(), flops_amounts_.data(), bytes_amounts_.data(), -1);
+      if (transfers_.empty())
+        model_action_ = host_model->execute_parallel(get_hosts(), flops_amounts_.data(), bytes_amounts_.data(), -1);
+      else
+        model_action_ = host_model->execute_parallel(get_hosts(), flops_amounts_.data(), transfers_, -1);
     }
     model_action_->set_activity(this);
     set_start_time(model_action_->get_start_time());
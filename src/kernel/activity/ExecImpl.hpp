@@ -19,6 +19,7 @@ class XBT_PUBLIC ExecImpl : public ActivityImpl_T<ExecImpl> {
   double bound_                       = 0.0;
   std::vector<double> flops_amounts_;
   std::vector<double> bytes_amounts_;
+  std::vector<s4u::Exec::Transfer> transfers_; // Sparse alternative to bytes_amounts_
   int thread_count_ = 1;
 
 public:
@@ -33,6 +34,7 @@ public:
 
   ExecImpl& set_flops_amounts(const std::vector<double>& flops_amounts);
   ExecImpl& set_bytes_amounts(const std::vector<double>& bytes_amounts);
+  ExecImpl& set_transfers(const std::vector<s4u::Exec::Transfer>& transfers);
   ExecImpl& set_thread_count(int thread_count);
   ExecImpl& set_hosts(const std::vector<s4u::Host*>& hosts);
 
@@ -11,6 +11,7 @@
 #include "simgrid/s4u/Mailbox.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 #include "src/kernel/actor/ActorImpl.hpp"
+#include "xbt/intern.hpp"
 
 namespace simgrid::kernel::activity {
 
@@ -18,7 +19,7 @@ namespace simgrid::kernel::activity {
 
 class MailboxImpl {
   s4u::Mailbox piface_;
-  std::string name_;
+  xbt::InternedString name_;
   actor::ActorImplPtr permanent_receiver_; // actor to which the mailbox is attached
 
   std::deque<CommImplPtr> comm_queue_;
@@ -32,7 +33,7 @@ class MailboxImpl {
 
   static unsigned next_id_; // Next ID to be given
   const unsigned id_ = next_id_++;
-  explicit MailboxImpl(const std::string& name) : piface_(this), name_(name) {}
+  explicit MailboxImpl(xbt::InternedString name) : piface_(this), name_(name) {}
   MailboxImpl(const MailboxImpl&) = delete;
   MailboxImpl& operator=(const MailboxImpl&) = delete;
 
@@ -45,7 +46,7 @@ public:
   const s4u::Mailbox* get_iface() const { return &piface_; }
   s4u::Mailbox* get_iface() { return &piface_; }
 
-  const std::string& get_name() const { return name_; }
+  const std::string& get_name() const { return name_.str(); }
   const char* get_cname() const { return name_.c_str(); }
   void set_receiver(s4u::ActorPtr actor);
   void push(const CommImplPtr& comm);
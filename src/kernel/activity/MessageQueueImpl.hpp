@@ -9,6 +9,7 @@
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/s4u/MessageQueue.hpp"
 #include "src/kernel/activity/MessImpl.hpp"
+#include "xbt/intern.hpp"
 
 namespace simgrid::kernel::activity {
 
@@ -16,7 +17,7 @@ namespace simgrid::kernel::activity {
 
 class MessageQueueImpl {
   s4u::MessageQueue piface_;
-  std::string name_;
+  xbt::InternedString name_;
   std::deque<MessImplPtr> queue_;
 
   friend s4u::Engine;
@@ -26,7 +27,7 @@ class MessageQueueImpl {
 
   static unsigned next_id_; // Next ID to be given
   const unsigned id_ = next_id_++;
-  explicit MessageQueueImpl(const std::string& name) : piface_(this), name_(name) {}
+  explicit MessageQueueImpl(xbt::InternedString name) : piface_(this), name_(name) {}
   MessageQueueImpl(const MailboxImpl&) = delete;
   MessageQueueImpl& operator=(const MailboxImpl&) = delete;
 
@@ -39,7 +40,7 @@ public:
   const s4u::MessageQueue* get_iface() const { return &piface_; }
   s4u::MessageQueue* get_iface() { return &piface_; }
 
-  const std::string& get_name() const { return name_; }
+  const std::string& get_name() const { return name_.str(); }
   const char* get_cname() const { return name_.c_str(); }
   void push(const MessImplPtr& mess);
   void remove(const MessImplPtr& mess);
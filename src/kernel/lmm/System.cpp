@@ -6,6 +6,7 @@
 #include "src/internal_config.h"
 #include "src/kernel/lmm/fair_bottleneck.hpp"
 #include "src/kernel/lmm/maxmin.hpp"
+#include "src/kernel/resource/Resource.hpp"
 #include "src/simgrid/math_utils.h"
 #include "xbt/backtrace.hpp"
 #include "xbt/config.hpp"
@@ -151,6 +152,26 @@ void System::var_free(Variable* var)
   XBT_IN("(sys=%p, var=%p)", this, var);
   modified_ = true;
 
+  remove_aggregation_candidate(var);
+  remove_elements(var);
+
+  if (var->backtrace_)
+    delete var->backtrace_;
+
+  check_concurrency();
+
+  xbt_mallocator_release(variable_mallocator_, var);
+  XBT_OUT();
+}
+
+void System::update_usage(const Constraint* cnst) const
+{
+  if (track_usage_ && cnst->get_id() != nullptr)
+    cnst->get_id()->update_usage(cnst);
+}
+
+void System::remove_elements(Variable* var)
+{
   // TODOLATER Can do better than that by leaving only the variable in only one enabled_element_set, call
   // update_modified_set, and then remove it..
   update_modified_cnst_set_from_variable(var);
@@ -164,21 +185,14 @@ void System::var_free(Variable* var)
       simgrid::xbt::intrusive_erase(elem.constraint->disabled_element_set_, elem);
     if (elem.active_element_set_hook.is_linked())
       simgrid::xbt::intrusive_erase(elem.constraint->active_element_set_, elem);
-    if (elem.constraint->enabled_element_set_.empty() && elem.constraint->disabled_element_set_.empty())
+    if (elem.constraint->enabled_element_set_.empty() && elem.constraint->disabled_element_set_.empty()) {
       make_constraint_inactive(elem.constraint);
-    else
+      update_usage(elem.constraint); // Not solved anymore, and unloaded
+    } else
       on_disabled_var(elem.constraint);
   }
 
-  if (var->backtrace_)
-    delete var->backtrace_;
-
   var->cnsts_.clear();
-
-  check_concurrency();
-
-  xbt_mallocator_release(variable_mallocator_, var);
-  XBT_OUT();
 }
 
 System::System(bool selective_update) : selective_update_active(selective_update)
@@ -191,6 +205,7 @@ System::System(bool selective_update) : selective_update_active(selective_update
 
 System::~System()
 {
+  track_usage_ = false;
   while (Variable* var = extract_variable()) {
     const char* name = var->id_ ? typeid(*var->id_).name() : "(unidentified)";
     boost::core::scoped_demangled_name demangled(name);
@@ -253,16 +268,206 @@ Variable* System::variable_new(resource::Action* id, double sharing_penalty, dou
   return var;
 }
 
+Variable* System::variable_new_aggregated(resource::Action* id, unsigned long key, double sharing_penalty, double bound)
+{
+  auto [begin, end] = aggregation_candidates_.equal_range(key);
+  auto candidate    = std::find_if(begin, end, [sharing_penalty, bound](const auto& elm) {
+    return elm.second->sharing_penalty_ == sharing_penalty && elm.second->bound_ == bound;
+  });
+  if (candidate == end)
+    return nullptr;
+
+  auto* var = static_cast<Variable*>(xbt_mallocator_get(variable_mallocator_));
+  var->initialize(id, sharing_penalty, bound, 0, visited_counter_ - 1);
+  var->aggregation_key_ = key;
+  aggregate_add(candidate->second, var);
+  XBT_DEBUG("Variable %d aggregated with %zu identical ones", var->rank_, var->aggregate_->members_.size() - 1);
+  return var;
+}
+
+void System::set_aggregation_key(Variable* var, unsigned long key)
+{
+  xbt_assert(key != 0 && var->aggregate_ == nullptr, "Invalid aggregation key");
+  if (std::any_of(var->cnsts_.begin(), var->cnsts_.end(), [](const Element& elem) {
+        return elem.constraint->get_concurrency_limit() >= 0 ||
+               (elem.constraint->get_sharing_policy() != Constraint::SharingPolicy::SHARED &&
+                elem.constraint->get_sharing_policy() != Constraint::SharingPolicy::FATPIPE);
+      }))
+    return;
+  var->aggregation_key_ = key;
+  aggregation_used_     = true;
+  add_aggregation_candidate(var);
+}
+
+void System::disable_aggregation(const Constraint* cnst)
+{
+  if (not aggregation_used_)
+    return;
+
+  std::vector<Variable*> aggregates;
+  auto collect = [&aggregates](const Element& elem) {
+    if (not elem.variable->members_.empty())
+      aggregates.push_back(elem.variable);
+  };
+  std::for_each(cnst->enabled_element_set_.begin(), cnst->enabled_element_set_.end(), collect);
+  std::for_each(cnst->disabled_element_set_.begin(), cnst->disabled_element_set_.end(), collect);
+
+  for (Variable* aggregate : aggregates) {
+    // The aggregate is freed when its last member leaves
+    for (size_t count = aggregate->members_.size(); count > 0; count--)
+      aggregate_split(aggregate->members_.back());
+  }
+
+  const Element* elem = nullptr;
+  while (Variable* var = cnst->get_variable(&elem)) {
+    remove_aggregation_candidate(var);
+    var->aggregation_key_ = 0;
+  }
+  check_concurrency();
+}
+
+void System::add_aggregation_candidate(Variable* var)
+{
+  if (not var->aggregation_candidate_) {
+    aggregation_candidates_.emplace(var->aggregation_key_, var);
+    var->aggregation_candidate_ = true;
+  }
+}
+
+void System::remove_aggregation_candidate(Variable* var)
+{
+  if (var->aggregation_candidate_) {
+    auto [begin, end] = aggregation_candidates_.equal_range(var->aggregation_key_);
+    aggregation_candidates_.erase(std::find_if(begin, end, [var](const auto& elm) { return elm.second == var; }));
+    var->aggregation_candidate_ = false;
+  }
+}
+
+void System::aggregate_add(Variable* target, Variable* var)
+{
+  if (target->members_.empty()) {
+    // First aggregation with that variable: its elements now belong to a new aggregate, of which it is a member
+    auto* aggregate = static_cast<Variable*>(xbt_mallocator_get(variable_mallocator_));
+    aggregate->initialize(nullptr, target->sharing_penalty_, target->bound_, 0, visited_counter_ - 1);
+    aggregate->value_           = target->value_;
+    aggregate->aggregation_key_ = target->aggregation_key_;
+    aggregate->cnsts_           = std::move(target->cnsts_); // Moving the vector does not move the elements
+    target->cnsts_.clear();
+    for (Element& elem : aggregate->cnsts_) {
+      elem.variable = aggregate;
+      aggregate->member_weights_.push_back(elem.consumption_weight);
+    }
+    variable_set.insert(variable_set.iterator_to(*target), *aggregate);
+    remove_variable(target);
+    remove_aggregation_candidate(target);
+    add_aggregation_candidate(aggregate);
+
+    target->aggregate_       = aggregate;
+    target->aggregate_index_ = 0;
+    aggregate->members_.push_back(target);
+    target = aggregate;
+  }
+
+  var->aggregate_              = target;
+  var->aggregate_index_        = target->members_.size();
+  var->sharing_penalty_        = target->sharing_penalty_;
+  var->staged_sharing_penalty_ = 0.0;
+  var->bound_                  = target->bound_;
+  var->aggregation_key_        = target->aggregation_key_;
+  target->members_.push_back(var);
+  aggregate_rescale(target);
+}
+
+void System::aggregate_remove(Variable* var)
+{
+  Variable* aggregate = var->aggregate_;
+  Variable* last      = aggregate->members_.back();
+  aggregate->members_[var->aggregate_index_] = last;
+  last->aggregate_index_                     = var->aggregate_index_;
+  aggregate->members_.pop_back();
+  var->aggregate_ = nullptr;
+
+  if (aggregate->members_.empty())
+    variable_free(aggregate);
+  else
+    aggregate_rescale(aggregate);
+}
+
+void System::aggregate_split(Variable* var)
+{
+  const Variable* aggregate = var->aggregate_;
+  var->value_               = aggregate->value_;
+  var->cnsts_.reserve(aggregate->cnsts_.size());
+  if (var->sharing_penalty_ > 0)
+    variable_set.push_front(*var);
+  else
+    variable_set.push_back(*var);
+  for (size_t i = 0; i < aggregate->cnsts_.size(); i++) {
+    Element& elem = expand_create_elem(aggregate->cnsts_[i].constraint, var, aggregate->member_weights_[i]);
+    if (var->sharing_penalty_ > 0)
+      elem.increase_concurrency(false);
+  }
+  aggregate_remove(var);
+  update_modified_cnst_set_from_variable(var);
+}
+
+void System::aggregate_rescale(Variable* aggregate)
+{
+  modified_      = true;
+  double members = static_cast<double>(aggregate->members_.size());
+  for (size_t i = 0; i < aggregate->cnsts_.size(); i++) {
+    Element& elem = aggregate->cnsts_[i];
+    // The usage of a fatpipe is the largest weight of its elements: the members weigh as much as a single one
+    if (elem.constraint->get_sharing_policy() == Constraint::SharingPolicy::FATPIPE)
+      continue;
+    if (aggregate->sharing_penalty_ > 0)
+      elem.decrease_concurrency();
+    elem.consumption_weight = aggregate->member_weights_[i] * members;
+    if (aggregate->sharing_penalty_ > 0)
+      elem.increase_concurrency(false);
+  }
+  update_modified_cnst_set_from_variable(aggregate);
+}
+
+bool System::aggregate_move(Variable* var, double penalty, double bound)
+{
+  auto [begin, end] = aggregation_candidates_.equal_range(var->aggregation_key_);
+  auto candidate    = std::find_if(begin, end, [penalty, bound](const auto& elm) {
+    return elm.second->sharing_penalty_ == penalty && elm.second->bound_ == bound;
+  });
+  if (candidate == end)
+    return false;
+
+  modified_ = true;
+  if (var->aggregate_) {
+    aggregate_remove(var);
+  } else {
+    remove_aggregation_candidate(var);
+    remove_variable(var);
+    remove_elements(var);
+  }
+  aggregate_add(candidate->second, var);
+  check_concurrency();
+  return true;
+}
+
 void System::variable_free(Variable* var)
 {
+  if (var->aggregate_)
+    aggregate_remove(var);
   remove_variable(var);
   var_free(var);
 }
 
 void System::variable_free_all()
 {
-  while (Variable* var = extract_variable())
-    variable_free(var);
+  while (Variable* var = extract_variable()) {
+    if (var->members_.empty())
+      variable_free(var);
+    else // The aggregate is freed along with its last member
+      for (size_t count = var->members_.size(); count > 0; count--)
+        variable_free(var->members_.back());
+  }
 }
 
 Element& System::expand_create_elem(Constraint* cnst, Variable* var, double consumption_weight)
@@ -297,6 +502,13 @@ void System::expand(Constraint* cnst, Variable* var, double consumption_weight,
 {
   modified_ = true;
 
+  if (var->aggregation_key_ != 0) { // The variable will not match its key anymore
+    if (var->aggregate_)
+      aggregate_split(var);
+    remove_aggregation_candidate(var);
+    var->aggregation_key_ = 0;
+  }
+
   auto elem_it =
       std::find_if(begin(var->cnsts_), end(var->cnsts_), [&cnst](Element const& x) { return x.constraint == cnst; });
 
@@ -474,21 +686,41 @@ void System::solve()
   do_solve();
 
   modified_ = false;
+  /* Let the resources account for their new load (only the modified constraints were solved in selective mode) */
+  if (selective_update_active)
+    for (const Constraint& cnst : modified_constraint_set)
+      update_usage(&cnst);
+  else
+    for (const Constraint& cnst : active_constraint_set)
+      update_usage(&cnst);
+
   if (selective_update_active) {
     /* update list of modified variables */
+    auto mark_modified = [this](resource::Action* action) {
+      // Some variables have no action, e.g. the aggregate load of the CPUs of the Multicore model
+      if (action != nullptr && not action->is_within_modified_set())
+        modified_set_->push_back(*action);
+    };
     for (const Constraint& cnst : modified_constraint_set) {
       for (const Element& elem : cnst.enabled_element_set_) {
-        if (elem.consumption_weight > 0) {
-          resource::Action* action = elem.variable->id_;
-          if (not action->is_within_modified_set())
-            modified_set_->push_back(*action);
-        }
+        if (elem.consumption_weight <= 0)
+          continue;
+        if (elem.variable->members_.empty())
+          mark_modified(elem.variable->id_);
+        else // An aggregate: all its members are modified
+          for (const Variable* member : elem.variable->members_)
+            mark_modified(member->id_);
       }
     }
     /* clear list of modified constraint */
     remove_all_modified_cnst_set();
   }
 
+  /* The candidates remain valid, but do not let them pile up: the identical flows usually start at the same date */
+  for (auto const& [key, var] : aggregation_candidates_)
+    var->aggregation_candidate_ = false;
+  aggregation_candidates_.clear();
+
   if (XBT_LOG_ISENABLED(ker_lmm, xbt_log_priority_debug)) {
     print();
   }
@@ -506,6 +738,14 @@ void System::solve()
  */
 void System::update_variable_bound(Variable* var, double bound)
 {
+  if (var->aggregation_key_ != 0) {
+    if (bound == var->bound_ || aggregate_move(var, var->sharing_penalty_, bound))
+      return;
+    if (var->aggregate_)
+      aggregate_split(var);
+    remove_aggregation_candidate(var);
+  }
+
   modified_  = true;
   var->bound_ = bound;
 
@@ -514,6 +754,9 @@ void System::update_variable_bound(Variable* var, double bound)
       update_modified_cnst_set(elem.constraint);
     }
   }
+
+  if (var->aggregation_key_ != 0)
+    add_aggregation_candidate(var);
 }
 
 void Variable::initialize(resource::Action* id_value, double sharing_penalty, double bound_value,
@@ -528,6 +771,12 @@ void Variable::initialize(resource::Action* id_value, double sharing_penalty, do
   value_             = 0.0;
   visited_           = visited_value;
   mu_                = 0.0;
+  aggregate_         = nullptr;
+  aggregate_index_   = 0;
+  members_.clear();
+  member_weights_.clear();
+  aggregation_key_       = 0;
+  aggregation_candidate_ = false;
 
   if (cfg_debug_varleak.get())
     backtrace_ = new xbt::Backtrace();
@@ -655,6 +904,14 @@ void System::update_variable_penalty(Variable* var, double penalty)
   if (penalty == var->sharing_penalty_)
     return;
 
+  if (var->aggregation_key_ != 0) {
+    if (aggregate_move(var, penalty, var->bound_))
+      return;
+    if (var->aggregate_)
+      aggregate_split(var);
+    remove_aggregation_candidate(var);
+  }
+
   bool enabling_var  = (penalty > 0 && var->sharing_penalty_ <= 0);
   bool disabling_var = (penalty <= 0 && var->sharing_penalty_ > 0);
 
@@ -679,6 +936,9 @@ void System::update_variable_penalty(Variable* var, double penalty)
     update_modified_cnst_set_from_variable(var);
   }
 
+  if (var->aggregation_key_ != 0 && var->staged_sharing_penalty_ == 0)
+    add_aggregation_candidate(var);
+
   check_concurrency();
 
   XBT_OUT();
@@ -17,6 +17,7 @@
 #include <limits>
 #include <memory>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 /* user-visible parameters */
@@ -336,7 +337,7 @@ public:
                   unsigned visited_value);
 
   /** @brief Get the value of the variable after the last lmm solve */
-  double get_value() const { return value_; }
+  double get_value() const { return aggregate_ ? aggregate_->value_ : value_; }
 
   /** @brief Get the maximum value of the variable (-1.0 if no specified maximum) */
   double get_bound() const { return bound_; }
@@ -346,7 +347,11 @@ public:
    * @param num The rank of constraint we want to get
    * @return The numth constraint
    */
-  Constraint* get_constraint(unsigned num) const { return num < cnsts_.size() ? cnsts_[num].constraint : nullptr; }
+  Constraint* get_constraint(unsigned num) const
+  {
+    const Variable& var = aggregate_ ? *aggregate_ : *this;
+    return num < var.cnsts_.size() ? var.cnsts_[num].constraint : nullptr;
+  }
 
   /**
    * @brief Get the weight of the numth constraint associated to the variable
@@ -355,11 +360,13 @@ public:
    */
   double get_constraint_weight(unsigned num) const
   {
+    if (aggregate_)
+      return num < aggregate_->member_weights_.size() ? aggregate_->member_weights_[num] : 0.0;
     return num < cnsts_.size() ? cnsts_[num].consumption_weight : 0.0;
   }
 
   /** @brief Get the number of constraint associated to a variable */
-  size_t get_number_of_constraint() const { return cnsts_.size(); }
+  size_t get_number_of_constraint() const { return aggregate_ ? aggregate_->cnsts_.size() : cnsts_.size(); }
 
   /** @brief Get the data associated to a variable */
   resource::Action* get_id() const { return id_; }
@@ -398,6 +405,15 @@ public:
 
   xbt::Backtrace* backtrace_ = nullptr; // Used to debug leaking variables when cfg debug/lmm-leak:ON
 
+  /* Aggregation of identical variables (see System::variable_new_aggregated). The members of an aggregate have no
+   * element: the aggregate is a variable without id whose elements weigh as much as all its members together. */
+  Variable* aggregate_;                // For a member: its aggregate (nullptr otherwise)
+  size_t aggregate_index_;             // For a member: its rank among the members of its aggregate
+  std::vector<Variable*> members_;     // For an aggregate: its members
+  std::vector<double> member_weights_; // For an aggregate: the consumption weight of one member on each constraint
+  unsigned long aggregation_key_;      // Variables with the same key have the same constraints and weights (0: none)
+  bool aggregation_candidate_;
+
 private:
   static int next_rank_; // To give a separate rank_ to each variable
 };
@@ -453,6 +469,36 @@ public:
   Variable* variable_new(resource::Action* id, double sharing_penalty, double bound = -1.0,
                          size_t number_of_constraints = 1);
 
+  /**
+   * @brief Create a new variable, aggregated with the identical ones if possible
+   *
+   * Variables with the same constraints, weights, penalty and bound always get the same value. So they are represented
+   * by a single variable in the constraints, whose consumption weights account for all of them. Any later change to the
+   * penalty or bound of an aggregated variable moves it to another aggregate, or gives it its own elements back.
+   *
+   * @param id Data associated to the variable (e.g.: a network communication)
+   * @param key Identifies the constraints and weights of the variable (see set_aggregation_key())
+   * @param sharing_penalty The weight of the variable (0.0 if not used)
+   * @param bound The maximum value of the variable (-1.0 if no maximum value)
+   * @return The new variable, or nullptr if no candidate matches (then create and expand the variable as usual)
+   */
+  Variable* variable_new_aggregated(resource::Action* id, unsigned long key, double sharing_penalty, double bound);
+
+  /**
+   * @brief Allow the aggregation of a fully expanded variable with the next ones created with the same key
+   *
+   * The caller guarantees that all variables of a given key have the same constraints and weights. Variables using a
+   * constraint that is not shared (or fatpipe), or that has a concurrency limit, are never aggregated.
+   */
+  void set_aggregation_key(Variable* var, unsigned long key);
+
+  /**
+   * @brief Give back their own elements to the aggregated variables of a constraint, and never aggregate them again
+   *
+   * Call this before iterating over the variables of the constraint to modify them one by one.
+   */
+  void disable_aggregation(const Constraint* cnst);
+
   /** @brief Get the list of modified actions since last solve() */
   resource::Action::ModifiedSet* get_modified_action_set() const;
 
@@ -500,6 +546,7 @@ private:
   virtual void do_solve() = 0;
 
   void var_free(Variable * var);
+  void remove_elements(Variable* var);
   void cnst_free(Constraint * cnst);
   Variable* extract_variable()
   {
@@ -577,6 +624,19 @@ private:
   /** @brief Remove all constraints of the modified_constraint_set. */
   void remove_all_modified_cnst_set();
 
+  void add_aggregation_candidate(Variable* var);
+  void remove_aggregation_candidate(Variable* var);
+  /** @brief Add a variable without element to the aggregate of target (that becomes an aggregate if needed) */
+  void aggregate_add(Variable* target, Variable* var);
+  /** @brief Remove a member from its aggregate, leaving it without any element */
+  void aggregate_remove(Variable* var);
+  /** @brief Remove a member from its aggregate, giving it its own elements back */
+  void aggregate_split(Variable* var);
+  /** @brief Set the weights of the elements of an aggregate according to its amount of members */
+  void aggregate_rescale(Variable* aggregate);
+  /** @brief Move var to the aggregate of a candidate with that penalty and bound, if any */
+  bool aggregate_move(Variable* var, double penalty, double bound);
+
 public:
   bool modified_ = false;
   boost::intrusive::list<Variable, boost::intrusive::member_hook<Variable, boost::intrusive::list_member_hook<>,
@@ -609,6 +669,14 @@ private:
       xbt_mallocator_new(65536, System::variable_mallocator_new_f, System::variable_mallocator_free_f, nullptr);
 
   std::unique_ptr<resource::Action::ModifiedSet> modified_set_ = nullptr;
+
+  /* Variables that can be aggregated with the new ones of the same key. Forgotten at each solve() */
+  std::unordered_multimap<unsigned long, Variable*> aggregation_candidates_;
+  bool aggregation_used_ = false;
+
+  /* Whether the resources get notified of the changes of their load. Not in the destructor, as they may be gone */
+  bool track_usage_ = true;
+  void update_usage(const Constraint* cnst) const;
 };
 
 /** @} */
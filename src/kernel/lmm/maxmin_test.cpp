@@ -464,4 +464,74 @@ TEST_CASE("kernel::lmm shared systems with crosstraffic", "[kernel-lmm-shared-cr
   }
 
   Sys.variable_free_all();
-}
\ No newline at end of file
+}
+TEST_CASE("kernel::lmm shared systems with aggregated variables", "[kernel-lmm-aggregation]")
+{
+  lmm::MaxMin Sys(false);
+
+  SECTION("Identical variables share the resource as if they were separate")
+  {
+    /*
+     * 4 flows on a shared link (C=8) and a fatpipe (C=10). rho_2 and rho_3 are created identical to rho_1 and aggregated
+     * with it, rho_0 only uses the shared link.
+     *
+     * Expectations
+     *   o rho0 = rho1 = rho2 = rho3 = 2 (fair sharing of the link, the fatpipe is large enough)
+     *   o Then, a variable that diverges from its aggregate gets its own share: with rho3 of penalty 2, the link is
+     *     shared as 3 * rho + rho/2 = 8
+     *   o Variables that diverge in the same way are aggregated again
+     */
+    lmm::Constraint* link    = Sys.constraint_new(nullptr, 8);
+    lmm::Constraint* fatpipe = Sys.constraint_new(nullptr, 10);
+    fatpipe->unshare();
+    lmm::Variable* rho_0 = Sys.variable_new(nullptr, 1);
+    lmm::Variable* rho_1 = Sys.variable_new(nullptr, 1, -1, 2);
+    Sys.expand(link, rho_0, 1);
+    Sys.expand(link, rho_1, 1);
+    Sys.expand(fatpipe, rho_1, 1);
+    Sys.set_aggregation_key(rho_1, 42);
+
+    REQUIRE(Sys.variable_new_aggregated(nullptr, 42, 1, 0.5) == nullptr); // Another bound
+    REQUIRE(Sys.variable_new_aggregated(nullptr, 43, 1, -1) == nullptr);  // Another key
+    lmm::Variable* rho_2 = Sys.variable_new_aggregated(nullptr, 42, 1, -1);
+    lmm::Variable* rho_3 = Sys.variable_new_aggregated(nullptr, 42, 1, -1);
+    REQUIRE(rho_2 != nullptr);
+    REQUIRE(rho_3 != nullptr);
+    REQUIRE(rho_3->get_number_of_constraint() == 2);
+    REQUIRE(rho_3->get_constraint(0) == link);
+    REQUIRE(rho_3->get_constraint_weight(0) == 1);
+    Sys.solve();
+
+    REQUIRE(link->get_load() == 8);
+    REQUIRE(double_equals(rho_0->get_value(), 2, sg_precision_workamount));
+    REQUIRE(double_equals(rho_1->get_value(), 2, sg_precision_workamount));
+    REQUIRE(double_equals(rho_2->get_value(), 2, sg_precision_workamount));
+    REQUIRE(double_equals(rho_3->get_value(), 2, sg_precision_workamount));
+
+    Sys.update_variable_penalty(rho_3, 2);
+    Sys.solve();
+    REQUIRE(double_equals(rho_0->get_value(), 16. / 7, sg_precision_workamount));
+    REQUIRE(double_equals(rho_1->get_value(), 16. / 7, sg_precision_workamount));
+    REQUIRE(double_equals(rho_2->get_value(), 16. / 7, sg_precision_workamount));
+    REQUIRE(double_equals(rho_3->get_value(), 8. / 7, sg_precision_workamount));
+
+    // Both diverge at once, and share a new aggregate. Then rho_1 leaves the system
+    Sys.update_variable_penalty(rho_3, 1);
+    Sys.update_variable_penalty(rho_3, 2);
+    Sys.update_variable_penalty(rho_2, 2);
+    Sys.variable_free(rho_1);
+    Sys.solve();
+    REQUIRE(double_equals(rho_0->get_value(), 4, sg_precision_workamount));
+    REQUIRE(double_equals(rho_2->get_value(), 2, sg_precision_workamount));
+    REQUIRE(double_equals(rho_3->get_value(), 2, sg_precision_workamount));
+
+    Sys.disable_aggregation(link);
+    Sys.update_variable_penalty(rho_3, 1);
+    Sys.solve();
+    REQUIRE(double_equals(rho_0->get_value(), 16. / 5, sg_precision_workamount));
+    REQUIRE(double_equals(rho_2->get_value(), 8. / 5, sg_precision_workamount));
+    REQUIRE(double_equals(rho_3->get_value(), 16. / 5, sg_precision_workamount));
+  }
+
+  Sys.variable_free_all();
+}
@@ -98,6 +98,8 @@ public:
   /** @brief Get the available speed ratio, in [0:1]. This accounts for external load (see @ref set_speed_profile()). */
   virtual double get_speed_ratio() { return speed_.scale; }
 
+  bool has_profile() const override { return Resource::has_profile() || speed_.event != nullptr; }
+
   /** @brief Get the peak processor speed (in flops/s), at the specified pstate */
   virtual double get_pstate_peak_speed(unsigned long pstate_index) const;
 
@@ -182,8 +184,9 @@ public:
   void set_state(Action::State state) override;
 
   void update_remains_lazy(double now) override;
-  std::list<CpuImpl*> cpus() const;
-  CpuImpl* cpu0() const;
+  /** @brief The CPUs used by this action (found in the constraints of its LMM variable by default) */
+  virtual std::list<CpuImpl*> cpus() const;
+  virtual CpuImpl* cpu0() const;
 };
 } // namespace simgrid::kernel::resource
 
@@ -92,6 +92,11 @@ public:
   DiskImpl* set_write_constraint(lmm::Constraint* constraint_write);
   lmm::Constraint* get_write_constraint() const { return constraint_write_; }
 
+  bool has_profile() const override
+  {
+    return Resource::has_profile() || read_bw_.event != nullptr || write_bw_.event != nullptr;
+  }
+
   profile::Event* get_read_event() const { return read_bw_.event; }
   void unref_read_event() { tmgr_trace_event_unref(&read_bw_.event); }
 
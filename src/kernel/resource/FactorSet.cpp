@@ -21,12 +21,23 @@ extern int simgrid_parse_lineno;
 
 namespace simgrid::kernel::resource {
 
+double FactorSet::constant(std::vector<double> const& values, double)
+{
+  return values.front();
+}
+
+double FactorSet::affine(std::vector<double> const& values, double size)
+{
+  return values[0] + values[1] * size;
+}
+
 void FactorSet::parse(const std::string& values)
 {
   initialized_    = true;
 
   if (values.find_first_of(":;") == std::string::npos) { // Single value
     default_value_ = xbt_str_parse_double(values.c_str(), name_.c_str());
+    compile();
     return;
   }
 
@@ -79,6 +90,42 @@ void FactorSet::parse(const std::string& values)
     XBT_DEBUG("smpi_factor:\t%zu: %zu values, first: %f", fact.factor, factors_.size(), fact.values[0]);
   }
   factors_.shrink_to_fit();
+  compile();
+}
+
+void FactorSet::compile()
+{
+  using Shape     = double (*)(std::vector<double> const&, double);
+  const auto* fun = lambda_.target<Shape>();
+  compiled_       = fun != nullptr && (*fun == &FactorSet::constant || *fun == &FactorSet::affine);
+
+  boundaries_.clear();
+  offsets_.assign(1, default_value_);
+  slopes_.assign(1, 0.0);
+  for (auto const& fact : factors_) {
+    boundaries_.push_back(static_cast<double>(fact.factor));
+    if (compiled_) {
+      offsets_.push_back(fact.values.front());
+      slopes_.push_back(*fun == &FactorSet::affine && fact.values.size() > 1 ? fact.values[1] : 0.0);
+    }
+  }
+  XBT_DEBUG("%s: %zu intervals, %s", name_.c_str(), boundaries_.size() + 1,
+            compiled_ ? "compiled" : "evaluated through their lambda");
+}
+
+size_t FactorSet::find_interval(double size) const
+{
+  /* Branch-free binary search of the first boundary that is not smaller than the size (as in std::lower_bound) */
+  size_t count = boundaries_.size();
+  if (count == 0)
+    return 0;
+  const double* base = boundaries_.data();
+  while (count > 1) {
+    size_t half = count / 2;
+    base        = (base[half] < size) ? base + half : base;
+    count -= half;
+  }
+  return static_cast<size_t>(base - boundaries_.data()) + (*base < size ? 1 : 0);
 }
 
 FactorSet::FactorSet(const std::string& name, double default_value,
@@ -97,22 +144,11 @@ double FactorSet::operator()(double size) const
   if (factors_.empty())
     return default_value_;
 
-  for (long unsigned i = 0; i < factors_.size(); i++) {
-    auto const& fact = factors_[i];
-
-    if (size <= fact.factor) { // Too large already, use the previous value
-      if (i == 0) { // Before the first boundary: use the default value
-        XBT_DEBUG("%s: %f <= %zu return default %f", name_.c_str(), size, fact.factor, default_value_);
-        return default_value_;
-      }
-      double val = lambda_(factors_[i - 1].values, size);
-      XBT_DEBUG("%s: %f <= %zu return %f", name_.c_str(), size, fact.factor, val);
-      return val;
-    }
-  }
-  double val = lambda_(factors_.back().values, size);
-
-  XBT_DEBUG("%s: %f > %zu return %f", name_.c_str(), size, factors_.back().factor, val);
+  size_t i = find_interval(size);
+  if (i == 0) // Before the first boundary: use the default value
+    return default_value_;
+  double val = compiled_ ? offsets_[i] + slopes_[i] * size : lambda_(factors_[i - 1].values, size);
+  XBT_DEBUG("%s: %f in interval %zu (from %zu) return %f", name_.c_str(), size, i, factors_[i - 1].factor, val);
   return val;
 }
 } // namespace simgrid::kernel::resource
@@ -28,12 +28,26 @@ class FactorSet {
   const std::function<double(std::vector<double> const&, double)> lambda_;
   bool initialized_ = false;
 
+  /* The intervals compiled by parse(): the factor of a size is offsets_[i] + slopes_[i] * size, where i is the amount
+   * of boundaries that are smaller than that size (i=0 stands for the default value, before the first boundary).
+   * Only the constant() and affine() lambdas can be compiled. The other ones are applied to factors_[i-1].values. */
+  std::vector<double> boundaries_;
+  std::vector<double> offsets_;
+  std::vector<double> slopes_;
+  bool compiled_ = false;
+
+  void compile();
+  size_t find_interval(double size) const;
+
 public:
+  /** The factor is the first value of the interval */
+  static double constant(std::vector<double> const& values, double size);
+  /** The factor is values[0] + values[1] * size (as in the SMPI overheads) */
+  static double affine(std::vector<double> const& values, double size);
+
   // Parse the factor from a string
-  FactorSet(
-      const std::string& name, double default_value = 1,
-      std::function<double(std::vector<double> const&, double)> const& lambda = [](std::vector<double> const& values,
-                                                                                   double) { return values.front(); });
+  FactorSet(const std::string& name, double default_value = 1,
+            std::function<double(std::vector<double> const&, double)> const& lambda = &FactorSet::constant);
   void parse(const std::string& string_values);
   bool is_initialized() const { return initialized_; }
   // Get the default value
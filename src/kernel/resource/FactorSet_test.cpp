@@ -0,0 +1,78 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/3rd-party/catch.hpp"
+
+#include "src/kernel/resource/FactorSet.hpp"
+
+using simgrid::kernel::resource::FactorSet;
+
+TEST_CASE("kernel::resource::FactorSet: Piecewise factors", "")
+{
+  SECTION("Single value")
+  {
+    FactorSet factors("test/single");
+    factors.parse("13.01");
+    REQUIRE(factors(0) == 13.01);
+    REQUIRE(factors(1e9) == 13.01);
+    REQUIRE(factors() == 13.01);
+  }
+
+  SECTION("Constant intervals")
+  {
+    FactorSet factors("test/constant");
+    factors.parse("5000:3;0:1;1000:2"); // Unsorted on purpose
+    REQUIRE(factors(0) == 1);   // On the first boundary: default value
+    REQUIRE(factors(0.5) == 1); // Not an integer
+    REQUIRE(factors(1000) == 1);
+    REQUIRE(factors(1001) == 2);
+    REQUIRE(factors(5000) == 2);
+    REQUIRE(factors(5001) == 3);
+    REQUIRE(factors(1e12) == 3);
+  }
+
+  SECTION("Intervals starting after 0")
+  {
+    FactorSet factors("test/default", 7);
+    factors.parse("257:1.95;732:1.5");
+    REQUIRE(factors(0) == 7);
+    REQUIRE(factors(257) == 7);
+    REQUIRE(factors(258) == 1.95);
+    REQUIRE(factors(733) == 1.5);
+  }
+
+  SECTION("Affine intervals")
+  {
+    FactorSet factors("test/affine", 0.0, &FactorSet::affine);
+    factors.parse("0:1:0.5;100:10:0.25");
+    REQUIRE(factors(0) == 0.0);
+    REQUIRE(factors(10) == 1 + 0.5 * 10);
+    REQUIRE(factors(100) == 1 + 0.5 * 100);
+    REQUIRE(factors(200) == 10 + 0.25 * 200);
+  }
+
+  SECTION("Other lambdas")
+  {
+    FactorSet factors("test/lambda", 1.0, [](std::vector<double> const& values, double size) {
+      return values.back() * size;
+    });
+    factors.parse("0:1:2;10:3:4");
+    REQUIRE(factors(5) == 2 * 5);
+    REQUIRE(factors(20) == 4 * 20);
+  }
+
+  SECTION("Many intervals")
+  {
+    std::string spec;
+    for (int i = 0; i < 100; i++)
+      spec += std::to_string(i * 10) + ":" + std::to_string(i) + ";";
+    spec.pop_back();
+    FactorSet factors("test/many", -1);
+    factors.parse(spec);
+    REQUIRE(factors(0) == -1);
+    for (int size = 1; size < 1100; size++)
+      REQUIRE(factors(size) == std::min((size - 1) / 10, 99));
+  }
+}
@@ -25,6 +25,19 @@ namespace simgrid::kernel::resource {
 /*********
  * Model *
  *********/
+Action* HostModel::execute_parallel(const std::vector<s4u::Host*>& host_list, const double* flops_amount,
+                                   const std::vector<s4u::Exec::Transfer>& transfers, double rate)
+{
+  const size_t host_nb = host_list.size();
+  std::vector<double> bytes_amount(host_nb * host_nb, 0.0);
+  for (auto const& [src, dst, bytes] : transfers) {
+    xbt_assert(src < host_nb && dst < host_nb, "Transfer from host #%zu to host #%zu, out of the %zu hosts", src, dst,
+               host_nb);
+    bytes_amount[src * host_nb + dst] += bytes;
+  }
+  return execute_parallel(host_list, flops_amount, bytes_amount.data(), rate);
+}
+
 Action* HostModel::io_stream(s4u::Host* src_host, const DiskImpl* src_disk, s4u::Host* dst_host,
                              const DiskImpl* dst_disk, double size)
 {
@@ -9,7 +9,9 @@
 #include "src/kernel/actor/ActorImpl.hpp"
 #include "src/kernel/resource/CpuImpl.hpp"
 #include "src/kernel/resource/DiskImpl.hpp"
+#include <simgrid/s4u/Exec.hpp>
 #include <xbt/PropertyHolder.hpp>
+#include <xbt/intern.hpp>
 
 #include <vector>
 
@@ -29,6 +31,10 @@ public:
 
   virtual Action* execute_parallel(const std::vector<s4u::Host*>& host_list, const double* flops_amount,
                                    const double* bytes_amount, double rate) = 0;
+  /** Same as above, with the communications given as a sparse list instead of a host_count-square matrix. By
+   *  default, the matrix is built and given to the other version */
+  virtual Action* execute_parallel(const std::vector<s4u::Host*>& host_list, const double* flops_amount,
+                                   const std::vector<s4u::Exec::Transfer>& transfers, double rate);
   Action* io_stream(s4u::Host* src_host, const DiskImpl* src_disk, s4u::Host* dst_host, const DiskImpl* dst_disk,
                     double size);
 };
@@ -51,7 +57,7 @@ class XBT_PRIVATE HostImpl : public xbt::PropertyHolder, public actor::ObjectAcc
   s4u::Host piface_;
   std::map<std::string, DiskImplPtr, std::less<>> disks_;
   std::map<std::string, VirtualMachineImpl*, std::less<>> vms_;
-  std::string name_{"noname"};
+  xbt::InternedString name_{"noname"};
   routing::NetZoneImpl* englobing_zone_ = nullptr;
   bool sealed_                          = false;
 
@@ -81,7 +87,7 @@ public:
   virtual s4u::Host* get_iface() { return &piface_; }
 
   /** Retrieves the name of that host as a C++ string */
-  std::string const& get_name() const { return name_; }
+  std::string const& get_name() const { return name_.str(); }
   /** Retrieves the name of that host as a C string */
   const char* get_cname() const { return name_.c_str(); }
 
@@ -14,6 +14,7 @@
 #include "src/kernel/resource/profile/FutureEvtSet.hpp"
 #include "src/kernel/resource/profile/Profile.hpp"
 #include "xbt/signal.hpp"
+#include "xbt/intern.hpp"
 #include "xbt/str.h"
 #include "xbt/utility.hpp"
 
@@ -26,11 +27,18 @@ namespace simgrid::kernel::resource {
  * @details This is the ancestor class of every resources in SimGrid, such as links, CPU or disk
  */
 class XBT_PUBLIC Resource : public actor::ObjectAccessSimcallItem {
-  std::string name_            = "unnamed";
+  xbt::InternedString name_{"unnamed"};
   bool is_on_                  = true;
   bool sealed_                 = false;
   profile::Event* state_event_ = nullptr;
 
+  /* Time-weighted usage, folded each time the LMM system changes the load of usage_constraint_ */
+  const lmm::Constraint* usage_constraint_ = nullptr;
+  double usage_load_                       = 0.0; // Load since usage_date_
+  double usage_date_                       = 0.0;
+  double usage_integral_                   = 0.0; // Integral of the load up to usage_date_
+  double busy_time_                        = 0.0; // Time spent with a positive load up to usage_date_
+
 protected:
   struct Metric {
     double peak;           /**< The peak of the metric, ie its max value */
@@ -41,6 +49,7 @@ protected:
   virtual profile::Event* get_state_event() const { return state_event_; }
   virtual void set_state_event(profile::Event* evt) { state_event_ = evt; }
   virtual void unref_state_event() { tmgr_trace_event_unref(&state_event_); }
+  void set_usage_constraint(const lmm::Constraint* constraint) { usage_constraint_ = constraint; }
 
 public:
   explicit Resource(const std::string& name) : name_(name){};
@@ -48,7 +57,7 @@ public:
   virtual void seal() { sealed_ = true; }
 
   /** @brief Get the name of the current Resource */
-  const std::string& get_name() const { return name_; }
+  const std::string& get_name() const { return name_.str(); }
   /** @brief Get the name of the current Resource */
   const char* get_cname() const { return name_.c_str(); }
 
@@ -60,6 +69,8 @@ public:
   /** @brief Check if the current Resource is active */
   virtual bool is_on() const { return is_on_; }
   virtual bool is_sealed() const { return sealed_; }
+  /** @brief Check if some profile drives the state or the metrics of the current Resource */
+  virtual bool has_profile() const { return get_state_event() != nullptr; }
 
   /** @brief Check if the current Resource is used (if it currently serves an action) */
   virtual bool is_used() const = 0;
@@ -67,6 +78,32 @@ public:
   virtual void turn_on() { is_on_ = true; }
   /** @brief Turn off the current Resource */
   virtual void turn_off() { is_on_ = false; }
+
+  /** @brief Records the new load of that constraint, if it is the main constraint of this resource
+   *
+   * Called by the LMM system each time it changes the load of the constraint, i.e. after each resolution and when its
+   * last variable is removed. */
+  void update_usage(const lmm::Constraint* constraint)
+  {
+    if (constraint != usage_constraint_)
+      return;
+    double now = EngineImpl::get_clock();
+    usage_integral_ += usage_load_ * (now - usage_date_);
+    if (usage_load_ > 0)
+      busy_time_ += now - usage_date_;
+    usage_load_ = constraint->get_load();
+    usage_date_ = now;
+  }
+  /** @brief Integral over time of the load since the beginning of the simulation (in flops, bytes or similar)
+   *
+   * This is the amount of work that the activities actually got from this resource. The load due to external usages
+   * modeled by profile files is ignored. Only maintained by the models relying on the LMM system. */
+  double get_usage_integral() const { return usage_integral_ + usage_load_ * (EngineImpl::get_clock() - usage_date_); }
+  /** @brief Time during which this resource served at least one activity since the beginning of the simulation */
+  double get_busy_time() const
+  {
+    return usage_load_ > 0 ? busy_time_ + (EngineImpl::get_clock() - usage_date_) : busy_time_;
+  }
 };
 
 template <class AnyResource> class Resource_T : public Resource {
@@ -112,6 +149,7 @@ public:
   AnyResource* set_constraint(lmm::Constraint* constraint)
   {
     constraint_ = constraint;
+    set_usage_constraint(constraint);
     return static_cast<AnyResource*>(this);
   }
 
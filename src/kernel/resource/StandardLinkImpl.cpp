@@ -90,7 +90,12 @@ void StandardLinkImpl::turn_off()
     Resource::turn_off();
     s4u::Link::on_onoff(piface_);
     piface_.on_this_onoff(piface_);
-    cancel_actions();
+    /* The Packet model has no sharing system and fails its own flows (see LinkPacket::turn_off()). The ns-3 model has
+     * none either, and ignores the state of its links: its flows keep going through a link that is turned off */
+    if (get_constraint() != nullptr) {
+      get_model()->get_maxmin_system()->disable_aggregation(get_constraint());
+      cancel_actions();
+    }
   }
 }
 
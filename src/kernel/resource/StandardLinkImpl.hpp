@@ -48,6 +48,11 @@ public:
   /** @brief Get the latency in seconds of current Link */
   double get_latency() const override { return latency_.peak * latency_.scale; }
 
+  bool has_profile() const override
+  {
+    return Resource::has_profile() || bandwidth_.event != nullptr || latency_.event != nullptr;
+  }
+
   /** @brief The sharing policy */
   void set_sharing_policy(s4u::Link::SharingPolicy policy, const s4u::NonLinearResourceCb& cb) override;
 
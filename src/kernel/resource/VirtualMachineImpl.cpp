@@ -15,6 +15,7 @@
 #include "src/kernel/resource/models/cpu_ti.hpp"
 #include "src/simgrid/module.hpp"
 #include "src/simgrid/sg_config.hpp"
+#include "xbt/asserts.hpp"
 
 #include <numeric>
 
@@ -192,6 +193,11 @@ VirtualMachineImpl::VirtualMachineImpl(const std::string& name, simgrid::s4u::Ho
                                        size_t ramsize)
     : HostImpl(name), physical_host_(host_PM), core_amount_(core_amount), ramsize_(ramsize)
 {
+  /* The VCPU model needs the rate of the action of the VM on its PM, that the Multicore model does not compute */
+  xbt_enforce(simgrid::config::get_value<std::string>("cpu/model") != "Multicore",
+              "Cannot create the VM %s: the Multicore CPU model does not support virtual machines. Use "
+              "--cfg=cpu/model:Cas01 instead.",
+              name.c_str());
   /* We create cpu_action corresponding to a VM process on the host operating system. */
   /* TODO: we have to periodically input GUESTOS_NOISE to the system? how ?
    * The value for GUESTOS_NOISE corresponds to the cost of the global action associated to the VM.  It corresponds to
@@ -90,6 +90,7 @@ private:
 class XBT_PRIVATE VMModel : public HostModel {
 public:
   explicit VMModel(const std::string& name);
+  using HostModel::execute_parallel;
 
   double next_occurring_event(double now) override;
   void update_actions_state(double /*now*/, double /*delta*/) override{};
@@ -0,0 +1,414 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <simgrid/kernel/routing/NetZoneImpl.hpp>
+
+#include "src/kernel/EngineImpl.hpp"
+#include "src/kernel/lmm/System.hpp"
+#include "src/kernel/resource/models/cpu_multicore.hpp"
+#include "src/kernel/resource/profile/Event.hpp"
+#include "src/simgrid/math_utils.h"
+#include "src/simgrid/module.hpp"
+#include "src/simgrid/sg_config.hpp"
+
+#include <algorithm>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(cpu_multicore, res_cpu, "CPU resource, Multicore model");
+
+/*********
+ * Model *
+ *********/
+SIMGRID_REGISTER_CPU_MODEL(Multicore, "Same sharing as Cas01, computed per class of executions (many-core hosts)", []() {
+  auto cpu_model_pm = std::make_shared<simgrid::kernel::resource::CpuMulticoreModel>("Cpu_Multicore");
+  auto* engine      = simgrid::kernel::EngineImpl::get_instance();
+  engine->add_model(cpu_model_pm);
+  engine->get_netzone_root()->set_cpu_pm_model(cpu_model_pm);
+});
+
+namespace simgrid::kernel::resource {
+
+CpuMulticoreModel::CpuMulticoreModel(const std::string& name) : CpuModel(name)
+{
+  /* Only the aggregate variables of the modified CPUs are given to the solver */
+  set_maxmin_system(lmm::System::build("maxmin", true));
+}
+
+CpuImpl* CpuMulticoreModel::create_cpu(s4u::Host* host, const std::vector<double>& speed_per_pstate)
+{
+  return (new CpuMulticore(host, speed_per_pstate))->set_model(this);
+}
+
+double CpuMulticoreModel::next_occurring_event(double now)
+{
+  for (auto it = std::begin(modified_cpus_); it != std::end(modified_cpus_);) {
+    CpuMulticore& cpu = *it;
+    ++it; // share() removes the CPU from the list
+    cpu.share(now);
+  }
+  get_maxmin_system()->solve();
+
+  if (get_action_heap().empty())
+    return -1;
+  return get_action_heap().top_date() - now;
+}
+
+void CpuMulticoreModel::update_actions_state(double now, double /*delta*/)
+{
+  while (not get_action_heap().empty() && double_equals(get_action_heap().top_date(), now, sg_precision_timing)) {
+    auto* action = static_cast<CpuMulticoreAction*>(get_action_heap().pop());
+    if (action->get_type() == ActionHeap::Type::normal) {
+      action->cpu_->complete(*action, now);
+    } else {
+      XBT_DEBUG("Action %p: max duration reached", action);
+      action->finish(Action::State::FINISHED);
+    }
+  }
+}
+
+/************
+ * Resource *
+ ************/
+CpuMulticore::~CpuMulticore()
+{
+  set_modified(false);
+}
+
+void CpuMulticore::set_modified(bool modified)
+{
+  MulticoreCpuList& modified_cpus = static_cast<CpuMulticoreModel*>(get_model())->modified_cpus_;
+  if (modified) {
+    if (not cpu_hook_.is_linked())
+      modified_cpus.push_back(*this);
+  } else {
+    if (cpu_hook_.is_linked())
+      xbt::intrusive_erase(modified_cpus, *this);
+  }
+}
+
+/** Accounts for the virtual work done by each class since the last update, at the current rates */
+void CpuMulticore::update_work(double now)
+{
+  if (now <= last_update_)
+    return;
+  for (auto& [key, cls] : classes_)
+    cls.work = get_work(cls, now);
+  last_update_ = now;
+}
+
+/** Marks an action to be (re)attached and (re)scheduled at the next sharing of this CPU */
+void CpuMulticore::enqueue(CpuMulticoreAction& action)
+{
+  if (not action.pending_hook_.is_linked())
+    pending_.push_back(action);
+  set_modified(true);
+}
+
+void CpuMulticore::attach(CpuMulticoreAction& action)
+{
+  auto [it, created] =
+      classes_.try_emplace(std::make_tuple(action.requested_core_, action.get_user_bound(), action.penalty_));
+  CpuMulticoreClass& cls = it->second;
+  if (created) {
+    cls.cores      = action.requested_core_;
+    cls.user_bound = action.get_user_bound();
+    cls.penalty    = action.penalty_;
+  }
+  action.class_       = &cls;
+  action.finish_work_ = cls.work + action.get_remains_no_update();
+  action.class_hook_  = cls.heap.emplace(action.finish_work_, &action);
+  cls.count++;
+}
+
+/** Removes an action from its class, if any. Its remaining amount is not updated */
+void CpuMulticore::detach(CpuMulticoreAction& action)
+{
+  if (action.pending_hook_.is_linked())
+    xbt::intrusive_erase(pending_, action);
+  CpuMulticoreClass* cls = action.class_;
+  if (cls == nullptr)
+    return;
+
+  cls->heap.erase(*action.class_hook_);
+  action.class_hook_ = boost::none;
+  action.class_      = nullptr;
+  if (cls->head == &action)
+    cls->head = nullptr;
+  if (--cls->count == 0)
+    classes_.erase(std::make_tuple(cls->cores, cls->user_bound, cls->penalty));
+  set_modified(true);
+}
+
+/** Puts the action in the heap of the model, at its completion (if it is the head of its class) or at its deadline */
+void CpuMulticore::schedule(CpuMulticoreAction& action, double now)
+{
+  double date = NO_MAX_DURATION;
+  auto type   = ActionHeap::Type::normal;
+  if (const CpuMulticoreClass* cls = action.class_; cls != nullptr && cls->head == &action && cls->rate > 0)
+    date = now + std::max(0.0, action.finish_work_ - get_work(*cls, now)) / cls->rate;
+  if (action.get_max_duration() != NO_MAX_DURATION) {
+    double deadline = action.get_start_time() + action.get_max_duration();
+    if (date == NO_MAX_DURATION || deadline < date) {
+      date = deadline;
+      type = ActionHeap::Type::max_duration;
+    }
+  }
+
+  if (date == NO_MAX_DURATION)
+    get_model()->get_action_heap().remove(&action);
+  else
+    get_model()->get_action_heap().update(&action, date, type);
+}
+
+/** Computes the rate of each class, as the LMM would do for the individual executions */
+void CpuMulticore::share(double now)
+{
+  update_work(now);
+  while (not pending_.empty()) {
+    CpuMulticoreAction& action = pending_.front();
+    pending_.pop_front();
+    if (action.class_ == nullptr && action.get_state_set() == get_model()->get_started_action_set() &&
+        action.is_running() && action.penalty_ > 0)
+      attach(action);
+    schedule(action, now);
+  }
+
+  /* Water-filling: the classes are saturated by increasing level of the fair share at which they reach their bound */
+  double speed = speed_.scale * speed_.peak;
+  auto bound   = [speed](const CpuMulticoreClass& cls) {
+    return cls.user_bound > 0 ? std::min(cls.cores * speed, cls.user_bound) : cls.cores * speed;
+  };
+  std::vector<CpuMulticoreClass*> sorted;
+  double capacity = get_core_count() * speed;
+  double weights  = 0;
+  for (auto& [key, cls] : classes_) {
+    sorted.push_back(&cls);
+    weights += static_cast<double>(cls.count) / cls.penalty;
+  }
+  std::sort(sorted.begin(), sorted.end(), [&bound](const CpuMulticoreClass* a, const CpuMulticoreClass* b) {
+    return bound(*a) * a->penalty < bound(*b) * b->penalty;
+  });
+
+  double total = 0;
+  for (CpuMulticoreClass* cls : sorted) {
+    double fair_share = weights > 0 ? capacity / weights / cls->penalty : 0;
+    cls->rate         = std::max(0.0, std::min(bound(*cls), fair_share));
+    capacity -= static_cast<double>(cls->count) * cls->rate;
+    weights -= static_cast<double>(cls->count) / cls->penalty;
+    total += static_cast<double>(cls->count) * cls->rate;
+    XBT_DEBUG("Cpu %s: %lu executions of %d cores (bound %g, penalty %g) at %g flops", get_cname(), cls->count,
+              cls->cores, cls->user_bound, cls->penalty, cls->rate);
+  }
+
+  /* Only the first execution to complete in each class is in the heap of the model */
+  for (auto& [key, cls] : classes_) {
+    CpuMulticoreAction* previous = cls.head;
+    cls.head                     = cls.heap.top().second;
+    if (previous != nullptr && previous != cls.head)
+      schedule(*previous, now);
+    schedule(*cls.head, now);
+  }
+
+  /* Give the total rate to the LMM, for the load of this CPU */
+  auto* lmm = get_model()->get_maxmin_system();
+  if (total > 0 && load_ == nullptr) {
+    load_ = lmm->variable_new(nullptr, 1.0, total, 1);
+    lmm->expand(get_constraint(), load_, 1.0);
+  } else if (total > 0) {
+    lmm->update_variable_bound(load_, total);
+  } else if (load_ != nullptr) {
+    lmm->variable_free(load_);
+    load_ = nullptr;
+  }
+  set_modified(false);
+}
+
+/** Completes the head of a class, along with the other executions of that class that end within the time precision */
+void CpuMulticore::complete(CpuMulticoreAction& head, double now)
+{
+  const CpuMulticoreClass* cls = head.class_;
+  double horizon               = get_work(*cls, now) + cls->rate * sg_precision_timing;
+  bool others                  = cls->count > 1;
+  XBT_DEBUG("Action %p: finish", &head);
+  head.finish(Action::State::FINISHED);
+  while (others && cls->heap.top().first <= horizon) {
+    CpuMulticoreAction* action = cls->heap.top().second;
+    others                     = cls->count > 1;
+    XBT_DEBUG("Action %p: finish", action);
+    action->finish(Action::State::FINISHED);
+  }
+}
+
+void CpuMulticore::on_speed_change()
+{
+  get_model()->get_maxmin_system()->update_constraint_bound(get_constraint(),
+                                                            get_core_count() * speed_.scale * speed_.peak);
+  set_modified(true);
+  CpuImpl::on_speed_change();
+}
+
+void CpuMulticore::apply_event(profile::Event* event, double value)
+{
+  if (event == speed_.event) {
+    speed_.scale = value;
+    on_speed_change();
+
+    tmgr_trace_event_unref(&speed_.event);
+  } else if (event == get_state_event()) {
+    if (value > 0) {
+      if (not is_on()) {
+        XBT_VERB("Restart actors on host %s", get_iface()->get_cname());
+        get_iface()->turn_on();
+      }
+    } else {
+      get_iface()->turn_off();
+    }
+    unref_state_event();
+
+  } else {
+    xbt_die("Unknown event!\n");
+  }
+}
+
+void CpuMulticore::turn_off()
+{
+  /* Skip CpuImpl::turn_off(), that searches the actions in the LMM */
+  if (is_on()) {
+    Resource::turn_off();
+    double now = EngineImpl::get_clock();
+    for (CpuMulticoreAction& action : actions_) {
+      if (action.get_state() == Action::State::INITED || action.get_state() == Action::State::STARTED ||
+          action.get_state() == Action::State::IGNORED) {
+        action.set_finish_time(now);
+        action.set_state(Action::State::FAILED);
+      }
+    }
+  }
+}
+
+CpuAction* CpuMulticore::execution_start(double size, double user_bound)
+{
+  return execution_start(size, 1, user_bound);
+}
+
+CpuAction* CpuMulticore::execution_start(double size, int requested_cores, double user_bound)
+{
+  auto* action = new CpuMulticoreAction(this, size, requested_cores);
+  action->set_user_bound(user_bound);
+  return action;
+}
+
+CpuAction* CpuMulticore::sleep(double duration)
+{
+  if (duration > 0)
+    duration = std::max(duration, sg_precision_timing);
+
+  XBT_IN("(%s, %g)", get_cname(), duration);
+  auto* action = new CpuMulticoreAction(this, 1.0, 1);
+
+  action->set_max_duration(duration);
+  action->set_suspend_state(Action::SuspendStates::SLEEPING);
+  if (duration == NO_MAX_DURATION)
+    action->set_state(Action::State::IGNORED);
+
+  XBT_OUT();
+  return action;
+}
+
+/**********
+ * Action *
+ **********/
+/* The action is only attached to a class when the CPU is shared, so that its remaining amount, bound and sharing
+ * penalty can still be set right after its creation (e.g. on migrations) */
+CpuMulticoreAction::CpuMulticoreAction(CpuMulticore* cpu, double cost, int requested_core)
+    : CpuAction(cpu->get_model(), cost, not cpu->is_on())
+    , cpu_(cpu)
+    , requested_core_(requested_core)
+    , penalty_(1.0 / requested_core)
+{
+  cpu_->actions_.push_back(*this);
+  cpu_->enqueue(*this);
+}
+
+CpuMulticoreAction::~CpuMulticoreAction()
+{
+  if (action_hook_.is_linked())
+    xbt::intrusive_erase(cpu_->actions_, *this);
+  cpu_->detach(*this);
+}
+
+void CpuMulticoreAction::set_state(Action::State state)
+{
+  CpuAction::set_state(state);
+  cpu_->detach(*this);
+  get_model()->get_action_heap().remove(this);
+  if (state == Action::State::STARTED)
+    cpu_->enqueue(*this);
+}
+
+void CpuMulticoreAction::suspend()
+{
+  XBT_IN("(%p)", this);
+  if (is_running()) {
+    set_remains(get_remains());
+    cpu_->detach(*this);
+    get_model()->get_action_heap().remove(this);
+    set_suspend_state(Action::SuspendStates::SUSPENDED);
+    cpu_->enqueue(*this); // Its max duration still holds
+  }
+  XBT_OUT();
+}
+
+void CpuMulticoreAction::resume()
+{
+  XBT_IN("(%p)", this);
+  if (is_suspended()) {
+    set_suspend_state(Action::SuspendStates::RUNNING);
+    cpu_->enqueue(*this);
+  }
+  XBT_OUT();
+}
+
+void CpuMulticoreAction::set_max_duration(double duration)
+{
+  CpuAction::set_max_duration(duration);
+  cpu_->enqueue(*this);
+}
+
+void CpuMulticoreAction::set_sharing_penalty(double sharing_penalty)
+{
+  XBT_IN("(%p,%g)", this, sharing_penalty);
+  set_sharing_penalty_no_update(sharing_penalty);
+  if (class_ != nullptr) {
+    set_remains(get_remains());
+    cpu_->detach(*this);
+  }
+  penalty_ = sharing_penalty;
+  cpu_->enqueue(*this);
+  XBT_OUT();
+}
+
+double CpuMulticoreAction::get_remains()
+{
+  if (class_ == nullptr)
+    return get_remains_no_update();
+  return std::max(0.0, finish_work_ - cpu_->get_work(*class_, EngineImpl::get_clock()));
+}
+
+std::list<CpuImpl*> CpuMulticoreAction::cpus() const
+{
+  return {cpu_};
+}
+
+CpuImpl* CpuMulticoreAction::cpu0() const
+{
+  return cpu_;
+}
+
+void CpuMulticoreAction::update_remains_lazy(double /*now*/)
+{
+  THROW_IMPOSSIBLE;
+}
+
+} // namespace simgrid::kernel::resource
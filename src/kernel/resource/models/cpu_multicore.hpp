@@ -0,0 +1,161 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_MODEL_CPU_MULTICORE_HPP_
+#define SIMGRID_MODEL_CPU_MULTICORE_HPP_
+
+#include "src/kernel/resource/CpuImpl.hpp"
+#include "xbt/utility.hpp"
+
+#include <boost/heap/pairing_heap.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/optional.hpp>
+#include <map>
+#include <tuple>
+
+namespace simgrid::kernel::resource {
+
+/***********
+ * Classes *
+ ***********/
+class XBT_PRIVATE CpuMulticoreModel;
+class XBT_PRIVATE CpuMulticore;
+class XBT_PRIVATE CpuMulticoreAction;
+
+using multicore_heap_element = std::pair<double, CpuMulticoreAction*>;
+using multicore_heap = boost::heap::pairing_heap<multicore_heap_element, boost::heap::constant_time_size<false>,
+                                                 boost::heap::stable<true>,
+                                                 boost::heap::compare<xbt::HeapComparator<multicore_heap_element>>>;
+
+/** @brief The executions of a CPU that share the same amount of cores, user bound and sharing penalty.
+ *
+ * They all run at the same rate, so the class only tracks its virtual work, i.e. the amount of flops computed by each of
+ * its executions since the creation of the class. An execution completes when the virtual work reaches the value it had
+ * when the execution joined the class, plus the remaining amount of the execution.
+ */
+struct XBT_PRIVATE CpuMulticoreClass {
+  int cores;               /*< Amount of cores requested by each execution */
+  double user_bound;       /*< Bound given by the user to each execution, or a negative value */
+  double penalty;          /*< Sharing penalty of each execution */
+  unsigned long count = 0; /*< Amount of executions in the class */
+  double rate         = 0; /*< Speed of each execution of the class */
+  double work         = 0; /*< Virtual work at the last update of the CPU */
+  multicore_heap heap;     /*< Executions of the class, by virtual work at completion */
+  CpuMulticoreAction* head = nullptr; /*< Execution of the class whose completion is in the action heap of the model */
+};
+
+/**********
+ * Action *
+ **********/
+class CpuMulticoreAction : public CpuAction {
+  friend CpuMulticore;
+  friend CpuMulticoreModel;
+
+  CpuMulticore* cpu_;
+  int requested_core_;
+  double penalty_;                     /*< Sharing penalty, as given to the LMM variable of the Cas01 model */
+  CpuMulticoreClass* class_ = nullptr; /*< Class in which the action is running, if any */
+  double finish_work_       = 0;       /*< Virtual work of the class at the completion of the action */
+  boost::optional<multicore_heap::handle_type> class_hook_ = boost::none;
+
+public:
+  CpuMulticoreAction(CpuMulticore* cpu, double cost, int requested_core);
+  CpuMulticoreAction(const CpuMulticoreAction&)            = delete;
+  CpuMulticoreAction& operator=(const CpuMulticoreAction&) = delete;
+  ~CpuMulticoreAction() override;
+
+  void set_state(Action::State state) override;
+  void suspend() override;
+  void resume() override;
+  void set_max_duration(double duration) override;
+  void set_sharing_penalty(double sharing_penalty) override;
+  double get_remains() override;
+  std::list<CpuImpl*> cpus() const override;
+  CpuImpl* cpu0() const override;
+  XBT_ATTRIB_NORETURN void update_remains_lazy(double now) override;
+
+  boost::intrusive::list_member_hook<> action_hook_;  /*< In the list of the actions of the CPU */
+  boost::intrusive::list_member_hook<> pending_hook_; /*< In the list of the actions to (re)attach to a class */
+};
+
+using MulticoreActionList = boost::intrusive::list<
+    CpuMulticoreAction, boost::intrusive::member_hook<CpuMulticoreAction, boost::intrusive::list_member_hook<>,
+                                                      &CpuMulticoreAction::action_hook_>>;
+using MulticorePendingList = boost::intrusive::list<
+    CpuMulticoreAction, boost::intrusive::member_hook<CpuMulticoreAction, boost::intrusive::list_member_hook<>,
+                                                      &CpuMulticoreAction::pending_hook_>>;
+
+/************
+ * Resource *
+ ************/
+/** @brief A CPU of homogeneous cores, shared by processor sharing with a bound of one core per requested core
+ *
+ * The executions are grouped in classes whose members run at the same rate. The rates are computed by water-filling
+ * over the classes, and the only thing given to the LMM is an aggregate variable holding the total rate, so that the
+ * load of the CPU is still known to the plugins. The cost of a change is thus in O(classes + log(executions)) instead
+ * of a LMM solve over all the executions.
+ */
+class CpuMulticore : public CpuImpl {
+  friend CpuMulticoreAction;
+  friend CpuMulticoreModel;
+
+  std::map<std::tuple<int, double, double>, CpuMulticoreClass> classes_;
+  MulticoreActionList actions_;
+  MulticorePendingList pending_;
+  lmm::Variable* load_ = nullptr; /*< Aggregate variable, while the CPU computes something */
+  double last_update_  = 0;       /*< Date up to which the virtual work of the classes is computed */
+
+  double get_work(const CpuMulticoreClass& cls, double now) const { return cls.work + cls.rate * (now - last_update_); }
+  void update_work(double now);
+  void enqueue(CpuMulticoreAction& action);
+  void attach(CpuMulticoreAction& action);
+  void detach(CpuMulticoreAction& action);
+  void schedule(CpuMulticoreAction& action, double now);
+  void share(double now);
+  void complete(CpuMulticoreAction& head, double now);
+  void set_modified(bool modified);
+
+public:
+  using CpuImpl::CpuImpl;
+  CpuMulticore(const CpuMulticore&)            = delete;
+  CpuMulticore& operator=(const CpuMulticore&) = delete;
+  ~CpuMulticore() override;
+
+  void apply_event(profile::Event* event, double value) override;
+  void turn_off() override;
+  CpuAction* execution_start(double size, double user_bound) override;
+  CpuAction* execution_start(double size, int requested_cores, double user_bound) override;
+  CpuAction* sleep(double duration) override;
+
+  boost::intrusive::list_member_hook<> cpu_hook_;
+
+protected:
+  void on_speed_change() override;
+};
+
+using MulticoreCpuList = boost::intrusive::list<
+    CpuMulticore,
+    boost::intrusive::member_hook<CpuMulticore, boost::intrusive::list_member_hook<>, &CpuMulticore::cpu_hook_>>;
+
+/*********
+ * Model *
+ *********/
+class CpuMulticoreModel : public CpuModel {
+  MulticoreCpuList modified_cpus_;
+  friend CpuMulticore;
+
+public:
+  explicit CpuMulticoreModel(const std::string& name);
+  CpuMulticoreModel(const CpuMulticoreModel&)            = delete;
+  CpuMulticoreModel& operator=(const CpuMulticoreModel&) = delete;
+
+  CpuImpl* create_cpu(s4u::Host* host, const std::vector<double>& speed_per_pstate) override;
+  double next_occurring_event(double now) override;
+  void update_actions_state(double now, double delta) override;
+};
+
+} // namespace simgrid::kernel::resource
+
+#endif /* SIMGRID_MODEL_CPU_MULTICORE_HPP_ */
@@ -13,6 +13,7 @@
 #include "xbt/asserts.h"
 
 #include <algorithm>
+#include <bit>
 #include <memory>
 
 constexpr double EPSILON = 0.000000001;
@@ -27,30 +28,64 @@ namespace simgrid::kernel::resource {
 
 CpuTiProfile::CpuTiProfile(const profile::Profile* profile)
 {
-  double integral                                = 0;
-  double time                                    = 0;
-  double prev_value                              = 1;
-  const std::vector<profile::DatedValue>& events = profile->get_event_list();
-  xbt_assert(not events.empty());
-  unsigned long nb_points = events.size() + 1;
-  time_points_.reserve(nb_points);
-  integral_.reserve(nb_points);
-  for (auto const& val : events) {
+  double integral   = 0;
+  double time       = 0;
+  double prev_value = 1;
+  double first_date = 0;
+  /* The whole iteration is integrated here, so the events are streamed from the profile rather than kept twice */
+  profile->for_each_event([&](const profile::DatedValue& val) {
+    if (values_.empty())
+      first_date = val.date_;
     time += val.date_;
     integral += val.date_ * prev_value;
     time_points_.push_back(time);
     integral_.push_back(integral);
+    values_.push_back(val.value_);
+    last_date_ = val.date_;
     prev_value = val.value_;
-  }
-
-  double delay = profile->get_repeat_delay() + events.at(0).date_;
+  });
+  xbt_assert(not values_.empty());
+  period_ = time + profile->get_repeat_delay();
 
-  xbt_assert(events.back().value_ == prev_value, "Profiles need to end as they start");
+  double delay = profile->get_repeat_delay() + first_date;
   time += delay;
   integral += delay * prev_value;
 
   time_points_.push_back(time);
   integral_.push_back(integral);
+
+  time_tree_     = CpuTiSearchTree(time_points_);
+  integral_tree_ = CpuTiSearchTree(integral_);
+}
+
+CpuTiSearchTree::CpuTiSearchTree(const std::vector<double>& sorted)
+    : keys_(sorted.size() + 1), ranks_(sorted.size() + 1)
+{
+  size_t next = 0;
+  fill(sorted, next, 1);
+  ranks_[0] = static_cast<long>(sorted.size());
+}
+
+/* In-order traversal of the implicit tree, so that the sorted values are stored in order */
+void CpuTiSearchTree::fill(const std::vector<double>& sorted, size_t& next, size_t k)
+{
+  if (k >= keys_.size())
+    return;
+  fill(sorted, next, 2 * k);
+  keys_[k]  = sorted[next];
+  ranks_[k] = static_cast<long>(next);
+  next++;
+  fill(sorted, next, 2 * k + 1);
+}
+
+long CpuTiSearchTree::search(double a) const
+{
+  /* Go down to a leaf, then climb back to the last node where we went left: it holds the first value larger than a */
+  size_t k = 1;
+  while (k < keys_.size())
+    k = 2 * k + (keys_[k] <= a ? 1 : 0);
+  k >>= std::countr_one(k) + 1;
+  return std::max(ranks_[k] - 1, 0L);
 }
 
 /**
@@ -115,7 +150,7 @@ double CpuTiProfile::integrate_simple_point(double a) const
 {
   double integral = 0;
   double a_aux    = a;
-  long ind        = binary_search(time_points_, a);
+  long ind        = time_tree_.search(a);
   integral += integral_[ind];
 
   XBT_DEBUG("a %f ind %ld integral %f ind + 1 %f ind %f time +1 %f time %f", a, ind, integral, integral_[ind + 1],
@@ -183,6 +218,44 @@ double CpuTiTmgr::solve(double a, double amount) const
   return last_time_ * floor(a / last_time_) + (quotient * last_time_) + reduced_b;
 }
 
+void CpuTiTmgr::solve(double a, std::vector<double>& amounts) const
+{
+  if (type_ == Type::FIXED || amounts.size() < 2) {
+    for (double& amount : amounts)
+      amount = solve(a, amount);
+    return;
+  }
+
+  if ((a < 0.0) && (a > -EPSILON))
+    a = 0.0;
+  xbt_assert(a >= 0.0, "Error, invalid parameter [a = %.2f]. You probably have a task executing with negative "
+             "computation amount. Check your code.", a);
+
+  /* All amounts start from a: reduce it and integrate from it only once */
+  double origin          = last_time_ * floor(a / last_time_);
+  double reduced_a       = a - last_time_ * static_cast<int>(floor(a / last_time_));
+  double amount_till_end = integrate(reduced_a, last_time_);
+  double integral_a      = profile_->integrate_simple_point(reduced_a);
+  double integral_0      = profile_->integrate_simple_point(0.0);
+
+  for (double& amount : amounts) {
+    if ((amount < 0.0) && (amount > -EPSILON))
+      amount = 0.0;
+    xbt_assert(amount >= 0.0, "Error, invalid parameter [amount = %.2f]. You probably have a task executing with "
+               "negative computation amount. Check your code.", amount);
+    if (amount < EPSILON) {
+      amount = a;
+      continue;
+    }
+    double quotient       = floor(amount / total_);
+    double reduced_amount = total_ * ((amount / total_) - floor(amount / total_));
+    double reduced_b      = amount_till_end > reduced_amount
+                                ? profile_->solve_from(integral_a, reduced_amount)
+                                : last_time_ + profile_->solve_from(integral_0, reduced_amount - amount_till_end);
+    amount = origin + (quotient * last_time_) + reduced_b;
+  }
+}
+
 /**
  * @brief Auxiliary function to solve integral.
  *  It returns the date when the requested amount of flops is available
@@ -192,9 +265,14 @@ double CpuTiTmgr::solve(double a, double amount) const
  */
 double CpuTiProfile::solve_simple(double a, double amount) const
 {
-  double integral_a = integrate_simple_point(a);
-  long ind          = binary_search(integral_, integral_a + amount);
-  double time       = time_points_[ind];
+  return solve_from(integrate_simple_point(a), amount);
+}
+
+/** @brief Same as solve_simple(), when the integral at the initial point is already known */
+double CpuTiProfile::solve_from(double integral_a, double amount) const
+{
+  long ind    = integral_tree_.search(integral_a + amount);
+  double time = time_points_[ind];
   time += (integral_a + amount - integral_[ind]) /
           ((integral_[ind + 1] - integral_[ind]) / (time_points_[ind + 1] - time_points_[ind]));
 
@@ -210,10 +288,9 @@ double CpuTiProfile::solve_simple(double a, double amount) const
  */
 double CpuTiTmgr::get_power_scale(double a) const
 {
-  double reduced_a        = a - floor(a / last_time_) * last_time_;
-  long point              = CpuTiProfile::binary_search(profile_->get_time_points(), reduced_a);
-  profile::DatedValue val = speed_profile_->get_event_list().at(point);
-  return val.value_;
+  double reduced_a = a - floor(a / last_time_) * last_time_;
+  long point       = profile_->get_time_index(reduced_a);
+  return profile_->get_value(point);
 }
 
 /**
@@ -223,11 +300,8 @@ double CpuTiTmgr::get_power_scale(double a) const
  * @param  value          Percentage of CPU speed available (useful to fixed tracing)
  * @return  Integration trace structure
  */
-CpuTiTmgr::CpuTiTmgr(kernel::profile::Profile* speed_profile, double value) : speed_profile_(speed_profile)
+CpuTiTmgr::CpuTiTmgr(const kernel::profile::Profile* speed_profile, double value)
 {
-  double total_time = 0.0;
-  profile_.reset(nullptr);
-
   /* no availability file, fixed trace */
   if (not speed_profile) {
     value_ = value;
@@ -236,23 +310,18 @@ CpuTiTmgr::CpuTiTmgr(kernel::profile::Profile* speed_profile, double value) : sp
   }
 
   xbt_assert(speed_profile->is_repeating());
+  auto profile = std::make_unique<CpuTiProfile>(speed_profile);
 
   /* only one point available, fixed trace */
-  if (speed_profile->get_event_list().size() == 1) {
-    value_ = speed_profile->get_event_list().front().value_;
+  if (profile->get_event_count() == 1) {
+    value_ = profile->get_value(0);
     return;
   }
 
-  type_ = Type::DYNAMIC;
-
-  /* count the total time of trace file */
-  for (auto const& val : speed_profile->get_event_list())
-    total_time += val.date_;
-  total_time += speed_profile->get_repeat_delay();
-
-  profile_   = std::make_unique<CpuTiProfile>(speed_profile);
-  last_time_ = total_time;
-  total_     = profile_->integrate_simple(0, total_time);
+  type_      = Type::DYNAMIC;
+  profile_   = std::move(profile);
+  last_time_ = profile_->get_period();
+  total_     = profile_->integrate_simple(0, last_time_);
 
   XBT_DEBUG("Total integral %f, last_time %f ", total_, last_time_);
 }
@@ -289,6 +358,22 @@ CpuImpl* CpuTiModel::create_cpu(s4u::Host* host, const std::vector<double>& spee
   return (new CpuTi(host, speed_per_pstate))->set_model(this);
 }
 
+std::shared_ptr<const CpuTiTmgr> CpuTiModel::get_integrated_profile(profile::Profile* speed_profile, double value)
+{
+  /* Without profile, the trace is fixed and depends on the value */
+  if (speed_profile == nullptr)
+    return std::make_shared<CpuTiTmgr>(speed_profile, value);
+
+  auto& cached = integrated_profiles_[speed_profile];
+  auto res     = cached.lock();
+  if (not res) {
+    XBT_DEBUG("Integrate the speed profile %s", speed_profile->get_name().c_str());
+    res    = std::make_shared<CpuTiTmgr>(speed_profile, value);
+    cached = res;
+  }
+  return res;
+}
+
 double CpuTiModel::next_occurring_event(double now)
 {
   double min_action_duration = -1;
@@ -328,13 +413,12 @@ CpuTi::CpuTi(s4u::Host* host, const std::vector<double>& speed_per_pstate) : Cpu
   speed_.peak = speed_per_pstate.front();
   XBT_DEBUG("CPU create: peak=%f", speed_.peak);
 
-  speed_integrated_trace_ = new CpuTiTmgr(nullptr, 1 /*scale*/);
+  speed_integrated_trace_ = std::make_shared<CpuTiTmgr>(nullptr, 1 /*scale*/);
 }
 
 CpuTi::~CpuTi()
 {
   set_modified(false);
-  delete speed_integrated_trace_;
 }
 
 void CpuTi::turn_off()
@@ -349,16 +433,12 @@ void CpuTi::turn_off()
 
 CpuImpl* CpuTi::set_speed_profile(kernel::profile::Profile* profile)
 {
-  delete speed_integrated_trace_;
-  speed_integrated_trace_ = new CpuTiTmgr(profile, speed_.scale);
+  speed_integrated_trace_ = static_cast<CpuTiModel*>(get_model())->get_integrated_profile(profile, speed_.scale);
 
   /* add a fake trace event if periodicity == 0 */
-  if (profile && profile->get_event_list().size() > 1) {
-    kernel::profile::DatedValue val = profile->get_event_list().back();
-    if (val.date_ < 1e-12) {
-      auto* prof   = profile::ProfileBuilder::from_void();
-      speed_.event = prof->schedule(&profile::future_evt_set, this);
-    }
+  if (speed_integrated_trace_->has_null_last_delay()) {
+    auto* prof   = profile::ProfileBuilder::from_void();
+    speed_.event = prof->schedule(&profile::future_evt_set, this);
   }
   return this;
 }
@@ -373,8 +453,7 @@ void CpuTi::apply_event(kernel::profile::Event* event, double value)
 
     set_modified(true);
 
-    delete speed_integrated_trace_;
-    speed_integrated_trace_ = new CpuTiTmgr(value);
+    speed_integrated_trace_ = std::make_shared<CpuTiTmgr>(value);
 
     speed_.scale = value;
     tmgr_trace_event_unref(&speed_.event);
@@ -430,6 +509,18 @@ void CpuTi::update_actions_finish_time(double now)
     sum_priority_ += 1.0 / action.get_sharing_penalty();
   }
 
+  /* Solve the finish dates of all running actions at once, as they all start from now */
+  finish_dates_.clear();
+  for (CpuTiAction const& action : action_set_) {
+    if (action.get_state_set() == get_model()->get_started_action_set() && action.is_running() &&
+        action.get_sharing_penalty() > 0)
+      /* total area needed to finish the action. Used in trace integration */
+      finish_dates_.push_back((action.get_remains_no_update() * sum_priority_ * action.get_sharing_penalty()) /
+                              speed_.peak);
+  }
+  speed_integrated_trace_->solve(now, finish_dates_);
+
+  auto finish_date = finish_dates_.begin();
   for (CpuTiAction& action : action_set_) {
     double min_finish = NO_MAX_DURATION;
     /* action not running, skip it */
@@ -438,10 +529,7 @@ void CpuTi::update_actions_finish_time(double now)
 
     /* verify if the action is really running on cpu */
     if (action.is_running() && action.get_sharing_penalty() > 0) {
-      /* total area needed to finish the action. Used in trace integration */
-      double total_area = (action.get_remains() * sum_priority_ * action.get_sharing_penalty()) / speed_.peak;
-
-      action.set_finish_time(speed_integrated_trace_->solve(now, total_area));
+      action.set_finish_time(*finish_date++);
       /* verify which event will happen before (max_duration or finish time) */
       if (action.get_max_duration() != NO_MAX_DURATION &&
           action.get_start_time() + action.get_max_duration() < action.get_finish_time())
@@ -12,6 +12,8 @@
 
 #include <boost/intrusive/list.hpp>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace simgrid::kernel::resource {
 
@@ -25,18 +27,48 @@ class XBT_PRIVATE CpuTiAction;
 /***********
  * Profile *
  ***********/
+/** @brief Sorted values laid out in the Eytzinger order, i.e. the breadth-first order of a complete binary tree.
+ *
+ * The first levels of the tree share a few cache lines and the search loop has no branch, so it is faster than
+ * std::upper_bound on the large profiles that are searched each time that the actions of a CPU are updated.
+ */
+class CpuTiSearchTree {
+  std::vector<double> keys_; /*< keys_[k] for k in [1, size]. keys_[0] is unused */
+  std::vector<long> ranks_;  /*< Index of keys_[k] in the sorted array. ranks_[0] is the size */
+
+  void fill(const std::vector<double>& sorted, size_t& next, size_t k);
+
+public:
+  CpuTiSearchTree() = default;
+  explicit CpuTiSearchTree(const std::vector<double>& sorted);
+
+  /** Same result as CpuTiProfile::binary_search() on the sorted array */
+  long search(double a) const;
+};
+
 class CpuTiProfile {
   std::vector<double> time_points_;
   std::vector<double> integral_;
+  std::vector<double> values_; /*< Speed scale of each event, so that the profile is not read again */
+  double last_date_ = 0.0;     /*< Delay between the two last events of the profile */
+  double period_    = 0.0;     /*< Duration of one iteration of the profile */
+  CpuTiSearchTree time_tree_;
+  CpuTiSearchTree integral_tree_;
 
 public:
   explicit CpuTiProfile(const profile::Profile* profile);
 
   const std::vector<double>& get_time_points() const { return time_points_; }
+  size_t get_event_count() const { return values_.size(); }
+  double get_value(long index) const { return values_.at(index); }
+  double get_last_date() const { return last_date_; }
+  double get_period() const { return period_; }
+  long get_time_index(double a) const { return time_tree_.search(a); }
 
   double integrate_simple(double a, double b) const;
   double integrate_simple_point(double a) const;
   double solve_simple(double a, double amount) const;
+  double solve_from(double integral_a, double amount) const;
 
   static long binary_search(const std::vector<double>& array, double a);
 };
@@ -54,17 +86,21 @@ class CpuTiTmgr {
   double total_     = 0.0; /*< Integral total between 0 and last point */
 
   std::unique_ptr<CpuTiProfile> profile_ = nullptr;
-  profile::Profile* speed_profile_       = nullptr;
 
 public:
   explicit CpuTiTmgr(double value) : value_(value){};
-  CpuTiTmgr(profile::Profile* speed_profile, double value);
+  CpuTiTmgr(const profile::Profile* speed_profile, double value);
   CpuTiTmgr(const CpuTiTmgr&)            = delete;
   CpuTiTmgr& operator=(const CpuTiTmgr&) = delete;
 
   double integrate(double a, double b) const;
   double solve(double a, double amount) const;
+  /** Replaces each amount by the date at which it is executed when starting at a, as solve(a, amount) does. The part
+   *  of the computation that only depends on a is done once for all amounts */
+  void solve(double a, std::vector<double>& amounts) const;
   double get_power_scale(double a) const;
+  /** Whether the speed changes, with no delay between the two last events of the profile */
+  bool has_null_last_delay() const { return type_ == Type::DYNAMIC && profile_->get_last_date() < 1e-12; }
 };
 
 /**********
@@ -125,10 +161,12 @@ public:
 
   void set_modified(bool modified);
 
-  CpuTiTmgr* speed_integrated_trace_ = nullptr; /*< Structure with data needed to integrate trace file */
-  ActionTiList action_set_;                     /*< set with all actions running on cpu */
-  double sum_priority_ = 0;                     /*< the sum of actions' priority that are running on cpu */
-  double last_update_  = 0;                     /*< last update of actions' remaining amount done */
+  std::shared_ptr<const CpuTiTmgr> speed_integrated_trace_; /*< Structure with data needed to integrate trace file.
+                                                             *  Shared by all CPUs using the same speed profile */
+  ActionTiList action_set_;  /*< set with all actions running on cpu */
+  double sum_priority_ = 0;  /*< the sum of actions' priority that are running on cpu */
+  double last_update_  = 0;  /*< last update of actions' remaining amount done */
+  std::vector<double> finish_dates_; /*< Scratch space of update_actions_finish_time() */
 
   boost::intrusive::list_member_hook<> cpu_ti_hook;
 };
@@ -151,7 +189,13 @@ public:
   double next_occurring_event(double now) override;
   void update_actions_state(double now, double delta) override;
 
+  /** Returns the integration structure of that speed profile, which is only built once for all the CPUs using it */
+  std::shared_ptr<const CpuTiTmgr> get_integrated_profile(profile::Profile* speed_profile, double value);
+
   CpuTiList modified_cpus_;
+
+private:
+  std::unordered_map<const profile::Profile*, std::weak_ptr<const CpuTiTmgr>> integrated_profiles_;
 };
 
 } // namespace simgrid::kernel::resource
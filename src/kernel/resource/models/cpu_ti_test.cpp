@@ -0,0 +1,57 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/3rd-party/catch.hpp"
+
+#include "simgrid/kernel/ProfileBuilder.hpp"
+#include "src/kernel/resource/models/cpu_ti.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using simgrid::kernel::resource::CpuTiProfile;
+using simgrid::kernel::resource::CpuTiSearchTree;
+using simgrid::kernel::resource::CpuTiTmgr;
+
+TEST_CASE("kernel::resource::CpuTi: Integration of speed profiles", "")
+{
+  SECTION("Eytzinger search")
+  {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> value(0, 50);
+    for (size_t size = 1; size < 70; size++) {
+      std::vector<double> sorted(size);
+      for (auto& v : sorted)
+        v = value(gen); // With duplicates
+      std::sort(sorted.begin(), sorted.end());
+
+      CpuTiSearchTree tree(sorted);
+      for (double a = -1; a <= 51; a += 0.5)
+        REQUIRE(tree.search(a) == CpuTiProfile::binary_search(sorted, a));
+    }
+  }
+
+  SECTION("Batch solver")
+  {
+    auto* profile = simgrid::kernel::profile::ProfileBuilder::from_string("cpu_ti_test", "0 1\n"
+                                                                                         "2 0.5\n"
+                                                                                         "5 0\n"
+                                                                                         "6 0.25\n"
+                                                                                         "9 1\n",
+                                                                          10);
+    CpuTiTmgr trace(profile, 1.0);
+    std::vector<double> amounts{0, 1e-12, 0.3, 1, 2.5, 3, 4.75, 10, 123.4};
+    for (double a : {0.0, 1.5, 4.0, 5.5, 9.0, 10.2, 57.3}) {
+      std::vector<double> dates = amounts;
+      trace.solve(a, dates);
+      for (size_t i = 0; i < amounts.size(); i++) {
+        INFO("a=" << a << " amount=" << amounts[i]);
+        REQUIRE(dates[i] == trace.solve(a, amounts[i]));
+        REQUIRE(dates[i] >= a);
+      }
+    }
+  }
+}
@@ -17,6 +17,7 @@ namespace simgrid::kernel::resource {
 class XBT_PRIVATE HostCLM03Model : public HostModel {
 public:
   using HostModel::HostModel;
+  using HostModel::execute_parallel;
   double next_occurring_event(double now) override;
   void update_actions_state(double now, double delta) override;
   Action* execute_thread(const s4u::Host* host, double flops_amount, int thread_count) override;
@@ -17,16 +17,36 @@
 #include "xbt/config.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(res_network);
 
+/* With crosstraffic, each flow uses this ratio of its rate on the links of the way back for its ACKs */
+static constexpr double ACK_WEIGHT = .05;
+
 /***********
  * Options *
  ***********/
 static simgrid::config::Flag<std::string> cfg_network_solver("network/solver",
                                                              "Set linear equations solver used by network model",
                                                              "maxmin", &simgrid::kernel::lmm::System::validate_solver);
+static simgrid::config::Flag<int> cfg_comm_setup_cache_size(
+    "network/setup-cache-size",
+    "Maximal amount of (source, destination) pairs whose communication setup is memoized (0 to disable)", 65536);
+static simgrid::config::Flag<bool> cfg_flow_aggregation(
+    "network/flow-aggregation",
+    "Whether the identical flows (same route, bound and penalty) share a single variable of the maxmin solver", false);
+static simgrid::config::Flag<bool> cfg_crosstraffic_ack_free(
+    "network/crosstraffic-ack-free",
+    "With crosstraffic, reduce the capacity of the links on the way back instead of sharing them with the ACKs", false);
+static simgrid::config::Flag<double> cfg_tiny_message_threshold(
+    "network/tiny-message-threshold",
+    "Communications smaller than this size (in bytes) complete after an analytic delay, without sharing the links", 0.0);
+static simgrid::config::Flag<bool> cfg_tiny_message_drift(
+    "network/tiny-message-drift",
+    "Share the links with the tiny messages anyway, and report how far their analytic delays would drift", false);
 
 SIMGRID_REGISTER_NETWORK_MODEL(raw,
                                "Simplest network model with `time = size/bw + lat` and fair sharing. "
@@ -157,6 +177,17 @@ NetworkCm02Model::NetworkCm02Model(const std::string& name) : NetworkModel(name)
   }
 
   set_maxmin_system(lmm::System::build(cfg_network_solver.get(), select));
+  // The other solvers do not share the bandwidth as if each aggregated flow was alone
+  aggregate_flows_ = cfg_flow_aggregation && cfg_network_solver.get() == "maxmin";
+
+  if (cfg_tiny_message_drift && cfg_tiny_message_threshold > 0)
+    s4u::Engine::on_simulation_end_cb([this]() {
+      if (tiny_message_count_ > 0)
+        XBT_INFO("%lu tiny messages would have been completed analytically. Their analytic delay drifts from the "
+                 "sharing system by %.2f%% on average, and by %.2f%% at worst.",
+                 tiny_message_count_, 100 * tiny_message_sum_error_ / static_cast<double>(tiny_message_count_),
+                 100 * tiny_message_max_error_);
+    });
 
   loopback_.reset(create_link("__loopback__", {config::get_value<double>("network/loopback-bw")}, nullptr));
   loopback_->set_sharing_policy(s4u::Link::SharingPolicy::FATPIPE, {});
@@ -182,6 +213,63 @@ StandardLinkImpl* NetworkCm02Model::create_wifi_link(const std::string& name, co
   return link;
 }
 
+/* The links of the back route that are not in the route. In ACK-free mode, the ACKs reduce their capacity */
+static std::vector<NetworkCm02Link*> ack_free_links(const std::vector<StandardLinkImpl*>& route,
+                                                    const std::vector<StandardLinkImpl*>& back_route)
+{
+  std::vector<NetworkCm02Link*> res;
+  for (auto* link : back_route)
+    if (link->get_sharing_policy() != s4u::Link::SharingPolicy::WIFI &&
+        std::find(route.begin(), route.end(), link) == route.end())
+      res.push_back(static_cast<NetworkCm02Link*>(link));
+  return res;
+}
+
+double NetworkCm02Model::next_occurring_event(double now)
+{
+  /* In ACK-free mode, the capacity of the links depends on the rates of the flows. Solve once to get these rates, and
+   * solve again with the capacities that they leave, unless no flow is limited by the links whose capacity changed.
+   * The ACK loads due to the second resolution are only applied at the next one: they are a fraction of the changes
+   * of the first one, that already are a fraction of the ACK loads. */
+  if (cfg_crosstraffic_ack_free) {
+    apply_ack_loads();
+    get_maxmin_system()->solve();
+    update_ack_loads();
+    if (apply_ack_loads(true)) {
+      get_maxmin_system()->solve();
+      update_ack_loads();
+    }
+  }
+  return NetworkModel::next_occurring_event(now);
+}
+
+void NetworkCm02Model::update_ack_loads()
+{
+  /* Only the flows of the modified constraints can have a new rate, when the system tracks them */
+  if (auto* modified = get_maxmin_system()->get_modified_action_set())
+    for (Action& action : *modified)
+      static_cast<NetworkCm02Action&>(action).update_ack_rate();
+  else
+    for (Action& action : *get_started_action_set())
+      static_cast<NetworkCm02Action&>(action).update_ack_rate();
+}
+
+bool NetworkCm02Model::apply_ack_loads(bool only_bottlenecks)
+{
+  /* The links that cannot limit any flow keep their bound until the next resolution, so that the current one remains
+   * valid. They stay in the dirty list in the meanwhile */
+  auto kept = std::remove_if(ack_dirty_links_.begin(), ack_dirty_links_.end(), [this, only_bottlenecks](auto* link) {
+    if (only_bottlenecks && not link->is_ack_bottleneck())
+      return false;
+    link->ack_dirty_ = false;
+    get_maxmin_system()->update_constraint_bound(link->get_constraint(), link->get_capacity());
+    return true;
+  });
+  bool applied = kept != ack_dirty_links_.end();
+  ack_dirty_links_.erase(kept, ack_dirty_links_.end());
+  return applied;
+}
+
 void NetworkCm02Model::update_actions_state_lazy(double now, double /*delta*/)
 {
   while (not get_action_heap().empty() && double_equals(get_action_heap().top_date(), now, sg_precision_timing)) {
@@ -283,14 +371,18 @@ void NetworkCm02Model::comm_action_expand_constraints(const s4u::Host* src, cons
     XBT_DEBUG("Crosstraffic active: adding backward flow using 5%% of the available bandwidth");
     if (dst_wifi_link != nullptr)
       get_maxmin_system()->expand(dst_wifi_link->get_constraint(), action->get_variable(),
-                                  .05 / dst_wifi_link->get_host_rate(dst));
+                                  ACK_WEIGHT / dst_wifi_link->get_host_rate(dst));
     if (src_wifi_link != nullptr)
       get_maxmin_system()->expand(src_wifi_link->get_constraint(), action->get_variable(),
-                                  .05 / src_wifi_link->get_host_rate(src));
+                                  ACK_WEIGHT / src_wifi_link->get_host_rate(src));
 
     for (auto const* link : back_route) {
-      if (link->get_sharing_policy() != s4u::Link::SharingPolicy::WIFI)
-        get_maxmin_system()->expand(link->get_constraint(), action->get_variable(), .05);
+      if (link->get_sharing_policy() == s4u::Link::SharingPolicy::WIFI)
+        continue;
+      // In ACK-free mode, only the links of both ways get an element (its weight is increased, not duplicated)
+      if (cfg_crosstraffic_ack_free && std::find(route.begin(), route.end(), link) == route.end())
+        continue;
+      get_maxmin_system()->expand(link->get_constraint(), action->get_variable(), ACK_WEIGHT);
     }
   }
 }
@@ -345,6 +437,134 @@ NetworkCm02Action* NetworkCm02Model::comm_action_create(s4u::Host* src, s4u::Hos
   return action;
 }
 
+/* Minimal bandwidth among the links of the route, ignoring the wi-fi links (-1 if there is none) */
+static double route_bandwidth_bound(const std::vector<StandardLinkImpl*>& route)
+{
+  double bandwidth_bound = -1.0;
+  for (const auto* l : route) {
+    if (l->get_sharing_policy() == s4u::Link::SharingPolicy::WIFI)
+      continue;
+    if (bandwidth_bound == -1.0 || l->get_bandwidth() < bandwidth_bound)
+      bandwidth_bound = l->get_bandwidth();
+  }
+  return bandwidth_bound;
+}
+
+static double route_sharing_penalty(double latency, const std::vector<StandardLinkImpl*>& route)
+{
+  if (NetworkModel::cfg_weight_S_parameter <= 0)
+    return latency;
+  return std::accumulate(route.begin(), route.end(), latency, [](double total, StandardLinkImpl const* link) {
+    return total + NetworkModel::cfg_weight_S_parameter / link->get_bandwidth();
+  });
+}
+
+/* Bandwidth left to a tiny message on its route, considering the current flows as a static load. This is what the
+ * flows leave on the bottleneck link, but at least a fair share with them. Returns -1 if the route contains Wi-Fi links */
+static double tiny_message_bandwidth(const std::vector<StandardLinkImpl*>& route)
+{
+  double bandwidth = std::numeric_limits<double>::infinity();
+  for (const auto* link : route) {
+    if (link->get_sharing_policy() == s4u::Link::SharingPolicy::WIFI)
+      return -1.0;
+    double available = link->get_bandwidth();
+    if (link->get_sharing_policy() != s4u::Link::SharingPolicy::FATPIPE) {
+      const lmm::Constraint* cnst = link->get_constraint();
+      available = std::max(available - cnst->get_load(),
+                           available / static_cast<double>(cnst->enabled_element_set_.size() + 1));
+    }
+    bandwidth = std::min(bandwidth, available);
+  }
+  return bandwidth;
+}
+
+bool NetworkCm02Model::comm_action_complete_analytically(NetworkCm02Action* action, double size,
+                                                         const std::vector<StandardLinkImpl*>& route, bool failed,
+                                                         bool streamed)
+{
+  if (size >= cfg_tiny_message_threshold || failed || streamed)
+    return false;
+
+  double bandwidth = tiny_message_bandwidth(route);
+  if (bandwidth < 0)
+    return false;
+  /* Same bounds as the variable of the action in the sharing system */
+  if (action->get_user_bound() >= 0)
+    bandwidth = std::min(bandwidth, action->get_user_bound());
+  if (action->lat_current_ > 0 && cfg_tcp_gamma > 0)
+    bandwidth = std::min(bandwidth, cfg_tcp_gamma / (2.0 * action->lat_current_));
+  double duration = action->latency_ + size / (bandwidth * action->get_rate_factor());
+  if (duration <= 0 || not std::isfinite(duration))
+    return false;
+
+  if (cfg_tiny_message_drift) {
+    action->set_tiny_message_estimate(duration);
+    return false;
+  }
+  /* The action is a mere delay, like the communications of a route without any link: it completes when its latency is
+   * paid, and its variable uses no constraint */
+  XBT_DEBUG("Tiny message of %g bytes completed analytically in %g seconds", size, duration);
+  action->latency_         = duration;
+  action->sharing_penalty_ = 1.0;
+  comm_action_set_variable(action, {}, {}, false);
+  return true;
+}
+
+void NetworkCm02Model::record_tiny_message_drift(double estimate, double duration)
+{
+  if (duration <= 0)
+    return;
+  double error = std::abs(estimate - duration) / duration;
+  tiny_message_count_++;
+  tiny_message_sum_error_ += error;
+  tiny_message_max_error_ = std::max(tiny_message_max_error_, error);
+}
+
+NetworkCm02Model::CommSetup* NetworkCm02Model::get_comm_setup(const s4u::Host* src, const s4u::Host* dst)
+{
+  /* The callbacks may depend on anything, and get the links and netzones of each communication */
+  if (cfg_comm_setup_cache_size <= 0 || has_network_factor_cb())
+    return nullptr;
+
+  if (unsigned long version = EngineImpl::get_instance()->get_platform_version(); version != comm_setups_version_) {
+    comm_setups_.clear();
+    comm_setups_version_ = version;
+  }
+  if (comm_setups_.size() >= static_cast<size_t>(cfg_comm_setup_cache_size.get())) {
+    XBT_DEBUG("Too many memoized communication setups, forget them all");
+    comm_setups_.clear();
+  }
+
+  auto [it, inserted] = comm_setups_.try_emplace({src->get_netpoint(), dst->get_netpoint()});
+  CommSetup& setup    = it->second;
+  if (inserted) {
+    setup.latency = 0.0;
+    kernel::routing::NetZoneImpl::get_global_route(src->get_netpoint(), dst->get_netpoint(), setup.route,
+                                                   &setup.latency);
+    xbt_assert(not setup.route.empty() || setup.latency > 0,
+               "You're trying to send data from %s to %s but there is no connecting path between these two hosts.",
+               src->get_cname(), dst->get_cname());
+
+    setup.memoizable = std::none_of(setup.route.begin(), setup.route.end(), [](const StandardLinkImpl* link) {
+      return link->get_sharing_policy() == s4u::Link::SharingPolicy::WIFI;
+    });
+    if (not setup.memoizable) {
+      setup.route.clear();
+      return nullptr;
+    }
+    if (cfg_crosstraffic) {
+      dst->route_to(src, setup.back_route, nullptr);
+      if (cfg_crosstraffic_ack_free)
+        setup.ack_links = ack_free_links(setup.route, setup.back_route);
+    }
+    setup.sharing_penalty = route_sharing_penalty(setup.latency, setup.route);
+    setup.bandwidth_bound = route_bandwidth_bound(setup.route);
+    setup.aggregation_key = next_aggregation_key_++;
+    XBT_DEBUG("Memoize the setup of the communications from %s to %s", src->get_cname(), dst->get_cname());
+  }
+  return setup.memoizable ? &setup : nullptr;
+}
+
 bool NetworkCm02Model::comm_get_route_info(const s4u::Host* src, const s4u::Host* dst, double& latency,
                                            std::vector<StandardLinkImpl*>& route,
                                            std::vector<StandardLinkImpl*>& back_route,
@@ -386,17 +606,17 @@ void NetworkCm02Model::comm_action_set_bounds(const s4u::Host* src, const s4u::H
   double bw_factor = get_bandwidth_factor(size, src, dst, s4u_route, s4u_netzones);
   xbt_assert(bw_factor != 0, "Invalid param for comm %s -> %s. Bandwidth factor cannot be 0", src->get_cname(),
              dst->get_cname());
-  action->set_rate_factor(bw_factor);
 
   /* get mininum bandwidth among links in the route and multiply by correct factor
    * ignore wi-fi links, they're not considered for bw_factors */
-  double bandwidth_bound = -1.0;
-  for (const auto* l : route) {
-    if (l->get_sharing_policy() == s4u::Link::SharingPolicy::WIFI)
-      continue;
-    if (bandwidth_bound == -1.0 || l->get_bandwidth() < bandwidth_bound)
-      bandwidth_bound = l->get_bandwidth();
-  }
+  comm_action_apply_bounds(action, bw_factor, get_latency_factor(size, src, dst, s4u_route, s4u_netzones),
+                           route_bandwidth_bound(route), rate);
+}
+
+void NetworkCm02Model::comm_action_apply_bounds(NetworkCm02Action* action, double bw_factor, double lat_factor,
+                                                double bandwidth_bound, double rate) const
+{
+  action->set_rate_factor(bw_factor);
 
   /* increase rate given by user considering the factor, since the actual rate will be
    * modified by it */
@@ -407,11 +627,20 @@ void NetworkCm02Model::comm_action_set_bounds(const s4u::Host* src, const s4u::H
   action->set_user_bound(bandwidth_bound);
 
   action->lat_current_ = action->latency_;
-  action->latency_ *= get_latency_factor(size, src, dst, s4u_route, s4u_netzones);
+  action->latency_ *= lat_factor;
+}
+
+void NetworkCm02Model::comm_action_set_ack_links(NetworkCm02Action* action,
+                                                 const std::vector<NetworkCm02Link*>& ack_links) const
+{
+  action->ack_links_ = ack_links;
+  for (auto* link : ack_links)
+    link->ack_flows_++;
 }
 
-void NetworkCm02Model::comm_action_set_variable(NetworkCm02Action* action, const std::vector<StandardLinkImpl*>& route,
-                                                const std::vector<StandardLinkImpl*>& back_route, bool streamed)
+bool NetworkCm02Model::comm_action_set_variable(NetworkCm02Action* action, const std::vector<StandardLinkImpl*>& route,
+                                                const std::vector<StandardLinkImpl*>& back_route, bool streamed,
+                                                unsigned long aggregation_key)
 {
   size_t constraints_per_variable = route.size();
   constraints_per_variable += back_route.size();
@@ -422,63 +651,105 @@ void NetworkCm02Model::comm_action_set_variable(NetworkCm02Action* action, const
     constraints_per_variable += 4;
   }
 
-  if (action->latency_ > 0) {
-    action->set_variable(get_maxmin_system()->variable_new(action, 0.0, -1.0, constraints_per_variable));
-    if (is_update_lazy()) {
-      // add to the heap the event when the latency is paid
-      double date = action->latency_ + action->get_last_update();
+  /* the bounds depend on user configuration */
+  double bound;
+  if (action->get_user_bound() < 0) {
+    bound = (action->lat_current_ > 0 && cfg_tcp_gamma > 0) ? cfg_tcp_gamma / (2.0 * action->lat_current_) : -1.0;
+  } else {
+    bound = (action->lat_current_ > 0 && cfg_tcp_gamma > 0)
+                ? std::min(action->get_user_bound(), cfg_tcp_gamma / (2.0 * action->lat_current_))
+                : action->get_user_bound();
+  }
+  double penalty = action->latency_ > 0 ? 0.0 : 1.0;
 
-      ActionHeap::Type type = route.empty() ? ActionHeap::Type::normal : ActionHeap::Type::latency;
+  lmm::Variable* var = nullptr;
+  if (aggregation_key != 0)
+    var = get_maxmin_system()->variable_new_aggregated(action, aggregation_key, penalty, bound);
+  bool aggregated = var != nullptr;
+  if (not aggregated)
+    var = get_maxmin_system()->variable_new(action, penalty, bound, constraints_per_variable);
+  action->set_variable(var);
 
-      XBT_DEBUG("Added action (%p) one latency event at date %f", action, date);
-      get_action_heap().insert(action, date, type);
-    }
-  } else
-    action->set_variable(get_maxmin_system()->variable_new(action, 1.0, -1.0, constraints_per_variable));
+  if (action->latency_ > 0 && is_update_lazy()) {
+    // add to the heap the event when the latency is paid
+    double date = action->latency_ + action->get_last_update();
 
-  /* after setting the variable, update the bounds depending on user configuration */
-  if (action->get_user_bound() < 0) {
-    get_maxmin_system()->update_variable_bound(
-        action->get_variable(),
-        (action->lat_current_ > 0 && cfg_tcp_gamma > 0) ? cfg_tcp_gamma / (2.0 * action->lat_current_) : -1.0);
-  } else {
-    get_maxmin_system()->update_variable_bound(
-        action->get_variable(), (action->lat_current_ > 0 && cfg_tcp_gamma > 0)
-                                    ? std::min(action->get_user_bound(), cfg_tcp_gamma / (2.0 * action->lat_current_))
-                                    : action->get_user_bound());
+    ActionHeap::Type type = route.empty() ? ActionHeap::Type::normal : ActionHeap::Type::latency;
+
+    XBT_DEBUG("Added action (%p) one latency event at date %f", action, date);
+    get_action_heap().insert(action, date, type);
   }
+  return aggregated;
 }
 
 Action* NetworkCm02Model::communicate(s4u::Host* src, s4u::Host* dst, double size, double rate, bool streamed)
 {
+  XBT_IN("(%s,%s,%g,%g)", src->get_cname(), dst->get_cname(), size, rate);
+
+  if (CommSetup* setup = get_comm_setup(src, dst)) {
+    /* Memoized setup: only check the state of the links, and get the factors again if the size changed */
+    static const std::vector<StandardLinkImpl*> no_back_route;
+    auto is_off = [](const StandardLinkImpl* link) { return not link->is_on(); };
+    bool failed = std::any_of(setup->route.begin(), setup->route.end(), is_off) ||
+                  std::any_of(setup->back_route.begin(), setup->back_route.end(), is_off);
+    const auto& back_route = failed ? no_back_route : setup->back_route;
+
+    if (size != setup->last_size) {
+      setup->lat_factor = get_latency_factor(size, src, dst, {}, {});
+      setup->bw_factor  = get_bandwidth_factor(size, src, dst, {}, {});
+      xbt_assert(setup->bw_factor != 0, "Invalid param for comm %s -> %s. Bandwidth factor cannot be 0",
+                 src->get_cname(), dst->get_cname());
+      setup->last_size = size;
+    }
+
+    auto* action = new NetworkCm02Action(this, *src, *dst, size, failed);
+    if (is_update_lazy())
+      action->set_last_update();
+    action->sharing_penalty_ = setup->sharing_penalty;
+    action->latency_         = setup->latency;
+    comm_action_apply_bounds(action, setup->bw_factor, setup->lat_factor, setup->bandwidth_bound, rate);
+    if (comm_action_complete_analytically(action, size, setup->route, failed, streamed)) {
+      XBT_OUT();
+      return action;
+    }
+    /* The streamed communications get the constraints of the disks afterward, and cannot be aggregated */
+    unsigned long aggregation_key = (aggregate_flows_ && not failed && not streamed) ? setup->aggregation_key : 0;
+    if (not comm_action_set_variable(action, setup->route, back_route, streamed, aggregation_key)) {
+      comm_action_expand_constraints(src, dst, action, setup->route, back_route);
+      if (aggregation_key != 0)
+        get_maxmin_system()->set_aggregation_key(action->get_variable(), aggregation_key);
+    }
+    if (not failed && not setup->ack_links.empty())
+      comm_action_set_ack_links(action, setup->ack_links);
+    XBT_OUT();
+    return action;
+  }
+
   double latency = 0.0;
   std::vector<StandardLinkImpl*> back_route;
   std::vector<StandardLinkImpl*> route;
   std::unordered_set<kernel::routing::NetZoneImpl*> netzones;
 
-  XBT_IN("(%s,%s,%g,%g)", src->get_cname(), dst->get_cname(), size, rate);
-
   bool failed = comm_get_route_info(src, dst, latency, route, back_route, netzones);
 
   NetworkCm02Action* action = comm_action_create(src, dst, size, route, failed);
-  action->sharing_penalty_  = latency;
+  action->sharing_penalty_  = route_sharing_penalty(latency, route);
   action->latency_          = latency;
 
-  if (cfg_weight_S_parameter > 0) {
-    action->sharing_penalty_ = std::accumulate(route.begin(), route.end(), action->sharing_penalty_,
-                                               [](double total, StandardLinkImpl const* link) {
-                                                 return total + cfg_weight_S_parameter / link->get_bandwidth();
-                                               });
-  }
-
   /* setting bandwidth and latency bounds considering route and configured bw/lat factors */
   comm_action_set_bounds(src, dst, size, action, route, netzones, rate);
+  if (comm_action_complete_analytically(action, size, route, failed, streamed)) {
+    XBT_OUT();
+    return action;
+  }
 
   /* creating the maxmin variable associated to this action */
   comm_action_set_variable(action, route, back_route, streamed);
 
   /* expand maxmin system to consider this communication in bw constraint for each link in route and back_route */
   comm_action_expand_constraints(src, dst, action, route, back_route);
+  if (cfg_crosstraffic_ack_free && not failed)
+    comm_action_set_ack_links(action, ack_free_links(route, back_route));
   XBT_OUT();
 
   return action;
@@ -521,16 +792,49 @@ void NetworkCm02Link::apply_event(kernel::profile::Event* triggered, double valu
             get_constraint());
 }
 
+double NetworkCm02Link::get_capacity() const
+{
+  double bandwidth = bandwidth_.peak * bandwidth_.scale;
+  // The ACKs never take more than half of the link, as they would be slowed down too if they were shared
+  return bandwidth - std::clamp(ack_load_, 0.0, bandwidth / 2);
+}
+
+bool NetworkCm02Link::is_ack_bottleneck() const
+{
+  // A link that is not saturated, before and after the change of its capacity, does not change the sharing
+  double capacity = std::min(get_constraint()->bound_, get_capacity());
+  return not double_positive(capacity - get_constraint()->get_load(), capacity * sg_precision_workamount);
+}
+
+void NetworkCm02Link::add_ack_load(double load)
+{
+  ack_load_ += load;
+  if (not ack_dirty_) {
+    ack_dirty_ = true;
+    static_cast<NetworkCm02Model*>(get_model())->mark_ack_dirty(this);
+  }
+}
+
+void NetworkCm02Link::remove_ack_flow(double load)
+{
+  ack_flows_--;
+  add_ack_load(-load);
+  if (ack_flows_ == 0) // Do not let the rounding errors pile up
+    ack_load_ = 0.0;
+}
+
 void NetworkCm02Link::set_bandwidth(double value)
 {
   double old_peak = bandwidth_.peak;
   bandwidth_.peak = value;
+  static_cast<NetworkCm02Model*>(get_model())->invalidate_comm_setups();
 
-  get_model()->get_maxmin_system()->update_constraint_bound(get_constraint(), (bandwidth_.peak * bandwidth_.scale));
+  get_model()->get_maxmin_system()->update_constraint_bound(get_constraint(), get_capacity());
 
   StandardLinkImpl::on_bandwidth_change();
 
   if (NetworkModel::cfg_weight_S_parameter > 0) {
+    get_model()->get_maxmin_system()->disable_aggregation(get_constraint());
     double delta = NetworkModel::cfg_weight_S_parameter / (bandwidth_.peak * bandwidth_.scale) -
                    NetworkModel::cfg_weight_S_parameter / (old_peak * bandwidth_.scale);
 
@@ -557,6 +861,8 @@ void NetworkCm02Link::set_latency(double value)
 
   latency_.scale = 1.0;
   latency_.peak  = value;
+  static_cast<NetworkCm02Model*>(get_model())->invalidate_comm_setups();
+  get_model()->get_maxmin_system()->disable_aggregation(get_constraint());
 
   while (const auto* var = get_constraint()->get_variable_safe(&elem, &nextelem, &numelem)) {
     auto* action = static_cast<NetworkCm02Action*>(var->get_id());
@@ -586,6 +892,33 @@ void NetworkCm02Link::set_latency(double value)
  * Action *
  **********/
 
+NetworkCm02Action::~NetworkCm02Action()
+{
+  if (tiny_message_estimate_ >= 0 && get_state() == Action::State::FINISHED)
+    static_cast<NetworkCm02Model*>(get_model())
+        ->record_tiny_message_drift(tiny_message_estimate_, get_finish_time() - get_start_time());
+  for (auto* link : ack_links_)
+    link->remove_ack_flow(ACK_WEIGHT * ack_rate_);
+}
+
+void NetworkCm02Action::update_ack_rate()
+{
+  if (ack_links_.empty())
+    return;
+  double rate = get_variable()->get_value();
+  if (rate == ack_rate_)
+    return;
+  for (auto* link : ack_links_)
+    link->add_ack_load(ACK_WEIGHT * (rate - ack_rate_));
+  ack_rate_ = rate;
+}
+
+void NetworkCm02Action::suspend()
+{
+  NetworkAction::suspend();
+  update_ack_rate(); // The flow is not in the modified set of the next resolution, as its variable got disabled
+}
+
 void NetworkCm02Action::update_remains_lazy(double now)
 {
   if (not is_running())
@@ -18,6 +18,7 @@
 namespace simgrid::kernel::resource {
 
 class XBT_PRIVATE NetworkCm02Model;
+class XBT_PRIVATE NetworkCm02Link;
 class XBT_PRIVATE NetworkCm02Action;
 class XBT_PRIVATE NetworkSmpiModel;
 
@@ -26,6 +27,41 @@ class XBT_PRIVATE NetworkSmpiModel;
  *********/
 
 class NetworkCm02Model : public NetworkModel {
+  /** @brief What communicate() derives from the route between two hosts, whatever the message */
+  struct CommSetup {
+    std::vector<StandardLinkImpl*> route;
+    std::vector<StandardLinkImpl*> back_route; // Only with crosstraffic
+    std::vector<NetworkCm02Link*> ack_links;   // Back route links not in the route (network/crosstraffic-ack-free)
+    double latency;
+    double sharing_penalty;
+    double bandwidth_bound;
+    bool memoizable; // Wi-Fi routes depend on the host rates, and are not memoized
+    /* The factors only depend on the size of the message (they are piecewise constant). Remember the last ones. */
+    double last_size = -1.0;
+    double lat_factor;
+    double bw_factor;
+    unsigned long aggregation_key; // Identifies the route in the LMM system, to aggregate the identical flows
+  };
+  struct CommSetupHash {
+    size_t operator()(const std::pair<const routing::NetPoint*, const routing::NetPoint*>& key) const
+    {
+      return std::hash<const void*>()(key.first) ^ (std::hash<const void*>()(key.second) << 1);
+    }
+  };
+  std::unordered_map<std::pair<const routing::NetPoint*, const routing::NetPoint*>, CommSetup, CommSetupHash>
+      comm_setups_;
+  unsigned long comm_setups_version_ = 0; // Platform version of the memoized setups
+  unsigned long next_aggregation_key_ = 1; // Never reused, even when the setups are forgotten
+  bool aggregate_flows_;
+  /* How far the analytic delays of the tiny messages drift from the sharing system (network/tiny-message-drift) */
+  unsigned long tiny_message_count_ = 0;
+  double tiny_message_sum_error_    = 0.0;
+  double tiny_message_max_error_    = 0.0;
+  /* Links whose ACK load changed since their bound was last updated (network/crosstraffic-ack-free) */
+  std::vector<NetworkCm02Link*> ack_dirty_links_;
+
+  /** @brief Get the memoized setup of the communications from src to dst, or nullptr if it cannot be memoized */
+  CommSetup* get_comm_setup(const s4u::Host* src, const s4u::Host* dst);
   /** @brief Get route information (2-way) */
   bool comm_get_route_info(const s4u::Host* src, const s4u::Host* dst, /* OUT */ double& latency,
                            std::vector<StandardLinkImpl*>& route, std::vector<StandardLinkImpl*>& back_route,
@@ -41,9 +77,24 @@ class NetworkCm02Model : public NetworkModel {
   void comm_action_set_bounds(const s4u::Host* src, const s4u::Host* dst, double size, NetworkCm02Action* action,
                               const std::vector<StandardLinkImpl*>& route,
                               const std::unordered_set<kernel::routing::NetZoneImpl*>& netzones, double rate) const;
-  /** @brief Create maxmin variable in communication action */
-  void comm_action_set_variable(NetworkCm02Action* action, const std::vector<StandardLinkImpl*>& route,
-                                const std::vector<StandardLinkImpl*>& back_route, bool streamed);
+  void comm_action_apply_bounds(NetworkCm02Action* action, double bw_factor, double lat_factor, double bandwidth_bound,
+                                double rate) const;
+  /** @brief Complete a tiny message after an analytic delay, without the sharing system.
+   *  @return whether the action was completed that way */
+  bool comm_action_complete_analytically(NetworkCm02Action* action, double size,
+                                         const std::vector<StandardLinkImpl*>& route, bool failed, bool streamed);
+  /** @brief Create maxmin variable in communication action, aggregated with identical ones if a key is given.
+   *  @return whether the variable was aggregated (then its constraints must not be expanded) */
+  bool comm_action_set_variable(NetworkCm02Action* action, const std::vector<StandardLinkImpl*>& route,
+                                const std::vector<StandardLinkImpl*>& back_route, bool streamed,
+                                unsigned long aggregation_key = 0);
+  /** @brief Charge the ACKs of that communication to the links of the back route that are not in its route */
+  void comm_action_set_ack_links(NetworkCm02Action* action, const std::vector<NetworkCm02Link*>& ack_links) const;
+  /** @brief Update the ACK loads of the links from the new rates of the communications */
+  void update_ack_loads();
+  /** @brief Reduce the capacity of the links whose ACK load changed. @return whether any capacity was reduced
+   *  @param only_bottlenecks whether to leave the links that cannot limit any flow to the next resolution */
+  bool apply_ack_loads(bool only_bottlenecks = false);
 
 public:
   explicit NetworkCm02Model(const std::string& name);
@@ -51,9 +102,16 @@ public:
                                 routing::NetZoneImpl* englobing_zone) final;
   StandardLinkImpl* create_wifi_link(const std::string& name, const std::vector<double>& bandwidths,
                                      routing::NetZoneImpl* englobing_zone) override;
+  double next_occurring_event(double now) override;
   void update_actions_state_lazy(double now, double delta) override;
   void update_actions_state_full(double now, double delta) override;
   Action* communicate(s4u::Host* src, s4u::Host* dst, double size, double rate, bool streamed) override;
+  /** @brief Forget the memoized communication setups, when the bandwidth or latency of a link changes */
+  void invalidate_comm_setups() { comm_setups_.clear(); }
+  /** @brief Compare the actual duration of a tiny message with its analytic estimate */
+  void record_tiny_message_drift(double estimate, double duration);
+  /** @brief Update the bound of that link before the next resolution, as its ACK load changed */
+  void mark_ack_dirty(NetworkCm02Link* link) { ack_dirty_links_.push_back(link); }
 };
 
 /************
@@ -61,12 +119,28 @@ public:
  ************/
 
 class NetworkCm02Link : public StandardLinkImpl {
+  friend NetworkCm02Model;
+  /* With network/crosstraffic-ack-free, the ACKs crossing this link reduce its capacity instead of being shared */
+  double ack_load_        = 0.0;
+  unsigned long ack_flows_ = 0;
+  bool ack_dirty_         = false;
+
+  /** @brief The bandwidth left to the flows once the ACKs are served */
+  double get_capacity() const;
+  /** @brief Whether the flows would be limited by this link, if its capacity were updated after the last resolution */
+  bool is_ack_bottleneck() const;
+
 public:
   NetworkCm02Link(const std::string& name, double bandwidth, lmm::System* system,
                   s4u::Link::SharingPolicy sharing_policy, routing::NetZoneImpl* englobing_zone);
   void apply_event(kernel::profile::Event* event, double value) override;
   void set_bandwidth(double value) override;
   void set_latency(double value) override;
+
+  /** @brief Account for a change of the rate of a flow whose ACKs cross this link */
+  void add_ack_load(double load);
+  /** @brief Forget the ACKs of a flow that ended, whose rate was last accounted with add_ack_load() */
+  void remove_ack_flow(double load);
 };
 
 /**********
@@ -75,9 +149,21 @@ public:
 class NetworkCm02Action : public NetworkAction {
   friend Action* NetworkCm02Model::communicate(s4u::Host* src, s4u::Host* dst, double size, double rate, bool streamed);
 
+  friend NetworkCm02Model;
+
+  double tiny_message_estimate_ = -1.0; // Analytic duration of a tiny message, checked at completion
+  std::vector<NetworkCm02Link*> ack_links_; // Links whose capacity is reduced by the ACKs of this flow
+  double ack_rate_ = 0.0;                   // Rate of the flow when its ACKs were last accounted
+
+  /** @brief Update the ACK load of the links if the rate of this flow changed */
+  void update_ack_rate();
+
 public:
   using NetworkAction::NetworkAction;
+  ~NetworkCm02Action() override;
+  void suspend() override;
   void update_remains_lazy(double now) override;
+  void set_tiny_message_estimate(double duration) { tiny_message_estimate_ = duration; }
 };
 } // namespace simgrid::kernel::resource
 #endif /* SIMGRID_MODEL_NETWORK_CM02_HPP_ */
@@ -153,24 +153,31 @@ void NetworkIBModel::compute_IB_factors(IBNode* root) const
   XBT_DEBUG("Finished computing IB penalties");
 }
 
-void NetworkIBModel::update_IB_factors_rec(IBNode* root, std::vector<bool>& updatedlist) const
+void NetworkIBModel::mark_dirty(IBNode* node)
 {
-  if (not updatedlist[root->id_]) {
-    XBT_DEBUG("IB - Updating rec %d", root->id_);
-    compute_IB_factors(root);
-    updatedlist[root->id_] = true;
-    for (ActiveComm const* comm : root->active_comms_up_) {
-      if (not updatedlist[comm->destination->id_])
-        update_IB_factors_rec(comm->destination, updatedlist);
-    }
-    for (auto const& [comm, _] : root->active_comms_down_) {
-      if (not updatedlist[comm->id_])
-        update_IB_factors_rec(comm, updatedlist);
-    }
+  if (not node->dirty_) {
+    node->dirty_ = true;
+    dirty_nodes_.push_back(node);
   }
 }
 
-void NetworkIBModel::update_IB_factors(NetworkAction* action, IBNode* from, IBNode* to, bool remove) const
+void NetworkIBModel::flush_IB_factors()
+{
+  for (IBNode* node : dirty_nodes_) {
+    XBT_DEBUG("IB - Updating %d", node->id_);
+    compute_IB_factors(node);
+    node->dirty_ = false;
+  }
+  dirty_nodes_.clear();
+}
+
+double NetworkIBModel::next_occurring_event(double now)
+{
+  flush_IB_factors();
+  return NetworkCm02Model::next_occurring_event(now);
+}
+
+void NetworkIBModel::update_IB_factors(NetworkAction* action, IBNode* from, IBNode* to, bool remove)
 {
   if (from == to) // disregard local comms (should use loopback)
     return;
@@ -199,9 +206,12 @@ void NetworkIBModel::update_IB_factors(NetworkAction* action, IBNode* from, IBNo
     to->active_comms_down_[from] += 1;
     to->nb_active_comms_down_++;
   }
-  XBT_DEBUG("IB - Updating %d", from->id_);
-  std::vector<bool> updated(active_nodes.size(), false);
-  update_IB_factors_rec(from, updated);
-  XBT_DEBUG("IB - Finished updating %d", from->id_);
+  /* The penalties of a comm only depend on the amount of comms sent by its source, and on the comms received by its
+   * destination. So this change only affects the comms sent by `from` (whose out-degree changed) and by the nodes
+   * sending to `to` (whose in-degree changed). They are recomputed once before the next solve, however many comms
+   * start or end in between. */
+  mark_dirty(from);
+  for (auto const& [sender, _] : to->active_comms_down_)
+    mark_dirty(sender);
 }
 } // namespace simgrid::kernel::resource
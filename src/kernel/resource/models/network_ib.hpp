@@ -30,6 +30,8 @@ public:
   std::map<IBNode*, int> active_comms_down_;
   // number of comms the node is receiving
   int nb_active_comms_down_ = 0;
+  // whether the penalties of the comms sent by this node must be recomputed before the next solve
+  bool dirty_ = false;
   explicit IBNode(int id) : id_(id){};
 };
 
@@ -37,17 +39,23 @@ class XBT_PRIVATE NetworkIBModel : public NetworkCm02Model {
   std::unordered_map<std::string, IBNode> active_nodes;
   std::unordered_map<NetworkAction*, std::pair<IBNode*, IBNode*>> active_comms;
 
+  // the nodes whose outgoing comms need new penalties, computed once per scheduling round
+  std::vector<IBNode*> dirty_nodes_;
+
   double Bs_;
   double Be_;
   double ys_;
-  void update_IB_factors_rec(IBNode* root, std::vector<bool>& updatedlist) const;
+  void mark_dirty(IBNode* node);
   void compute_IB_factors(IBNode* root) const;
 
 public:
   explicit NetworkIBModel(const std::string& name);
   NetworkIBModel(const NetworkIBModel&)            = delete;
   NetworkIBModel& operator=(const NetworkIBModel&) = delete;
-  void update_IB_factors(NetworkAction* action, IBNode* from, IBNode* to, bool remove) const;
+  void update_IB_factors(NetworkAction* action, IBNode* from, IBNode* to, bool remove);
+  /** Recomputes the penalties of the comms sent by the nodes that were marked since the last call */
+  void flush_IB_factors();
+  double next_occurring_event(double now) override;
 
   static void IB_create_host_callback(s4u::Host const& host);
   static void IB_action_state_changed_callback(NetworkAction& action, Action::State /*previous*/);
@@ -0,0 +1,377 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <simgrid/kernel/routing/NetZoneImpl.hpp>
+#include <simgrid/plugins/energy.h>
+#include <simgrid/s4u/Engine.hpp>
+
+#include "src/instr/instr_private.hpp" // TRACE_is_enabled(). FIXME: remove by subscribing tracing to the signals
+#include "src/kernel/EngineImpl.hpp"
+#include "src/kernel/resource/models/network_packet.hpp"
+#include "src/kernel/resource/profile/Event.hpp"
+#include "src/simgrid/module.hpp"
+
+#include <algorithm>
+#include <limits>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(res_packet, res_network, "Packet-level network model");
+
+/*********
+ * Model *
+ *********/
+SIMGRID_REGISTER_NETWORK_MODEL(
+    Packet,
+    "Packet-level network model, with store-and-forward queues on the links and TCP-like windows. It is much slower "
+    "than the fluid models, but much faster than ns-3: use it to validate the fluid models on mid-size platforms.",
+    []() {
+      auto net_model = std::make_shared<simgrid::kernel::resource::NetworkPacketModel>("Network_Packet");
+      auto* engine   = simgrid::kernel::EngineImpl::get_instance();
+      engine->add_model(net_model);
+      engine->get_netzone_root()->set_network_model(net_model);
+    });
+
+namespace simgrid::kernel::resource {
+
+config::Flag<double> NetworkPacketModel::cfg_packet_size(
+    "network/packet-size",
+    "Size of the packets of the Packet network model, in bytes. Larger values turn them into flowlets, which is faster "
+    "but coarser",
+    1500.0, [](double val) { xbt_assert(val > 0, "The packet size must be positive, not %g", val); });
+config::Flag<int> NetworkPacketModel::cfg_initial_window(
+    "network/packet-initial-window", "Initial window of the flows of the Packet network model, in packets", 10,
+    [](int val) { xbt_assert(val > 0, "The initial window must be positive, not %d", val); });
+config::Flag<double> NetworkPacketModel::cfg_queue_size(
+    "network/packet-queue-size",
+    "Amount of queued packets beyond which the links of the Packet network model signal their congestion", 100.0);
+
+NetworkPacketModel::NetworkPacketModel(const std::string& name) : NetworkModel(name)
+{
+  xbt_assert(not sg_link_energy_is_inited(),
+             "LinkEnergy plugin and the Packet network model are not compatible: the links have no sharing system.");
+
+  loopback_.reset(create_link("__loopback__", {config::get_value<double>("network/loopback-bw")}, nullptr));
+  loopback_->set_sharing_policy(s4u::Link::SharingPolicy::FATPIPE, {});
+  loopback_->set_latency(config::get_value<double>("network/loopback-lat"));
+  loopback_->get_iface()->seal();
+}
+
+StandardLinkImpl* NetworkPacketModel::create_link(const std::string& name, const std::vector<double>& bandwidths,
+                                                  routing::NetZoneImpl* englobing_zone)
+{
+  xbt_assert(bandwidths.size() == 1, "Non-WIFI links must use only 1 bandwidth.");
+  auto* link = new LinkPacket(name, bandwidths[0], englobing_zone);
+  link->set_model(this);
+  return link;
+}
+
+StandardLinkImpl* NetworkPacketModel::create_wifi_link(const std::string& name, const std::vector<double>& /*bws*/,
+                                                       routing::NetZoneImpl*)
+{
+  xbt_die("Refusing to create the WiFi link %s: the Packet network model does not support WiFi.", name.c_str());
+}
+
+Action* NetworkPacketModel::communicate(s4u::Host* src, s4u::Host* dst, double size, double rate, bool /*streamed*/)
+{
+  std::vector<StandardLinkImpl*> route;
+  double latency = 0.0;
+  src->route_to(dst, route, &latency);
+  bool failed = std::any_of(route.begin(), route.end(), [](const StandardLinkImpl* link) { return not link->is_on(); });
+
+  auto* action = new NetworkPacketAction(this, *src, *dst, size, failed);
+  if (failed)
+    return action;
+
+  for (auto* link : route) {
+    auto* packet_link = static_cast<LinkPacket*>(link);
+    packet_link->users_++;
+    action->route_.push_back(packet_link);
+  }
+
+  // The heap was left behind when no communication was running
+  clock_ = std::max(clock_, EngineImpl::get_clock());
+
+  unsigned long flow_id = next_flow_id_++;
+  action->flow_id_      = flow_id;
+  Flow& flow            = flows_[flow_id];
+  flow.action           = action;
+  flow.ack_delay        = latency;
+  flow.size             = size;
+  flow.rate             = rate;
+  flow.window           = cfg_initial_window * cfg_packet_size;
+  flow.threshold        = cfg_tcp_gamma > 0 ? cfg_tcp_gamma.get() : std::numeric_limits<double>::infinity();
+  XBT_DEBUG("Flow #%lu of %g bytes from %s to %s, over %zu links", flow_id, size, src->get_cname(), dst->get_cname(),
+            route.size());
+
+  if (size > 0)
+    send_packets(flow_id, flow);
+  else // An empty packet, that only pays the latency
+    schedule(clock_, Event::Type::HOP, flow_id);
+  return action;
+}
+
+void NetworkPacketModel::schedule(double date, Event::Type type, unsigned long flow_id, size_t hop, double bytes,
+                                  double end, bool marked)
+{
+  events_.push(Event{date, next_event_++, type, flow_id, hop, bytes, end, marked});
+}
+
+void NetworkPacketModel::send_packets(unsigned long flow_id, Flow& flow)
+{
+  if (flow.action->is_suspended())
+    return;
+
+  while (flow.sent < flow.size && flow.sent - flow.acked < flow.window) {
+    if (flow.rate > 0 && flow.next_send > clock_) {
+      if (not flow.send_pending)
+        schedule(flow.next_send, Event::Type::SEND, flow_id);
+      flow.send_pending = true;
+      return;
+    }
+    double bytes = std::min(cfg_packet_size.get(), flow.size - flow.sent);
+    flow.sent += bytes;
+    if (flow.rate > 0)
+      flow.next_send = clock_ + bytes / flow.rate;
+    schedule(clock_, Event::Type::HOP, flow_id, 0, bytes, flow.sent);
+  }
+}
+
+void NetworkPacketModel::process(const Event& event)
+{
+  auto it = flows_.find(event.flow);
+  if (it == flows_.end()) // The communication is over, or was canceled
+    return;
+  Flow& flow = it->second;
+  if (flow.action->get_state() != Action::State::STARTED) {
+    forget_flow(event.flow);
+    return;
+  }
+  const auto& route = flow.action->route_;
+
+  switch (event.type) {
+    case Event::Type::HOP:
+      if (event.hop < route.size()) { // Store the packet in the queue of the next link, and forward it
+        LinkPacket* link = route[event.hop];
+        double duration  = event.bytes / link->get_bandwidth();
+        double start     = clock_;
+        bool marked      = event.marked;
+        if (link->get_sharing_policy() != s4u::Link::SharingPolicy::FATPIPE) {
+          start = std::max(clock_, link->busy_until_);
+          marked |= (start - clock_) * link->get_bandwidth() > cfg_queue_size * cfg_packet_size;
+          link->busy_until_ = start + duration;
+        }
+        schedule(start + duration + link->get_latency(), Event::Type::HOP, event.flow, event.hop + 1, event.bytes,
+                 event.end, marked);
+
+      } else { // The packet reached the destination
+        flow.delivered += event.bytes;
+        if (flow.delivered >= flow.size) {
+          XBT_DEBUG("Flow #%lu is complete at %f", event.flow, clock_);
+          flow.completed = true;
+          completion_    = true;
+        } else {
+          schedule(clock_ + flow.ack_delay, Event::Type::ACK, event.flow, 0, event.bytes, event.end, event.marked);
+        }
+      }
+      break;
+
+    case Event::Type::ACK:
+      flow.acked += event.bytes;
+      if (event.marked && event.end > flow.recover) { // Once per window of data: halve the window
+        flow.threshold = std::max(flow.window / 2, cfg_packet_size.get());
+        flow.window    = flow.threshold;
+        flow.recover   = flow.sent;
+        XBT_DEBUG("Flow #%lu met some congestion, its window shrinks to %g bytes", event.flow, flow.window);
+      } else if (not event.marked) {
+        if (flow.window < flow.threshold) // Slow start
+          flow.window += event.bytes;
+        else // Congestion avoidance: one packet more per round-trip time
+          flow.window += cfg_packet_size * event.bytes / flow.window;
+        if (cfg_tcp_gamma > 0)
+          flow.window = std::max(std::min(flow.window, cfg_tcp_gamma.get()), cfg_packet_size.get());
+      }
+      send_packets(event.flow, flow);
+      break;
+
+    case Event::Type::SEND:
+      flow.send_pending = false;
+      send_packets(event.flow, flow);
+      break;
+
+    default:
+      THROW_IMPOSSIBLE;
+  }
+}
+
+double NetworkPacketModel::next_occurring_event(double max_delta)
+{
+  // Not idempotent: max_delta is the amount of time that the other models allow us to simulate
+  if (get_started_action_set()->empty())
+    return -1.0;
+
+  double start = EngineImpl::get_clock();
+  double limit = max_delta >= 0.0 ? start + max_delta : std::numeric_limits<double>::infinity();
+  clock_       = std::max(clock_, start);
+  completion_  = false;
+
+  // Stop at the first completion, but handle the events occurring at that same date first
+  while (not events_.empty() && events_.top().date <= limit && not(completion_ && events_.top().date > clock_)) {
+    Event event = events_.top();
+    events_.pop();
+    clock_ = std::max(clock_, event.date);
+    process(event);
+  }
+
+  if (completion_)
+    return clock_ - start;
+  XBT_DEBUG("No completion before %f (%zu pending events)", limit, events_.size());
+  return max_delta;
+}
+
+void NetworkPacketModel::update_actions_state(double now, double delta)
+{
+  for (auto it = std::begin(*get_started_action_set()); it != std::end(*get_started_action_set());) {
+    auto& action = static_cast<NetworkPacketAction&>(*it);
+    ++it; // increment iterator here since the following calls to action.finish() may invalidate it
+    auto flow = flows_.find(action.flow_id_);
+    if (flow == flows_.end())
+      continue;
+
+    double delivered = flow->second.delivered;
+    if (TRACE_is_enabled() && delta > 0) {
+      double data_delta = delivered - (action.get_cost() - action.get_remains_no_update());
+      for (auto const* link : action.route_)
+        instr::resource_set_utilization("LINK", "bandwidth_used", link->get_cname(), action.get_category(),
+                                        data_delta / delta, now - delta, delta);
+    }
+    action.set_remains(std::max(action.get_cost() - delivered, 0.0));
+    action.update_max_duration(delta);
+
+    if (flow->second.completed ||
+        ((action.get_max_duration() != NO_MAX_DURATION) && (action.get_max_duration() <= 0))) {
+      action.set_remains(0);
+      action.finish(Action::State::FINISHED);
+      forget_flow(action.flow_id_);
+    }
+  }
+}
+
+void NetworkPacketModel::resume_flow(unsigned long flow_id)
+{
+  if (auto flow = flows_.find(flow_id); flow != flows_.end()) {
+    clock_ = std::max(clock_, EngineImpl::get_clock());
+    send_packets(flow_id, flow->second);
+  }
+}
+
+void NetworkPacketModel::fail_flows(const LinkPacket* link)
+{
+  std::vector<NetworkPacketAction*> failed;
+  for (auto const& [id, flow] : flows_)
+    if (std::find(flow.action->route_.begin(), flow.action->route_.end(), link) != flow.action->route_.end())
+      failed.push_back(flow.action);
+
+  for (auto* action : failed) {
+    forget_flow(action->flow_id_);
+    action->set_finish_time(EngineImpl::get_clock());
+    action->set_state(Action::State::FAILED);
+  }
+}
+
+void NetworkPacketModel::forget_flow(unsigned long flow_id)
+{
+  auto flow = flows_.find(flow_id);
+  if (flow == flows_.end())
+    return;
+  for (auto* link : flow->second.action->route_)
+    link->users_--;
+  flows_.erase(flow);
+}
+
+/************
+ * Resource *
+ ************/
+LinkPacket::LinkPacket(const std::string& name, double bandwidth, routing::NetZoneImpl* englobing_zone)
+    : StandardLinkImpl(name, s4u::Link::SharingPolicy::SHARED, englobing_zone)
+{
+  bandwidth_.peak = bandwidth;
+}
+
+void LinkPacket::apply_event(profile::Event* triggered, double value)
+{
+  if (triggered == bandwidth_.event) {
+    set_bandwidth(value);
+    tmgr_trace_event_unref(&bandwidth_.event);
+
+  } else if (triggered == latency_.event) {
+    set_latency(value);
+    tmgr_trace_event_unref(&latency_.event);
+
+  } else if (triggered == get_state_event()) {
+    if (value > 0)
+      turn_on();
+    else
+      turn_off();
+    unref_state_event();
+  } else {
+    xbt_die("Unknown event!\n");
+  }
+}
+
+void LinkPacket::set_bandwidth(double value)
+{
+  // The packets already queued keep the date at which they leave
+  bandwidth_.peak = value;
+  StandardLinkImpl::on_bandwidth_change();
+}
+
+void LinkPacket::set_latency(double value)
+{
+  latency_check(value);
+  latency_.scale = 1.0;
+  latency_.peak  = value;
+}
+
+void LinkPacket::turn_off()
+{
+  bool was_on = is_on();
+  StandardLinkImpl::turn_off();
+  if (was_on)
+    static_cast<NetworkPacketModel*>(get_model())->fail_flows(this);
+}
+
+/**********
+ * Action *
+ **********/
+NetworkPacketAction::~NetworkPacketAction()
+{
+  static_cast<NetworkPacketModel*>(get_model())->forget_flow(flow_id_);
+}
+
+void NetworkPacketAction::suspend()
+{
+  // The packets in flight are still delivered, but no other one is sent
+  if (is_running())
+    set_suspend_state(Action::SuspendStates::SUSPENDED);
+}
+
+void NetworkPacketAction::resume()
+{
+  if (is_suspended()) {
+    set_suspend_state(Action::SuspendStates::RUNNING);
+    static_cast<NetworkPacketModel*>(get_model())->resume_flow(flow_id_);
+  }
+}
+
+std::list<StandardLinkImpl*> NetworkPacketAction::get_links() const
+{
+  return {route_.begin(), route_.end()};
+}
+
+void NetworkPacketAction::update_remains_lazy(double /*now*/)
+{
+  THROW_IMPOSSIBLE;
+}
+
+} // namespace simgrid::kernel::resource
@@ -0,0 +1,143 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef NETWORK_PACKET_HPP_
+#define NETWORK_PACKET_HPP_
+
+#include "src/kernel/resource/NetworkModel.hpp"
+#include "src/kernel/resource/StandardLinkImpl.hpp"
+
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace simgrid::kernel::resource {
+
+class NetworkPacketAction;
+class LinkPacket;
+
+/** @brief Packet-level network model, meant to validate the fluid models on mid-size platforms
+ *
+ * Each communication is cut into packets (or flowlets, when network/packet-size is large) that are stored and forwarded
+ * by the FIFO queue of each link along the route. The senders follow a TCP-like window: slow start, then additive
+ * increase, and halving of the window when a packet crossed a queue holding more than network/packet-queue-size
+ * packets (as with ECN marks; no packet is ever dropped). The acknowledgments travel back with the latency of the route,
+ * without using any bandwidth.
+ *
+ * The model runs its own event heap, as ns-3 does: next_occurring_event() advances it up to the next completion of a
+ * communication (or up to the horizon given by the other models), so it is not idempotent.
+ */
+class NetworkPacketModel : public NetworkModel {
+  struct Flow {
+    NetworkPacketAction* action;
+    double ack_delay;       // Latency of the route, for the acknowledgments
+    double size;            // Amount of bytes to deliver
+    double rate;            // User bound on the sending rate, or -1
+    double sent      = 0;   // Bytes injected on the route so far
+    double delivered = 0;   // Bytes that reached the destination
+    double acked     = 0;   // Bytes whose acknowledgment reached the source
+    double window;          // Congestion window, in bytes
+    double threshold;       // Slow start threshold, in bytes
+    double recover   = 0;   // No halving of the window until this amount of bytes is acknowledged
+    double next_send = 0;   // Date before which the rate bound forbids injecting another packet
+    bool send_pending = false; // Whether a SEND event of this flow is already in the heap
+    bool completed    = false;
+  };
+
+  struct Event {
+    enum class Type { HOP, ACK, SEND };
+    double date;
+    unsigned long seq; // Insertion order, to break the ties deterministically
+    Type type;
+    unsigned long flow;
+    size_t hop;   // Next link to cross (HOP)
+    double bytes; // Size of the packet (HOP, ACK)
+    double end;   // Offset of the packet end in the flow (HOP, ACK)
+    bool marked;  // Whether the packet crossed a congested queue (HOP, ACK)
+  };
+  struct EventLater {
+    bool operator()(const Event& a, const Event& b) const
+    {
+      return a.date > b.date || (a.date == b.date && a.seq > b.seq);
+    }
+  };
+
+  std::priority_queue<Event, std::vector<Event>, EventLater> events_;
+  std::unordered_map<unsigned long, Flow> flows_;
+  unsigned long next_flow_id_  = 1;
+  unsigned long next_event_    = 0;
+  double clock_                = 0; // Date of the last processed event
+  bool completion_             = false;
+
+  void schedule(double date, Event::Type type, unsigned long flow_id, size_t hop = 0, double bytes = 0, double end = 0,
+                bool marked = false);
+  void send_packets(unsigned long flow_id, Flow& flow);
+  void process(const Event& event);
+
+public:
+  static config::Flag<double> cfg_packet_size;
+  static config::Flag<int> cfg_initial_window;
+  static config::Flag<double> cfg_queue_size;
+
+  explicit NetworkPacketModel(const std::string& name);
+  StandardLinkImpl* create_link(const std::string& name, const std::vector<double>& bandwidths,
+                                routing::NetZoneImpl* englobing_zone) override;
+  StandardLinkImpl* create_wifi_link(const std::string& name, const std::vector<double>& bandwidths,
+                                     routing::NetZoneImpl* englobing_zone) override;
+  Action* communicate(s4u::Host* src, s4u::Host* dst, double size, double rate, bool streamed) override;
+  double next_occurring_event(double max_delta) override;
+  bool next_occurring_event_is_idempotent() override { return false; }
+  void update_actions_state(double now, double delta) override;
+
+  /** Resumes the injection of packets of a flow that was suspended */
+  void resume_flow(unsigned long flow_id);
+  /** Fails the communications that cross this link */
+  void fail_flows(const LinkPacket* link);
+  /** Drops the state of a flow. Its packets still in flight are discarded at their next hop */
+  void forget_flow(unsigned long flow_id);
+};
+
+/************
+ * Resource *
+ ************/
+class LinkPacket : public StandardLinkImpl {
+  friend NetworkPacketModel;
+  double busy_until_ = 0; // Date at which the last queued packet is fully transmitted
+  unsigned long users_ = 0;
+
+public:
+  LinkPacket(const std::string& name, double bandwidth, routing::NetZoneImpl* englobing_zone);
+
+  bool is_used() const override { return users_ > 0; }
+  void apply_event(profile::Event* event, double value) override;
+  void set_bandwidth(double value) override;
+  void set_latency(double value) override;
+  void turn_off() override;
+};
+
+/**********
+ * Action *
+ **********/
+class NetworkPacketAction : public NetworkAction {
+  friend NetworkPacketModel;
+  unsigned long flow_id_ = 0;
+  std::vector<LinkPacket*> route_;
+
+public:
+  NetworkPacketAction(NetworkPacketModel* model, s4u::Host& src, s4u::Host& dst, double size, bool failed)
+      : NetworkAction(model, src, dst, size, failed)
+  {
+  }
+  ~NetworkPacketAction() override;
+
+  void suspend() override;
+  void resume() override;
+  std::list<StandardLinkImpl*> get_links() const override;
+  XBT_ATTRIB_NORETURN void update_remains_lazy(double now) override;
+};
+
+} // namespace simgrid::kernel::resource
+
+#endif /* NETWORK_PACKET_HPP_ */
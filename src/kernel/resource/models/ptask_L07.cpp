@@ -164,15 +164,37 @@ CpuAction* HostL07Model::execute_parallel(const std::vector<s4u::Host*>& host_li
   return new L07Action(this, host_list, flops_amount, bytes_amount, rate);
 }
 
+CpuAction* HostL07Model::execute_parallel(const std::vector<s4u::Host*>& host_list, const double* flops_amount,
+                                          const std::vector<s4u::Exec::Transfer>& transfers, double rate)
+{
+  return new L07Action(this, host_list, flops_amount, transfers, rate);
+}
+
+/* Extracts the non-zero entries of a host_nb-square matrix of bytes */
+static std::vector<s4u::Exec::Transfer> sparse_transfers(size_t host_nb, const double* bytes_amount)
+{
+  std::vector<s4u::Exec::Transfer> transfers;
+  if (bytes_amount != nullptr)
+    for (size_t k = 0; k < host_nb * host_nb; k++)
+      if (bytes_amount[k] > 0)
+        transfers.push_back({k / host_nb, k % host_nb, bytes_amount[k]});
+  return transfers;
+}
+
 L07Action::L07Action(Model* model, const std::vector<s4u::Host*>& host_list, const double* flops_amount,
                      const double* bytes_amount, double rate)
+    : L07Action(model, host_list, flops_amount, sparse_transfers(host_list.size(), bytes_amount), rate)
+{
+}
+
+L07Action::L07Action(Model* model, const std::vector<s4u::Host*>& host_list, const double* flops_amount,
+                     std::vector<s4u::Exec::Transfer> transfers, double rate)
     : CpuAction(model, 1.0, false)
     , host_list_(host_list)
     , computation_amount_(flops_amount)
-    , communication_amount_(bytes_amount)
+    , communications_(std::move(transfers))
     , rate_(rate)
 {
-  size_t link_nb       = 0;
   const size_t host_nb = host_list_.size();
   size_t used_host_nb  = 0; /* Only the hosts with something to compute (>0 flops) are counted) */
   double latency       = 0.0;
@@ -181,27 +203,24 @@ L07Action::L07Action(Model* model, const std::vector<s4u::Host*>& host_list, con
   if (flops_amount != nullptr)
     used_host_nb += std::count_if(flops_amount, flops_amount + host_nb, [](double x) { return x > 0.0; });
 
-  /* Compute the number of affected resources... */
-  if (bytes_amount != nullptr) {
-    std::unordered_set<const char*> affected_links;
-
-    for (size_t k = 0; k < host_nb * host_nb; k++) {
-      if (bytes_amount[k] <= 0)
-        continue;
-
-      double lat = 0.0;
-      std::vector<StandardLinkImpl*> route;
-      host_list_[k / host_nb]->route_to(host_list_[k % host_nb], route, &lat);
-      latency = std::max(latency, lat);
-
-      for (auto const* link : route)
-        affected_links.insert(link->get_cname());
-    }
-
-    link_nb = affected_links.size();
+  std::erase_if(communications_, [](const s4u::Exec::Transfer& t) { return t.bytes <= 0; });
+
+  /* Compute the route of each communication once, and the number of affected resources... */
+  std::vector<std::vector<StandardLinkImpl*>> routes(communications_.size());
+  std::unordered_set<const StandardLinkImpl*> affected_links;
+  for (size_t k = 0; k < communications_.size(); k++) {
+    auto const& [src, dst, bytes] = communications_[k];
+    xbt_assert(src < host_nb && dst < host_nb, "Transfer from host #%zu to host #%zu, out of the %zu hosts", src, dst,
+               host_nb);
+    double lat = 0.0;
+    host_list_[src]->route_to(host_list_[dst], routes[k], &lat);
+    latency = std::max(latency, lat);
+    affected_links.insert(routes[k].begin(), routes[k].end());
   }
+  const size_t link_nb = affected_links.size();
 
-  XBT_DEBUG("Creating a parallel task (%p) with %zu hosts and %zu unique links.", this, host_nb, link_nb);
+  XBT_DEBUG("Creating a parallel task (%p) with %zu hosts, %zu communications and %zu unique links.", this, host_nb,
+            communications_.size(), link_nb);
   latency_ = latency;
 
   // Allocate more space for constraints (+4) in case users want to mix ptasks and io streams
@@ -217,17 +236,9 @@ L07Action::L07Action(Model* model, const std::vector<s4u::Host*>& host_list, con
                                        (flops_amount == nullptr ? 0.0 : flops_amount[i]), true);
   }
 
-  if (bytes_amount != nullptr) {
-    for (size_t k = 0; k < host_nb * host_nb; k++) {
-      if (bytes_amount[k] <= 0.0)
-        continue;
-      std::vector<StandardLinkImpl*> route;
-      host_list_[k / host_nb]->route_to(host_list_[k % host_nb], route, nullptr);
-
-      for (auto const* link : route)
-        model->get_maxmin_system()->expand(link->get_constraint(), this->get_variable(), bytes_amount[k]);
-    }
-  }
+  for (size_t k = 0; k < communications_.size(); k++)
+    for (auto const* link : routes[k])
+      model->get_maxmin_system()->expand(link->get_constraint(), this->get_variable(), communications_[k].bytes);
 
   if (link_nb + used_host_nb == 0) {
     this->set_cost(1.0);
@@ -240,14 +251,7 @@ L07Action::L07Action(Model* model, const std::vector<s4u::Host*>& host_list, con
 Action* NetworkL07Model::communicate(s4u::Host* src, s4u::Host* dst, double size, double rate, bool /* streamed */)
 {
   std::vector<s4u::Host*> host_list = {src, dst};
-  const auto* flops_amount          = new double[2]();
-  auto* bytes_amount                = new double[4]();
-
-  bytes_amount[1] = size;
-
-  Action* res = hostModel_->execute_parallel(host_list, flops_amount, bytes_amount, rate);
-  static_cast<L07Action*>(res)->free_arrays_ = true;
-  return res;
+  return hostModel_->execute_parallel(host_list, nullptr, std::vector<s4u::Exec::Transfer>{{0, 1, size}}, rate);
 }
 
 CpuImpl* CpuL07Model::create_cpu(s4u::Host* host, const std::vector<double>& speed_per_pstate)
@@ -393,10 +397,8 @@ LinkL07::~LinkL07() = default;
 
 L07Action::~L07Action()
 {
-  if (free_arrays_) {
+  if (free_arrays_)
     delete[] computation_amount_;
-    delete[] communication_amount_;
-  }
 }
 
 double L07Action::calculate_network_bound() const
@@ -404,22 +406,12 @@ double L07Action::calculate_network_bound() const
   double lat_current = 0.0;
   double lat_bound   = std::numeric_limits<double>::max();
 
-  size_t host_count = host_list_.size();
-
-  if (communication_amount_ == nullptr) {
-    return lat_bound;
-  }
+  for (auto const& [src, dst, bytes] : communications_) {
+    double lat = 0.0;
+    std::vector<StandardLinkImpl*> route;
+    host_list_[src]->route_to(host_list_[dst], route, &lat);
 
-  for (size_t i = 0; i < host_count; i++) {
-    for (size_t j = 0; j < host_count; j++) {
-      if (communication_amount_[i * host_count + j] > 0) {
-        double lat = 0.0;
-        std::vector<StandardLinkImpl*> route;
-        host_list_.at(i)->route_to(host_list_.at(j), route, &lat);
-
-        lat_current = std::max(lat_current, lat * communication_amount_[i * host_count + j]);
-      }
-    }
+    lat_current = std::max(lat_current, lat * bytes);
   }
   if (lat_current > 0) {
     lat_bound = NetworkModel::cfg_tcp_gamma / (2.0 * lat_current);
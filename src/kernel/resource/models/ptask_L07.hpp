@@ -36,12 +36,15 @@ public:
   HostL07Model(const std::string& name, lmm::System* sys);
   HostL07Model(const HostL07Model&)            = delete;
   HostL07Model& operator=(const HostL07Model&) = delete;
+  using HostModel::execute_parallel;
 
   double next_occurring_event(double now) override;
   void update_actions_state(double now, double delta) override;
   Action* execute_thread(const s4u::Host* host, double flops_amount, int thread_count) override { return nullptr; }
   CpuAction* execute_parallel(const std::vector<s4u::Host*>& host_list, const double* flops_amount,
                               const double* bytes_amount, double rate) override;
+  CpuAction* execute_parallel(const std::vector<s4u::Host*>& host_list, const double* flops_amount,
+                              const std::vector<s4u::Exec::Transfer>& transfers, double rate) override;
 };
 
 class CpuL07Model : public CpuModel {
@@ -120,12 +123,10 @@ public:
  **********/
 class L07Action : public CpuAction {
   const std::vector<s4u::Host*> host_list_;
-  bool free_arrays_ = false; // By default, computation_amount_ and friends are freed by caller. But not for sequential
-                             // exec and regular comms
-  const double* computation_amount_;   /* pointer to the data that lives in s4u action -- do not free unless if
-                                        * free_arrays */
-  const double* communication_amount_; /* pointer to the data that lives in s4u action -- do not free unless if
-                                        * free_arrays */
+  bool free_arrays_ = false; // By default, computation_amount_ is freed by caller. But not for sequential exec
+  const double* computation_amount_; /* pointer to the data that lives in s4u action -- do not free unless if
+                                      * free_arrays */
+  std::vector<s4u::Exec::Transfer> communications_; /* Only the pairs of hosts exchanging a positive amount of bytes */
   double latency_;
   double rate_;
 
@@ -154,6 +155,8 @@ public:
   L07Action() = delete;
   L07Action(Model* model, const std::vector<s4u::Host*>& host_list, const double* flops_amount,
             const double* bytes_amount, double rate);
+  L07Action(Model* model, const std::vector<s4u::Host*>& host_list, const double* flops_amount,
+            std::vector<s4u::Exec::Transfer> transfers, double rate);
   L07Action(const L07Action&)            = delete;
   L07Action& operator=(const L07Action&) = delete;
   ~L07Action() override;
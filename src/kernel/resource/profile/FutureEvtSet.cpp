@@ -16,6 +16,9 @@ simgrid::kernel::profile::FutureEvtSet future_evt_set; // FIXME: singleton antip
 FutureEvtSet::FutureEvtSet() = default;
 FutureEvtSet::~FutureEvtSet()
 {
+  /* The global set lives until the exit, when the signals may already be destroyed */
+  if (platform_created_cb_ && this != &future_evt_set)
+    s4u::Engine::on_platform_created.disconnect(*platform_created_cb_);
   while (not heap_.empty()) {
     delete heap_.top().second;
     heap_.pop();
@@ -25,8 +28,8 @@ FutureEvtSet::~FutureEvtSet()
 /** @brief Schedules an event to a future date */
 void FutureEvtSet::add_event(double date, Event* evt)
 {
-  if (heap_.empty())
-    s4u::Engine::on_platform_created_cb([this]() {
+  if (not platform_created_cb_)
+    platform_created_cb_ = s4u::Engine::on_platform_created.connect([this]() {
       /* Handle the events of time = 0 right after the platform creation */
       double next_event_date;
       while ((next_event_date = this->next_date()) != -1.0) {
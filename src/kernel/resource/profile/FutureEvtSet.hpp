@@ -7,6 +7,7 @@
 #define FUTUREEVTSET_HPP
 
 #include "simgrid/forward.h"
+#include <optional>
 #include <queue>
 
 namespace simgrid::kernel::profile {
@@ -26,6 +27,7 @@ public:
 private:
   using Qelt = std::pair<double, Event*>;
   std::priority_queue<Qelt, std::vector<Qelt>, std::greater<>> heap_;
+  std::optional<unsigned int> platform_created_cb_; // Handles the events of time = 0, until this set is destroyed
 };
 
 // FIXME: kill that singleton
@@ -36,7 +36,7 @@ Event* Profile::schedule(FutureEvtSet* fes, resource::Resource* resource)
   fes_ = fes;
 
   if (get_enough_events(0)) {
-    fes_->add_event(event_list[0].date_, event);
+    fes_->add_event(get_event(0).date_, event);
   } else {
     event->free_me  = true;
     tmgr_trace_event_unref(&event);
@@ -49,12 +49,12 @@ DatedValue Profile::next(Event* event)
 {
   double event_date  = fes_->next_date();
 
-  DatedValue dateVal = event_list.at(event->idx);
+  DatedValue dateVal = get_event(event->idx);
 
   event->idx++;
 
   if (get_enough_events(event->idx)) {
-    const DatedValue& nextDateVal = event_list[event->idx];
+    const DatedValue nextDateVal = get_event(event->idx);
     xbt_assert(nextDateVal.date_>=0);
     xbt_assert(nextDateVal.value_>=0);
     fes_->add_event(event_date +nextDateVal.date_, event);
@@ -64,6 +64,42 @@ DatedValue Profile::next(Event* event)
   return dateVal;
 }
 
+bool Profile::get_enough_events(size_t index)
+{
+  if (source_) {
+    /* Past the end of the source, the iteration is repeated on the fly (if it is repeating) */
+    size_t available = source_->get_events(index + 1).size();
+    return index < available || (available > 0 && source_->get_loop_delay() >= 0);
+  }
+  if (index >= event_list.size() && cb)
+    cb(event_list);
+  return index < event_list.size();
+}
+
+DatedValue Profile::get_event(size_t index) const
+{
+  if (not source_)
+    return event_list.at(index);
+  std::span<const DatedValue> events = source_->get_events(index + 1);
+  if (index < events.size())
+    return events[index];
+  /* Next iterations: the first event comes after the loop delay */
+  DatedValue res = events[index % events.size()];
+  if (index % events.size() == 0)
+    res.date_ += source_->get_loop_delay();
+  return res;
+}
+
+void Profile::for_each_event(const std::function<void(const DatedValue&)>& visit) const
+{
+  if (source_) {
+    source_->for_each_event(visit);
+    return;
+  }
+  for (auto const& event : event_list)
+    visit(event);
+}
+
 Profile::Profile(const std::string& name, const std::function<ProfileBuilder::UpdateCb>& cb, double repeat_delay)
     : name(name), cb(cb), repeat_delay(repeat_delay)
 {
@@ -72,6 +108,19 @@ Profile::Profile(const std::string& name, const std::function<ProfileBuilder::Up
   get_enough_events(0);
 }
 
+Profile::Profile(const std::string& name, std::unique_ptr<EventSource> source) : name(name), source_(std::move(source))
+{
+  xbt_assert(trace_list.find(name) == trace_list.end(), "Refusing to define trace %s twice", name.c_str());
+  trace_list.try_emplace(name, this);
+  get_enough_events(0);
+}
+
+Profile* Profile::by_name_or_null(const std::string& name)
+{
+  auto it = trace_list.find(name);
+  return it == trace_list.end() ? nullptr : it->second;
+}
+
 } // namespace simgrid::kernel::profile
 
 void tmgr_finalize()
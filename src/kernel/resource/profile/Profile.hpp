@@ -11,12 +11,31 @@
 #include "src/kernel/resource/profile/FutureEvtSet.hpp"
 #include "src/kernel/resource/profile/StochasticDatedValue.hpp"
 
+#include <functional>
+#include <memory>
 #include <queue>
-#include <vector>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace simgrid::kernel::profile {
 
+/** @brief Where a deterministic profile reads its events from on need, instead of building them all upfront
+ *
+ * The events form one iteration of the profile, that is repeated after get_loop_delay() if that delay is not negative.
+ * See ProfileBuilder::from_file() for the sources reading a profile file progressively or mapping it in memory.
+ */
+class EventSource {
+public:
+  virtual ~EventSource() = default;
+  /** @brief Makes at least @c count events available (if the iteration is that long), and returns all available ones */
+  virtual std::span<const DatedValue> get_events(size_t count) = 0;
+  /** @brief Visits all the events of one iteration in order. The ones that were not read yet are not kept */
+  virtual void for_each_event(const std::function<void(const DatedValue&)>& visit) = 0;
+  /** @brief Delay between the last event and the next iteration (negative if not repeating), read first if needed */
+  virtual double get_loop_delay() = 0;
+};
+
 /** @brief A profile is a set of timed values, encoding the value that a variable takes at what time
  *
  * It is useful to model dynamic platforms, where an external load that makes the resource availability change over
@@ -37,28 +56,33 @@ public:
    * the event_list. If zero or positive, the initial set repeats after the provided delay.
    */
   explicit Profile(const std::string& name, const std::function<ProfileBuilder::UpdateCb>& cb, double repeat_delay);
+  /** @brief Create a deterministic profile whose events are taken from @c source as the simulation advances.
+   *
+   * The events are not copied from the source, and the repetitions are computed on the fly. */
+  explicit Profile(const std::string& name, std::unique_ptr<EventSource> source);
   virtual ~Profile()=default;
+  /** @brief Retrieves a profile that was already created, to share it between resources */
+  static Profile* by_name_or_null(const std::string& name);
   Event* schedule(FutureEvtSet* fes, resource::Resource* resource);
   DatedValue next(Event* event);
 
-  const std::vector<DatedValue>& get_event_list() const { return event_list; }
+  /** @brief Visits the events of one iteration of the profile, without keeping in memory the ones of an EventSource
+   * that were not needed yet */
+  void for_each_event(const std::function<void(const DatedValue&)>& visit) const;
   const std::string& get_name() const { return name; }
-  bool is_repeating() const { return repeat_delay>=0;}
-  double get_repeat_delay() const { return repeat_delay;}
+  bool is_repeating() const { return get_repeat_delay() >= 0; }
+  double get_repeat_delay() const { return source_ ? source_->get_loop_delay() : repeat_delay; }
 
 private:
   std::string name;
   std::function<ProfileBuilder::UpdateCb> cb;
   std::vector<DatedValue> event_list;
+  std::unique_ptr<EventSource> source_;
   FutureEvtSet* fes_  = nullptr;
-  double repeat_delay;
+  double repeat_delay = -1.0;
 
-  bool get_enough_events(size_t index)
-  {
-    if (index >= event_list.size() && cb)
-      cb(event_list);
-    return index < event_list.size();
-  }
+  bool get_enough_events(size_t index);
+  DatedValue get_event(size_t index) const;
 };
 
 } // namespace simgrid::kernel::profile
@@ -12,11 +12,22 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/intrusive/options.hpp>
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <math.h>
+#include <optional>
 #include <sstream>
 #include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
 
 namespace simgrid::kernel::profile {
 
@@ -66,25 +77,101 @@ std::ostream& operator << (std::ostream& out, const DatedValue& dv) {
  * the first iteration.
  */
 
-class LegacyUpdateCb {
-  std::vector<StochasticDatedValue> pattern;
-  bool stochastic = false;
-  bool loop;
-  double loop_delay = 0.0;
+static bool is_comment_or_empty_line(std::string_view val)
+{
+  return (val.empty() || val.front() == '#' || val.front() == '%');
+}
 
-  static bool is_comment_or_empty_line(std::string_view val)
-  {
-    return (val.empty() || val.front() == '#' || val.front() == '%');
+static bool is_normal_distribution(std::string_view val)
+{
+  return (val == "NORM" || val == "NORMAL" || val == "GAUSS" || val == "GAUSSIAN");
+}
+
+static bool is_exponential_distribution(std::string_view val)
+{
+  return (val == "EXP" || val == "EXPONENTIAL");
+}
+
+static bool is_uniform_distribution(std::string_view val)
+{
+  return (val == "UNIF" || val == "UNIFORM");
+}
+
+/* Parses the PERIODICITY and LOOPAFTER instructions, that make the profile loop */
+static bool parse_loop_instruction(const std::string& val, double& periodicity, double& loop_delay)
+{
+  return sscanf(val.c_str(), "PERIODICITY %lg\n", &periodicity) == 1 ||
+         sscanf(val.c_str(), "LOOPAFTER %lg\n", &loop_delay) == 1;
+}
+
+/* Parses a local instruction. The dates and values are plain numbers in deterministic profiles, or have a law */
+static StochasticDatedValue parse_event_line(const std::string& val, bool stochastic)
+{
+  StochasticDatedValue stochevent;
+  unsigned int i;
+  unsigned int j;
+  std::istringstream iss(val);
+  std::vector<std::string> splittedval((std::istream_iterator<std::string>(iss)), std::istream_iterator<std::string>());
+
+  xbt_assert(not splittedval.empty(), "Invalid profile line");
+
+  if (splittedval[0] == "DET") {
+    stochevent.date_law = Distribution::DET;
+    i                   = 2;
+  } else if (is_normal_distribution(splittedval[0])) {
+    stochevent.date_law = Distribution::NORM;
+    i                   = 3;
+  } else if (is_exponential_distribution(splittedval[0])) {
+    stochevent.date_law = Distribution::EXP;
+    i                   = 2;
+  } else if (is_uniform_distribution(splittedval[0])) {
+    stochevent.date_law = Distribution::UNIF;
+    i                   = 3;
+  } else {
+    xbt_assert(not stochastic);
+    stochevent.date_law = Distribution::DET;
+    i                   = 1;
   }
 
-  static bool is_normal_distribution(std::string_view val)
-  {
-    return (val == "NORM" || val == "NORMAL" || val == "GAUSS" || val == "GAUSSIAN");
+  xbt_assert(splittedval.size() > i, "Invalid profile line");
+  if (i == 1 || i == 2) {
+    stochevent.date_params = {std::stod(splittedval[i - 1])};
+  } else if (i == 3) {
+    stochevent.date_params = {std::stod(splittedval[1]), std::stod(splittedval[2])};
   }
 
-  static bool is_exponential_distribution(std::string_view val) { return (val == "EXP" || val == "EXPONENTIAL"); }
+  if (splittedval[i] == "DET") {
+    stochevent.value_law = Distribution::DET;
+    j                    = 1;
+  } else if (is_normal_distribution(splittedval[i])) {
+    stochevent.value_law = Distribution::NORM;
+    j                    = 2;
+  } else if (is_exponential_distribution(splittedval[i])) {
+    stochevent.value_law = Distribution::EXP;
+    j                    = 1;
+  } else if (is_uniform_distribution(splittedval[i])) {
+    stochevent.value_law = Distribution::UNIF;
+    j                    = 2;
+  } else {
+    xbt_assert(not stochastic);
+    stochevent.value_law = Distribution::DET;
+    j                    = 0;
+  }
 
-  static bool is_uniform_distribution(std::string_view val) { return (val == "UNIF" || val == "UNIFORM"); }
+  xbt_assert(splittedval.size() > i + j, "Invalid profile line");
+  if (j == 0 || j == 1) {
+    stochevent.value_params = {std::stod(splittedval[i + j])};
+  } else if (j == 2) {
+    stochevent.value_params = {std::stod(splittedval[i + 1]), std::stod(splittedval[i + 2])};
+  }
+  return stochevent;
+}
+
+class LegacyUpdateCb {
+  std::vector<StochasticDatedValue> pattern;
+  bool stochastic = false;
+  bool loop;
+  double loop_delay = 0.0;
 
 public:
   LegacyUpdateCb(const std::string& input, double periodicity) : loop(periodicity > 0)
@@ -94,16 +181,11 @@ public:
     double last_date = 0;
     boost::split(list, input, boost::is_any_of("\n\r"));
     for (auto val : list) {
-      simgrid::kernel::profile::StochasticDatedValue stochevent;
       linecount++;
       boost::trim(val);
       if (is_comment_or_empty_line(val))
         continue;
-      if (sscanf(val.c_str(), "PERIODICITY %lg\n", &periodicity) == 1) {
-        loop = true;
-        continue;
-      }
-      if (sscanf(val.c_str(), "LOOPAFTER %lg\n", &loop_delay) == 1) {
+      if (parse_loop_instruction(val, periodicity, loop_delay)) {
         loop = true;
         continue;
       }
@@ -117,64 +199,7 @@ public:
         continue;
       }
 
-      unsigned int i;
-      unsigned int j;
-      std::istringstream iss(val);
-      std::vector<std::string> splittedval((std::istream_iterator<std::string>(iss)),
-                                           std::istream_iterator<std::string>());
-
-      xbt_assert(not splittedval.empty(), "Invalid profile line");
-
-      if (splittedval[0] == "DET") {
-        stochevent.date_law = Distribution::DET;
-        i                   = 2;
-      } else if (is_normal_distribution(splittedval[0])) {
-        stochevent.date_law = Distribution::NORM;
-        i                   = 3;
-      } else if (is_exponential_distribution(splittedval[0])) {
-        stochevent.date_law = Distribution::EXP;
-        i                   = 2;
-      } else if (is_uniform_distribution(splittedval[0])) {
-        stochevent.date_law = Distribution::UNIF;
-        i                   = 3;
-      } else {
-        xbt_assert(not stochastic);
-        stochevent.date_law = Distribution::DET;
-        i                   = 1;
-      }
-
-      xbt_assert(splittedval.size() > i, "Invalid profile line");
-      if (i == 1 || i == 2) {
-        stochevent.date_params = {std::stod(splittedval[i - 1])};
-      } else if (i == 3) {
-        stochevent.date_params = {std::stod(splittedval[1]), std::stod(splittedval[2])};
-      }
-
-      if (splittedval[i] == "DET") {
-        stochevent.value_law = Distribution::DET;
-        j                    = 1;
-      } else if (is_normal_distribution(splittedval[i])) {
-        stochevent.value_law = Distribution::NORM;
-        j                    = 2;
-      } else if (is_exponential_distribution(splittedval[i])) {
-        stochevent.value_law = Distribution::EXP;
-        j                    = 1;
-      } else if (is_uniform_distribution(splittedval[i])) {
-        stochevent.value_law = Distribution::UNIF;
-        j                    = 2;
-      } else {
-        xbt_assert(not stochastic);
-        stochevent.value_law = Distribution::DET;
-        j                    = 0;
-      }
-
-      xbt_assert(splittedval.size() > i + j, "Invalid profile line");
-      if (j == 0 || j == 1) {
-        stochevent.value_params = {std::stod(splittedval[i + j])};
-      } else if (j == 2) {
-        stochevent.value_params = {std::stod(splittedval[i + 1]), std::stod(splittedval[i + 2])};
-      }
-
+      StochasticDatedValue stochevent = parse_event_line(val, stochastic);
       if (not stochastic) {
         // In this mode, dates read from the string are absolute values
         double new_date = stochevent.date_params[0];
@@ -218,6 +243,202 @@ public:
   std::vector<StochasticDatedValue> get_pattern() const { return pattern; }
 };
 
+/** @brief Reads a deterministic profile file progressively, as the simulation needs its events.
+ *
+ * This accepts the same syntax as LegacyUpdateCb, but without any random law. The PERIODICITY and LOOPAFTER
+ * instructions can appear anywhere, as the loop delay is only needed once all events were read.
+ *
+ * The file is only open while it is read, so that the amount of profiles is not limited by the amount of files that a
+ * process can open. It must thus not be modified during the simulation.
+ */
+class TextEventSource : public EventSource {
+  static constexpr size_t CHUNK_SIZE = 4096; // Amount of events read at once when more are needed
+
+  /* Where and in which state the parsing stopped */
+  struct Cursor {
+    std::streamoff offset = 0;
+    int linecount         = 0;
+    double last_date      = 0;
+    double periodicity    = -1;
+    double loop_delay     = 0;
+    bool loop             = false;
+    bool done             = false;
+  };
+
+  std::string path_;
+  std::string name_;
+  std::vector<DatedValue> events_;
+  Cursor cursor_;              // After the events_ that are kept
+  std::optional<Cursor> end_;  // Once the whole file was parsed, for its loop delay
+
+  void parse_line(Cursor& cursor, const std::string& line, const std::function<void(const DatedValue&)>& emit) const
+  {
+    if (is_comment_or_empty_line(line))
+      return;
+    if (parse_loop_instruction(line, cursor.periodicity, cursor.loop_delay)) {
+      cursor.loop = true;
+      return;
+    }
+    xbt_assert(not boost::starts_with(line, "STOCHASTIC"),
+               "%s:%d: STOCHASTIC must be declared before the first event of the profile", name_.c_str(),
+               cursor.linecount);
+
+    StochasticDatedValue event = parse_event_line(line, false);
+    xbt_assert(event.date_law == Distribution::DET && event.value_law == Distribution::DET,
+               "%s:%d: Random laws need a STOCHASTIC profile", name_.c_str(), cursor.linecount);
+    double date = event.date_params[0];
+    xbt_assert(date >= 0, "Profile time value is negative, why?");
+    xbt_assert(cursor.last_date <= date, "%s:%d: Invalid trace: Events must be sorted, but time %g > time %g.",
+               name_.c_str(), cursor.linecount, cursor.last_date, date);
+    emit(DatedValue(date - cursor.last_date, event.value_params[0]));
+    cursor.last_date = date;
+  }
+
+  /* Parses the file from that cursor, until @c count events were passed to @c emit or until its end */
+  void read(Cursor& cursor, size_t count, const std::function<void(const DatedValue&)>& emit)
+  {
+    if (cursor.done)
+      return;
+    std::ifstream stream(path_);
+    xbt_assert(not stream.fail(), "Cannot open the profile file '%s' again", path_.c_str());
+    stream.seekg(cursor.offset);
+
+    size_t emitted = 0;
+    std::function<void(const DatedValue&)> counting_emit = [&emit, &emitted](const DatedValue& event) {
+      emit(event);
+      emitted++;
+    };
+    std::string line;
+    while (emitted < count && std::getline(stream, line)) {
+      cursor.linecount++;
+      boost::trim(line);
+      parse_line(cursor, line, counting_emit);
+    }
+    if (not stream.eof()) {
+      cursor.offset = stream.tellg();
+      return;
+    }
+
+    /* All events were read, compute the loop delay */
+    cursor.done = true;
+    if (cursor.periodicity > 0) {
+      xbt_assert(cursor.loop_delay == 0, "%s: PERIODICITY and LOOPAFTER cannot be used together", name_.c_str());
+      cursor.loop_delay = cursor.periodicity - cursor.last_date;
+    }
+    xbt_assert(cursor.loop_delay >= 0, "Profile loop conditions are not realizable!");
+    end_ = cursor;
+  }
+
+public:
+  TextEventSource(const std::string& path, const std::string& name) : path_(path), name_(name) {}
+  std::span<const DatedValue> get_events(size_t count) override
+  {
+    if (events_.size() < count)
+      read(cursor_, std::max(count - events_.size(), CHUNK_SIZE),
+           [this](const DatedValue& event) { events_.push_back(event); });
+    return events_;
+  }
+  void for_each_event(const std::function<void(const DatedValue&)>& visit) override
+  {
+    for (auto const& event : events_)
+      visit(event);
+    Cursor cursor = cursor_; // The events read now are not kept
+    read(cursor, std::numeric_limits<size_t>::max(), visit);
+  }
+  double get_loop_delay() override
+  {
+    if (not end_)
+      for_each_event([](const DatedValue&) { /* only the end of the file matters */ });
+    return end_->loop ? end_->loop_delay : -1.0;
+  }
+};
+
+/** @brief Binary profile files: a header, then the {delay since the previous event, value} pairs in native layout */
+struct BinaryProfileHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t byte_order; // BYTE_ORDER_MARKER, written in native byte order
+  double loop_delay;   // negative if the profile does not repeat
+  uint64_t count;
+};
+static constexpr std::array<char, 8> BINARY_PROFILE_MAGIC = {'S', 'G', 'P', 'R', 'O', 'F', 'L', '\0'};
+static constexpr uint32_t BINARY_PROFILE_VERSION          = 1;
+static constexpr uint32_t BYTE_ORDER_MARKER               = 0x01020304;
+static_assert(sizeof(BinaryProfileHeader) == 32 && std::is_trivially_copyable_v<BinaryProfileHeader>);
+static_assert(sizeof(DatedValue) == 2 * sizeof(double) && std::is_trivially_copyable_v<DatedValue>);
+
+/** @brief Maps a binary profile file in memory, so that its events are neither parsed nor copied */
+class BinaryEventSource : public EventSource {
+  void* mapping_ = MAP_FAILED;
+  size_t size_   = 0;
+  std::span<const DatedValue> events_;
+  double loop_delay_ = -1.0;
+
+public:
+  BinaryEventSource(FILE* file, const std::string& name)
+  {
+    struct stat st;
+    if (fstat(fileno(file), &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(BinaryProfileHeader))) {
+      size_    = static_cast<size_t>(st.st_size);
+      mapping_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    }
+    fclose(file);
+    xbt_assert(mapping_ != MAP_FAILED, "Cannot map the binary profile '%s' in memory", name.c_str());
+
+    BinaryProfileHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    xbt_assert(header.version == BINARY_PROFILE_VERSION && header.byte_order == BYTE_ORDER_MARKER,
+               "The binary profile '%s' was written by another version of SimGrid or on another kind of machine",
+               name.c_str());
+    xbt_assert(header.count == (size_ - sizeof(header)) / sizeof(DatedValue) &&
+                   (size_ - sizeof(header)) % sizeof(DatedValue) == 0,
+               "The binary profile '%s' is truncated", name.c_str());
+    loop_delay_ = header.loop_delay;
+    events_     = std::span(reinterpret_cast<const DatedValue*>(static_cast<const char*>(mapping_) + sizeof(header)),
+                            header.count);
+  }
+  BinaryEventSource(const BinaryEventSource&)            = delete;
+  BinaryEventSource& operator=(const BinaryEventSource&) = delete;
+  ~BinaryEventSource() override { munmap(mapping_, size_); }
+
+  std::span<const DatedValue> get_events(size_t /*count*/) override { return events_; }
+  void for_each_event(const std::function<void(const DatedValue&)>& visit) override
+  {
+    for (auto const& event : events_)
+      visit(event);
+  }
+  double get_loop_delay() override { return loop_delay_; }
+};
+
+/* Checks whether that stream is a binary profile, and rewinds it */
+static bool is_binary_profile(std::ifstream& stream)
+{
+  std::array<char, 8> magic = {};
+  stream.read(magic.data(), magic.size());
+  stream.clear();
+  stream.seekg(0);
+  return magic == BINARY_PROFILE_MAGIC;
+}
+
+/* Checks whether that profile file declares some STOCHASTIC events before its first event, and rewinds it */
+static bool is_stochastic_profile(std::ifstream& stream)
+{
+  bool res = false;
+  std::string line;
+  double periodicity;
+  double loop_delay;
+  while (std::getline(stream, line)) {
+    boost::trim(line);
+    if (is_comment_or_empty_line(line) || parse_loop_instruction(line, periodicity, loop_delay))
+      continue;
+    res = boost::starts_with(line, "STOCHASTIC");
+    break;
+  }
+  stream.clear();
+  stream.seekg(0);
+  return res;
+}
+
 Profile* ProfileBuilder::from_string(const std::string& name, const std::string& input, double periodicity)
 {
   LegacyUpdateCb cb(input, periodicity);
@@ -227,17 +448,62 @@ Profile* ProfileBuilder::from_string(const std::string& name, const std::string&
 Profile* ProfileBuilder::from_file(const std::string& filename)
 {
   xbt_assert(not filename.empty(), "Cannot parse a trace from an empty filename");
-  auto f = std::unique_ptr<std::ifstream>(simgrid::xbt::path_ifsopen(filename));
-  xbt_assert(not f->fail(), "Cannot open file '%s' (path=%s)", filename.c_str(),
+  /* Many resources often use the same profile file, that is only loaded once */
+  if (auto* profile = Profile::by_name_or_null(filename))
+    return profile;
+
+  /* The deterministic profiles are opened again when read, even if the search path changed in between */
+  std::string path = simgrid::xbt::path_find(filename);
+  xbt_assert(not path.empty(), "Cannot open file '%s' (path=%s)", filename.c_str(),
              simgrid::xbt::path_to_string().c_str());
+  std::ifstream f(path);
+  xbt_assert(not f.fail(), "Cannot open file '%s': %s", path.c_str(), strerror(errno));
+
+  if (is_binary_profile(f)) {
+    f.close();
+    FILE* file = fopen(path.c_str(), "rb");
+    xbt_assert(file != nullptr, "Cannot open file '%s': %s", path.c_str(), strerror(errno));
+    return new Profile(filename, std::make_unique<BinaryEventSource>(file, filename));
+  }
+  /* Deterministic profiles are read as the simulation advances, while stochastic ones are small patterns */
+  if (not is_stochastic_profile(f))
+    return new Profile(filename, std::make_unique<TextEventSource>(path, filename));
 
   std::stringstream buffer;
-  buffer << f->rdbuf();
+  buffer << f.rdbuf();
 
   LegacyUpdateCb cb(buffer.str(), -1);
   return new Profile(filename, cb, cb.get_repeat_delay());
 }
 
+void ProfileBuilder::to_binary_file(const std::string& filename, const std::string& binary_filename)
+{
+  std::string path = simgrid::xbt::path_find(filename);
+  xbt_assert(not path.empty(), "Cannot open file '%s' (path=%s)", filename.c_str(),
+             simgrid::xbt::path_to_string().c_str());
+  std::ifstream f(path);
+  xbt_assert(not f.fail(), "Cannot open file '%s': %s", path.c_str(), strerror(errno));
+  xbt_assert(not is_binary_profile(f), "Profile '%s' is already in binary form", filename.c_str());
+  xbt_assert(not is_stochastic_profile(f), "Cannot convert the stochastic profile '%s' to the binary form",
+             filename.c_str());
+  f.close();
+
+  std::ofstream out(binary_filename, std::ios::binary | std::ios::trunc);
+  xbt_assert(out.good(), "Cannot open file '%s' for writing", binary_filename.c_str());
+  /* The events are streamed to the file, and the header is written once their amount is known */
+  BinaryProfileHeader header{BINARY_PROFILE_MAGIC, BINARY_PROFILE_VERSION, BYTE_ORDER_MARKER, -1.0, 0};
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  TextEventSource source(path, filename);
+  source.for_each_event([&out, &header](const DatedValue& event) {
+    out.write(reinterpret_cast<const char*>(&event), sizeof(event));
+    header.count++;
+  });
+  header.loop_delay = source.get_loop_delay();
+  out.seekp(0);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.close();
+  xbt_assert(not out.fail(), "Cannot write the binary profile '%s'", binary_filename.c_str());
+}
 
 Profile* ProfileBuilder::from_void() {
   static auto* void_profile = new Profile("__void__", nullptr, -1.0);
@@ -15,6 +15,9 @@
 #include "xbt/random.hpp"
 
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(unit, "Unit tests of the Trace Manager");
 
@@ -33,14 +36,11 @@ public:
 
 double MockedResource::the_date;
 
-static std::vector<simgrid::kernel::profile::DatedValue> trace2vector(const char* str)
+static std::vector<simgrid::kernel::profile::DatedValue> profile2vector(simgrid::kernel::profile::Profile* trace)
 {
   std::vector<simgrid::kernel::profile::DatedValue> res;
-  simgrid::kernel::profile::Profile* trace = simgrid::kernel::profile::ProfileBuilder::from_string("TheName", str, 0);
-  XBT_VERB("---------------------------------------------------------");
-  XBT_VERB("data>>\n%s<<data\n", str);
-  for (auto const& evt : trace->get_event_list())
-    XBT_VERB("event: d:%lg v:%lg", evt.date_, evt.value_);
+  trace->for_each_event(
+      [](const simgrid::kernel::profile::DatedValue& evt) { XBT_VERB("event: d:%lg v:%lg", evt.date_, evt.value_); });
 
   MockedResource daResource;
   simgrid::kernel::profile::FutureEvtSet fes;
@@ -66,6 +66,20 @@ static std::vector<simgrid::kernel::profile::DatedValue> trace2vector(const char
   return res;
 }
 
+static std::vector<simgrid::kernel::profile::DatedValue> visit_events(const simgrid::kernel::profile::Profile* profile)
+{
+  std::vector<simgrid::kernel::profile::DatedValue> res;
+  profile->for_each_event([&res](const simgrid::kernel::profile::DatedValue& evt) { res.push_back(evt); });
+  return res;
+}
+
+static std::vector<simgrid::kernel::profile::DatedValue> trace2vector(const char* str)
+{
+  XBT_VERB("---------------------------------------------------------");
+  XBT_VERB("data>>\n%s<<data\n", str);
+  return profile2vector(simgrid::kernel::profile::ProfileBuilder::from_string("TheName", str, 0));
+}
+
 TEST_CASE("kernel::profile: Resource profiles, defining the external load", "kernel::profile")
 {
   SECTION("No event, no loop")
@@ -211,3 +225,49 @@ TEST_CASE("kernel::profile: Resource profiles, defining the external load", "ker
     REQUIRE(want == got);
   }
 }
+
+TEST_CASE("kernel::profile: Profile files, read progressively or mapped in memory", "kernel::profile")
+{
+  using simgrid::kernel::profile::ProfileBuilder;
+  std::string path        = (std::filesystem::temp_directory_path() / "simgrid-profile-test.txt").string();
+  std::string binary_path = (std::filesystem::temp_directory_path() / "simgrid-profile-test.bin").string();
+
+  for (const char* str : {"", "9.0 3.0\n", "3.0 1.0\n5.0 2.0\n9.0 3.0\n", "# comment\n1.0 1.0\n3.0 3.0\nLOOPAFTER 2\n",
+                          "LOOPAFTER 5\n0.0 1\nDET 5.0 DET 2\n", "PERIODICITY 7\n1.0 1.0\n3.0 3.0\n"}) {
+    INFO("Profile: " << str);
+    std::vector<simgrid::kernel::profile::DatedValue> want = trace2vector(str);
+    std::ofstream(path) << str;
+
+    auto* profile = ProfileBuilder::from_file(path);
+    REQUIRE(ProfileBuilder::from_file(path) == profile); // shared by all users of that file
+    std::vector<simgrid::kernel::profile::DatedValue> events = visit_events(profile);
+    REQUIRE(profile2vector(profile) == want);
+
+    ProfileBuilder::to_binary_file(path, binary_path);
+    auto* binary = ProfileBuilder::from_file(binary_path);
+    REQUIRE(visit_events(binary) == events);
+    REQUIRE(profile2vector(binary) == want);
+  }
+
+  /* A longer profile, read in several chunks */
+  std::string str;
+  for (int i = 0; i < 10000; i++)
+    str += std::to_string(i * 0.001) + " " + std::to_string(i % 7) + "\n";
+  std::ofstream(path) << str;
+  REQUIRE(profile2vector(ProfileBuilder::from_file(path)) == trace2vector(str.c_str()));
+
+  /* The files are only open while they are read */
+  if (std::filesystem::exists("/proc/self/fd")) {
+    auto count_open_files = [] {
+      return std::distance(std::filesystem::directory_iterator("/proc/self/fd"), std::filesystem::directory_iterator());
+    };
+    auto open_files     = count_open_files();
+    const auto* profile = ProfileBuilder::from_file(path);
+    REQUIRE(count_open_files() == open_files);
+    REQUIRE(visit_events(profile).size() == 10000);
+    tmgr_finalize();
+  }
+
+  std::remove(path.c_str());
+  std::remove(binary_path.c_str());
+}
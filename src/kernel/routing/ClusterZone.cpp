@@ -8,10 +8,16 @@
 #include "simgrid/s4u/Host.hpp"
 #include "simgrid/s4u/Link.hpp"
 #include "src/kernel/resource/StandardLinkImpl.hpp"
+#include <xbt/config.hpp>
+
 #include <tuple>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_routing_cluster, ker_platform, "Kernel Cluster Routing");
 
+static simgrid::config::Flag<bool> cfg_lazy_cluster_links{
+    "routing/lazy-cluster-links",
+    "Only create the links of torus and dragonfly zones when a route first uses them (hosts remain eager)", false};
+
 /* This routing is specifically setup to represent clusters, aka homogeneous sets of machines
  * Note that a router is created, easing the interconnection with the rest of the world. */
 
@@ -46,6 +52,43 @@ void ClusterBase::add_private_link_at(unsigned long position,
   private_links_.try_emplace(position, link);
 }
 
+const std::pair<resource::StandardLinkImpl*, resource::StandardLinkImpl*>&
+ClusterBase::get_private_link_at(unsigned long position)
+{
+  auto link = private_links_.find(position);
+  if (link == private_links_.end() && lazy_links_) {
+    create_lazily([this, position] { create_lazy_links_at(position); });
+    link = private_links_.find(position);
+  }
+  xbt_assert(link != private_links_.end(), "%s: no private link at position %lu", get_cname(), position);
+  return link->second;
+}
+
+bool ClusterBase::lazy_links_requested()
+{
+  return cfg_lazy_cluster_links;
+}
+
+void ClusterBase::create_lazy_links_at(unsigned long position)
+{
+  unsigned long id     = position / num_links_per_node_;
+  unsigned long offset = position % num_links_per_node_;
+  unsigned long leaf   = get_leaf_position(id);
+  XBT_DEBUG("Lazily create the link at position %lu (leaf %lu, offset %lu) in %s", position, leaf, offset, get_cname());
+
+  if (has_loopback_ && offset == 0) {
+    s4u::Link* loopback = loopback_cb_(get_iface(), index_to_dims(leaf), leaf);
+    xbt_assert(loopback, "set_loopback: Invalid loopback link (nullptr) for element %lu", leaf);
+    loopback->seal();
+    add_private_link_at(position, {loopback->get_impl(), loopback->get_impl()});
+  } else if (has_limiter_ && offset == (has_loopback_ ? 1UL : 0UL)) {
+    s4u::Link* limiter = limiter_cb_(get_iface(), index_to_dims(leaf), leaf);
+    xbt_assert(limiter, "set_limiter: Invalid limiter link (nullptr) for element %lu", leaf);
+    limiter->seal();
+    add_private_link_at(position, {limiter->get_impl(), limiter->get_impl()});
+  }
+}
+
 void ClusterBase::set_gateway(unsigned long position, NetPoint* gateway)
 {
   xbt_assert(not gateway || not gateway->is_netzone(), "ClusterBase: gateway cannot be another netzone %s",
@@ -60,24 +103,24 @@ NetPoint* ClusterBase::get_gateway(unsigned long position)
 }
 
 
+std::vector<unsigned long> ClusterBase::index_to_dims(unsigned long index) const
+{
+  std::vector<unsigned long> dims_array(dims_.size());
+  for (auto i = static_cast<int>(dims_.size() - 1); i >= 0; --i) {
+    if (index == 0)
+      break;
+    unsigned long value = index % dims_[i];
+    dims_array[i]       = value;
+    index               = (index / dims_[i]);
+  }
+  return dims_array;
+}
+
 std::tuple<NetPoint*, s4u::Link*, s4u::Link*> ClusterBase::fill_leaf_from_cb(unsigned long position)
 {
   s4u::Link* loopback_res = nullptr;
   s4u::Link* limiter_res  = nullptr;
 
-  // auxiliary function to get dims from index
-  auto index_to_dims = [this](unsigned long index) {
-    std::vector<unsigned long> dims_array(dims_.size());
-    for (auto i = static_cast<int>(dims_.size() - 1); i >= 0; --i) {
-      if (index == 0)
-        break;
-      unsigned long value = index % dims_[i];
-      dims_array[i]      = value;
-      index              = (index / dims_[i]);
-    }
-    return dims_array;
-  };
-
   kernel::routing::NetPoint* netpoint = nullptr;
   kernel::routing::NetPoint* gw       = nullptr;
   auto dims                           = index_to_dims(position);
@@ -101,6 +144,15 @@ std::tuple<NetPoint*, s4u::Link*, s4u::Link*> ClusterBase::fill_leaf_from_cb(uns
   // setting gateway
   set_gateway(position, gw);
 
+  if (lazy_links_) { // Only remember where the links will go, create_lazy_links_at() builds them on need
+    if (loopback_cb_)
+      set_loopback();
+    if (limiter_cb_)
+      set_limiter();
+    leaf_positions_[netpoint->id()] = position;
+    return std::make_tuple(netpoint, loopback_res, limiter_res);
+  }
+
   if (loopback_cb_) {
     s4u::Link* loopback = loopback_cb_(get_iface(), dims, position);
     xbt_assert(loopback, "set_loopback: Invalid loopback link (nullptr) for element %lu", position);
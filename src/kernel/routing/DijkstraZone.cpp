@@ -5,80 +5,187 @@
 
 #include <simgrid/kernel/routing/DijkstraZone.hpp>
 #include <simgrid/kernel/routing/NetPoint.hpp>
+#include <xbt/config.hpp>
 #include <xbt/string.hpp>
 
 #include "src/kernel/resource/NetworkModel.hpp"
+#include "src/xbt/parallel.hpp"
 
-#include <climits>
-#include <queue>
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_routing_dijkstra, ker_platform, "Kernel Dijkstra Routing");
 
+static simgrid::config::Flag<bool> cfg_dijkstra_precompute{
+    "routing/dijkstra-precompute", "Compute the routes of all cached Dijkstra zones at seal time, in parallel", false};
+
 namespace simgrid {
 namespace kernel::routing {
 
-class GraphNodeData {
-public:
-  explicit GraphNodeData(unsigned long id) : id_(id) {}
-  unsigned long id_;
-  unsigned long graph_id_ = UINT_MAX; /* used for caching internal graph id's */
-};
+static constexpr uint64_t NO_ROUTE = std::numeric_limits<uint64_t>::max();
+static constexpr uint32_t NO_PRED  = std::numeric_limits<uint32_t>::max();
 
-void DijkstraZone::route_graph_delete(xbt_graph_t g)
+static uint64_t edge_key(unsigned long src_id, unsigned long dst_id)
 {
-  xbt_graph_free_graph(
-      g, [](void* n) { delete static_cast<GraphNodeData*>(n); }, [](void* e) { delete static_cast<Route*>(e); },
-      nullptr);
+  return (uint64_t{src_id} << 32) | dst_id;
 }
 
+namespace {
+/** Binary min-heap of graph nodes ordered by (cost, index), in which the cost of a queued node can be decreased */
+class IndexedHeap {
+  static constexpr uint32_t NOT_QUEUED = std::numeric_limits<uint32_t>::max();
+  const std::vector<uint64_t>& cost_;
+  std::vector<uint32_t> heap_;
+  std::vector<uint32_t> position_; // node -> its position in heap_
+
+  bool before(uint32_t a, uint32_t b) const { return cost_[a] < cost_[b] || (cost_[a] == cost_[b] && a < b); }
+  void place(size_t pos, uint32_t node)
+  {
+    heap_[pos]      = node;
+    position_[node] = static_cast<uint32_t>(pos);
+  }
+  void sift_up(size_t pos)
+  {
+    uint32_t node = heap_[pos];
+    while (pos > 0 && before(node, heap_[(pos - 1) / 2])) {
+      place(pos, heap_[(pos - 1) / 2]);
+      pos = (pos - 1) / 2;
+    }
+    place(pos, node);
+  }
+  void sift_down(size_t pos)
+  {
+    uint32_t node = heap_[pos];
+    while (2 * pos + 1 < heap_.size()) {
+      size_t child = 2 * pos + 1;
+      if (child + 1 < heap_.size() && before(heap_[child + 1], heap_[child]))
+        child++;
+      if (not before(heap_[child], node))
+        break;
+      place(pos, heap_[child]);
+      pos = child;
+    }
+    place(pos, node);
+  }
+
+public:
+  IndexedHeap(size_t size, const std::vector<uint64_t>& cost) : cost_(cost), position_(size, NOT_QUEUED) {}
+  bool empty() const { return heap_.empty(); }
+  /** Inserts the node, or moves it up if its cost was decreased since its insertion */
+  void update(uint32_t node)
+  {
+    if (position_[node] == NOT_QUEUED) {
+      heap_.push_back(node);
+      position_[node] = static_cast<uint32_t>(heap_.size() - 1);
+    }
+    sift_up(position_[node]);
+  }
+  uint32_t pop()
+  {
+    uint32_t top   = heap_.front();
+    position_[top] = NOT_QUEUED;
+    uint32_t last  = heap_.back();
+    heap_.pop_back();
+    if (not heap_.empty()) {
+      place(0, last);
+      sift_down(0);
+    }
+    return top;
+  }
+};
+} // namespace
+
 void DijkstraZone::do_seal()
 {
-  unsigned int cursor;
-  xbt_node_t node = nullptr;
-
   /* Add the loopback if needed */
   if (get_network_model()->loopback_ && get_hierarchy() == RoutingMode::base) {
-    xbt_dynar_foreach (xbt_graph_get_nodes(route_graph_.get()), cursor, node) {
-      bool found      = false;
-      xbt_edge_t edge = nullptr;
-      unsigned int cursor2;
-      xbt_dynar_foreach (xbt_graph_node_get_outedges(node), cursor2, edge) {
-        if (xbt_graph_edge_get_target(edge) == node) { // There is an edge from node to itself
-          found = true;
-          break;
-        }
-      }
-
-      if (not found) {
+    for (size_t i = 0; i < graph_nodes_.size(); i++) {
+      unsigned long id = graph_nodes_[i];
+      if (not declared_edges_.contains(edge_key(id, id))) {
         auto* route = new Route();
         route->link_list_.push_back(get_network_model()->loopback_.get());
-        xbt_graph_new_edge(route_graph_.get(), node, node, route);
+        new_edge(id, id, route);
       }
     }
   }
 
-  /* initialize graph indexes in nodes after graph has been built */
-  const_xbt_dynar_t nodes = xbt_graph_get_nodes(route_graph_.get());
+  /* Build the compressed adjacency. Within each node, the out-edges are kept in declaration order */
+  const size_t nr_nodes = graph_nodes_.size();
+  adj_offsets_.assign(nr_nodes + 1, 0);
+  for (auto const& [src_id, _] : edge_ends_)
+    adj_offsets_[graph_index_[src_id] + 1]++;
+  std::partial_sum(adj_offsets_.begin(), adj_offsets_.end(), adj_offsets_.begin());
+
+  adj_targets_.resize(edge_ends_.size());
+  adj_costs_.resize(edge_ends_.size());
+  adj_routes_.resize(edge_ends_.size());
+  std::vector<uint32_t> next_slot(adj_offsets_.begin(), adj_offsets_.end() - 1);
+  for (size_t e = 0; e < edge_ends_.size(); e++) {
+    uint32_t slot      = next_slot[graph_index_[edge_ends_[e].first]]++;
+    adj_targets_[slot] = static_cast<uint32_t>(graph_index_[edge_ends_[e].second]);
+    adj_routes_[slot]  = edge_routes_[e].get();
+    /* count of links, old model assume 1 */
+    adj_costs_[slot] = static_cast<uint32_t>(edge_routes_[e]->link_list_.size());
+  }
 
-  xbt_dynar_foreach (nodes, cursor, node) {
-    auto* data      = static_cast<GraphNodeData*>(xbt_graph_node_get_data(node));
-    data->graph_id_ = cursor;
+  route_cache_.clear();
+  if (cached_) {
+    route_cache_.resize(nr_nodes);
+    if (cfg_dijkstra_precompute) {
+      XBT_DEBUG("Precompute the routes of zone %s (%zu nodes)", get_cname(), nr_nodes);
+      xbt::parallel_for(nr_nodes, get_nthreads(), [this](size_t begin, size_t end) {
+        for (size_t src = begin; src < end; src++)
+          compute_predecessors(static_cast<uint32_t>(src), route_cache_[src]);
+      });
+    }
   }
 }
 
-xbt_node_t DijkstraZone::route_graph_new_node(unsigned long id)
+bool DijkstraZone::has_reentrant_routing() const
+{
+  /* Cache misses fill route_cache_, so the cached zones are reentrant only once every source was computed */
+  return not cached_ || std::none_of(route_cache_.begin(), route_cache_.end(),
+                                     [](const std::vector<uint32_t>& pred_arr) { return pred_arr.empty(); });
+}
+
+long DijkstraZone::get_graph_index(unsigned long id) const
 {
-  xbt_node_t node = xbt_graph_new_node(route_graph_.get(), new GraphNodeData(id));
-  graph_node_map_.emplace(id, node);
+  if (id >= graph_index_.size() || graph_index_[id] < 0 ||
+      graph_index_[id] + 1 >= static_cast<long>(adj_offsets_.size()))
+    return -1; // This NetPoint had no route when the zone was sealed
+  return graph_index_[id];
+}
 
-  return node;
+const Route* DijkstraZone::get_edge_route(uint32_t src, uint32_t dst) const
+{
+  for (uint32_t e = adj_offsets_[src]; e < adj_offsets_[src + 1]; e++)
+    if (adj_targets_[e] == dst)
+      return adj_routes_[e];
+  return nullptr;
 }
 
-xbt_node_t DijkstraZone::node_map_search(unsigned long id)
+void DijkstraZone::compute_predecessors(uint32_t src, std::vector<uint32_t>& pred_arr) const
 {
-  auto ret = graph_node_map_.find(id);
-  return ret == graph_node_map_.end() ? nullptr : ret->second;
+  const size_t nr_nodes = adj_offsets_.size() - 1;
+  std::vector<uint64_t> cost_arr(nr_nodes, NO_ROUTE); /* link cost from src to other hosts */
+  pred_arr.assign(nr_nodes, NO_PRED);                 /* predecessors in path from src */
+  IndexedHeap pqueue(nr_nodes, cost_arr);
+
+  cost_arr[src] = 0;
+  pqueue.update(src);
+  while (not pqueue.empty()) {
+    uint32_t v_id = pqueue.pop();
+    for (uint32_t e = adj_offsets_[v_id]; e < adj_offsets_[v_id + 1]; e++) {
+      uint32_t u_id = adj_targets_[e];
+      if (cost_arr[v_id] + adj_costs_[e] < cost_arr[u_id]) {
+        pred_arr[u_id] = v_id;
+        cost_arr[u_id] = cost_arr[v_id] + adj_costs_[e];
+        pqueue.update(u_id);
+      }
+    }
+  }
 }
 
 /* Parsing */
@@ -86,94 +193,39 @@ xbt_node_t DijkstraZone::node_map_search(unsigned long id)
 void DijkstraZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route* route, double* lat)
 {
   get_route_check_params(src, dst);
-  unsigned long src_id = src->id();
-  unsigned long dst_id = dst->id();
-
-  const_xbt_dynar_t nodes = xbt_graph_get_nodes(route_graph_.get());
 
-  /* Use the graph_node id mapping set to quickly find the nodes */
-  const s_xbt_node_t* src_elm = node_map_search(src_id);
-  const s_xbt_node_t* dst_elm = node_map_search(dst_id);
-
-  unsigned long src_node_id = static_cast<GraphNodeData*>(xbt_graph_node_get_data(src_elm))->graph_id_;
-  unsigned long dst_node_id = static_cast<GraphNodeData*>(xbt_graph_node_get_data(dst_elm))->graph_id_;
+  long src_index = get_graph_index(src->id());
+  long dst_index = get_graph_index(dst->id());
+  if (src_index < 0 || dst_index < 0)
+    throw std::invalid_argument(xbt::string_printf("No route from '%s' to '%s'", src->get_cname(), dst->get_cname()));
+  auto src_node_id = static_cast<uint32_t>(src_index);
+  auto dst_node_id = static_cast<uint32_t>(dst_index);
 
   /* if the src and dst are the same */
   if (src_node_id == dst_node_id) {
-    const s_xbt_node_t* node_s_v = xbt_dynar_get_as(nodes, src_node_id, xbt_node_t);
-    const s_xbt_node_t* node_e_v = xbt_dynar_get_as(nodes, dst_node_id, xbt_node_t);
-    const s_xbt_edge_t* edge     = xbt_graph_get_edge(route_graph_.get(), node_s_v, node_e_v);
+    const Route* e_route = get_edge_route(src_node_id, dst_node_id);
 
-    if (edge == nullptr)
+    if (e_route == nullptr)
       throw std::invalid_argument(xbt::string_printf("No route from '%s' to '%s'", src->get_cname(), dst->get_cname()));
 
-    const Route* e_route = static_cast<Route*>(xbt_graph_edge_get_data(edge));
-
     insert_link_latency(route->link_list_, e_route->link_list_, lat);
   }
 
-  auto [elm, inserted]                 = route_cache_.try_emplace(src_id);
-  std::vector<unsigned long>& pred_arr = elm->second;
-
-  if (inserted) { /* new element was inserted (not cached mode, or cache miss) */
-    unsigned long nr_nodes = xbt_dynar_length(nodes);
-    std::vector<unsigned long> cost_arr(nr_nodes); /* link cost from src to other hosts */
-    pred_arr.resize(nr_nodes);              /* predecessors in path from src */
-    using Qelt = std::pair<double, unsigned long>;
-    std::priority_queue<Qelt, std::vector<Qelt>, std::greater<>> pqueue;
-
-    /* initialize */
-    cost_arr[src_node_id] = 0;
-
-    for (unsigned long i = 0; i < nr_nodes; i++) {
-      if (i != src_node_id) {
-        cost_arr[i] = ULONG_MAX;
-      }
-
-      pred_arr[i] = 0;
-
-      /* initialize priority queue */
-      pqueue.emplace(cost_arr[i], i);
-    }
-
-    /* apply dijkstra using the indexes from the graph's node array */
-    while (not pqueue.empty()) {
-      unsigned long v_id = pqueue.top().second;
-      pqueue.pop();
-      const s_xbt_node_t* v_node = xbt_dynar_get_as(nodes, v_id, xbt_node_t);
-      xbt_edge_t edge            = nullptr;
-      unsigned int cursor;
-
-      xbt_dynar_foreach (xbt_graph_node_get_outedges(v_node), cursor, edge) {
-        const s_xbt_node_t* u_node           = xbt_graph_edge_get_target(edge);
-        const GraphNodeData* data            = static_cast<GraphNodeData*>(xbt_graph_node_get_data(u_node));
-        unsigned long u_id                   = data->graph_id_;
-        const Route* tmp_e_route             = static_cast<Route*>(xbt_graph_edge_get_data(edge));
-        unsigned long cost_v_u               = tmp_e_route->link_list_.size(); /* count of links, old model assume 1 */
-
-        if (cost_v_u + cost_arr[v_id] < cost_arr[u_id]) {
-          pred_arr[u_id] = v_id;
-          cost_arr[u_id] = cost_v_u + cost_arr[v_id];
-          pqueue.emplace(cost_arr[u_id], u_id);
-        }
-      }
-    }
-  }
+  std::vector<uint32_t> uncached_pred_arr;
+  std::vector<uint32_t>& pred_arr = cached_ ? route_cache_[src_node_id] : uncached_pred_arr;
+  if (pred_arr.empty()) /* not cached mode, or cache miss */
+    compute_predecessors(src_node_id, pred_arr);
 
   /* compose route path with links */
   NetPoint* gw_src   = nullptr;
   NetPoint* first_gw = nullptr;
 
-  for (unsigned long v = dst_node_id; v != src_node_id; v = pred_arr[v]) {
-    const s_xbt_node_t* node_pred_v = xbt_dynar_get_as(nodes, pred_arr[v], xbt_node_t);
-    const s_xbt_node_t* node_v      = xbt_dynar_get_as(nodes, v, xbt_node_t);
-    const s_xbt_edge_t* edge        = xbt_graph_get_edge(route_graph_.get(), node_pred_v, node_v);
+  for (uint32_t v = dst_node_id; v != src_node_id; v = pred_arr[v]) {
+    const Route* e_route = pred_arr[v] == NO_PRED ? nullptr : get_edge_route(pred_arr[v], v);
 
-    if (edge == nullptr)
+    if (e_route == nullptr)
       throw std::invalid_argument(xbt::string_printf("No route from '%s' to '%s'", src->get_cname(), dst->get_cname()));
 
-    const Route* e_route = static_cast<Route*>(xbt_graph_edge_get_data(edge));
-
     const NetPoint* prev_gw_src = gw_src;
     gw_src                      = e_route->gw_src_;
     NetPoint* gw_dst            = e_route->gw_dst_;
@@ -199,9 +251,6 @@ void DijkstraZone::get_local_route(const NetPoint* src, const NetPoint* dst, Rou
     route->gw_src_ = gw_src;
     route->gw_dst_ = first_gw;
   }
-
-  if (not cached_)
-    route_cache_.clear();
 }
 
 void DijkstraZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoint* gw_dst,
@@ -217,21 +266,13 @@ void DijkstraZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, Net
              new_extended_route(get_hierarchy(), gw_dst, gw_src, get_link_list_impl(link_list, true), false));
 }
 
-void DijkstraZone::new_edge(unsigned long src_id, unsigned long dst_id, Route* route)
+void DijkstraZone::new_edge(unsigned long src_id, unsigned long dst_id, Route* e_route)
 {
   XBT_DEBUG("Create Route from '%lu' to '%lu'", src_id, dst_id);
-
-  // Get the extremities, or create them if they don't exist yet
-  xbt_node_t src = node_map_search(src_id);
-  if (src == nullptr)
-    src = route_graph_new_node(src_id);
-
-  xbt_node_t dst = node_map_search(dst_id);
-  if (dst == nullptr)
-    dst = route_graph_new_node(dst_id);
+  std::unique_ptr<Route> route(e_route);
 
   // Make sure that this graph edge was not already added to the graph
-  if (xbt_graph_get_edge(route_graph_.get(), src, dst) != nullptr) {
+  if (declared_edges_.contains(edge_key(src_id, dst_id))) {
     if (route->gw_dst_ == nullptr || route->gw_src_ == nullptr)
       throw std::invalid_argument(
           xbt::string_printf("Route from %s to %s already exists", route->src_->get_cname(), route->dst_->get_cname()));
@@ -241,8 +282,20 @@ void DijkstraZone::new_edge(unsigned long src_id, unsigned long dst_id, Route* r
                                                      route->dst_->get_cname(), route->gw_dst_->get_cname()));
   }
 
+  // Get the extremities, or create them if they don't exist yet
+  for (unsigned long id : {src_id, dst_id}) {
+    if (id >= graph_index_.size())
+      graph_index_.resize(id + 1, -1);
+    if (graph_index_[id] < 0) {
+      graph_index_[id] = static_cast<long>(graph_nodes_.size());
+      graph_nodes_.push_back(id);
+    }
+  }
+
   // Finally add it
-  xbt_graph_new_edge(route_graph_.get(), src, dst, route);
+  declared_edges_.insert(edge_key(src_id, dst_id));
+  edge_ends_.emplace_back(src_id, dst_id);
+  edge_routes_.push_back(std::move(route));
 }
 } // namespace kernel::routing
 
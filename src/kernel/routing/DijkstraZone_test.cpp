@@ -38,3 +38,38 @@ TEST_CASE("kernel::routing::DijkstraZone (not cached): mix new routes and hosts"
     REQUIRE_NOTHROW(zone->add_route(cpu, nic,{link}));
   }
 }
+
+TEST_CASE("kernel::routing::DijkstraZone: routes on a ring", "")
+{
+  simgrid::s4u::Engine e("test");
+  SECTION("Routes computed on need")
+  {
+    simgrid::s4u::Engine::set_config("routing/dijkstra-precompute", false);
+  }
+  SECTION("Routes computed at seal time")
+  {
+    simgrid::s4u::Engine::set_config("routing/dijkstra-precompute", true);
+  }
+  auto* zone = e.get_netzone_root()->add_netzone_dijkstra("test", true);
+
+  const int ring_size = 10;
+  std::vector<const simgrid::s4u::Host*> hosts;
+  for (int i = 0; i < ring_size; i++)
+    hosts.push_back(zone->add_host("host" + std::to_string(i), 1e9));
+  for (int i = 0; i < ring_size; i++) {
+    const simgrid::s4u::Link* link = zone->add_link("link" + std::to_string(i), 1e6);
+    zone->add_route(hosts[i], hosts[(i + 1) % ring_size], {link});
+  }
+  zone->seal();
+
+  for (int dst : {1, 3, 6, 9}) {
+    std::vector<simgrid::s4u::Link*> links;
+    hosts[0]->route_to(hosts[dst], links, nullptr);
+    REQUIRE(links.size() == static_cast<size_t>(std::min(dst, ring_size - dst)));
+  }
+  std::vector<simgrid::s4u::Link*> links;
+  hosts[2]->route_to(hosts[0], links, nullptr);
+  REQUIRE(links.size() == 2);
+  REQUIRE(links.front()->get_name() == "link1");
+  REQUIRE(links.back()->get_name() == "link0");
+}
@@ -213,8 +213,9 @@ void DragonflyZone::get_local_route(const NetPoint* src, const NetPoint* dst, Ro
     return;
   }
 
-  const auto myCoords     = rankId_to_coords(src->id());
-  const auto targetCoords = rankId_to_coords(dst->id());
+  xbt_assert(std::max(src->id(), dst->id()) < node_coords_.size(), "Dragonfly %s: unknown node", get_cname());
+  const Coords& myCoords     = node_coords_[src->id()];
+  const Coords& targetCoords = node_coords_[dst->id()];
   XBT_DEBUG("src : %lu group, %lu chassis, %lu blade, %lu node", myCoords.group, myCoords.chassis, myCoords.blade,
             myCoords.node);
   XBT_DEBUG("dst : %lu group, %lu chassis, %lu blade, %lu node", targetCoords.group, targetCoords.chassis,
@@ -297,11 +298,17 @@ void DragonflyZone::get_local_route(const NetPoint* src, const NetPoint* dst, Ro
 
 void DragonflyZone::do_seal()
 {
-  /* populating it */
+  /* populating it (only the loopback and limiter links of the nodes can be lazy, the routers' links are needed here) */
+  set_lazy_links(lazy_links_requested());
   for (int i = 0; i < get_tot_elements(); i++)
     fill_leaf_from_cb(i);
 
   build_upper_levels();
+
+  /* Precompute the coordinates of every node, so that routing does not need to decompose the ids again */
+  node_coords_.resize(get_table_size());
+  for (unsigned long id = 0; id < node_coords_.size(); id++)
+    node_coords_[id] = rankId_to_coords(id);
 }
 
 } // namespace kernel::routing
@@ -48,15 +48,13 @@ void FatTreeZone::get_local_route(const NetPoint* src, const NetPoint* dst, Rout
     return;
 
   /* Let's find the source and the destination in our internal structure */
-  auto searchedNode = this->compute_nodes_.find(src->id());
-  xbt_assert(searchedNode != this->compute_nodes_.end(), "Could not find the source %s [%lu] in the fat tree",
-             src->get_cname(), src->id());
-  const FatTreeNode* source = searchedNode->second.get();
+  xbt_assert(src->id() < compute_nodes_by_id_.size() && compute_nodes_by_id_[src->id()] != nullptr,
+             "Could not find the source %s [%lu] in the fat tree", src->get_cname(), src->id());
+  const FatTreeNode* source = compute_nodes_by_id_[src->id()];
 
-  searchedNode = this->compute_nodes_.find(dst->id());
-  xbt_assert(searchedNode != this->compute_nodes_.end(), "Could not find the destination %s [%lu] in the fat tree",
-             dst->get_cname(), dst->id());
-  const FatTreeNode* destination = searchedNode->second.get();
+  xbt_assert(dst->id() < compute_nodes_by_id_.size() && compute_nodes_by_id_[dst->id()] != nullptr,
+             "Could not find the destination %s [%lu] in the fat tree", dst->get_cname(), dst->id());
+  const FatTreeNode* destination = compute_nodes_by_id_[dst->id()];
 
   XBT_VERB("Get route and latency from '%s' [%lu] to '%s' [%lu] in a fat tree", src->get_cname(), src->id(),
            dst->get_cname(), dst->id());
@@ -71,11 +69,8 @@ void FatTreeZone::get_local_route(const NetPoint* src, const NetPoint* dst, Rout
 
   // up part
   while (not is_in_sub_tree(currentNode, destination)) {
-    int d = destination->position; // as in d-mod-k
-
-    for (unsigned int i = 0; i < currentNode->level; i++)
-      d /= this->num_parents_per_node_[i];
-
+    // as in d-mod-k
+    int d = destination->position / this->parent_strides_[currentNode->level];
     int k = this->num_parents_per_node_[currentNode->level] * this->num_port_lower_level_[currentNode->level];
     d     = d % k;
 
@@ -141,6 +136,16 @@ void FatTreeZone::do_seal()
   }
   build_upper_levels();
 
+  /* Precompute what routing needs, so that it does not have to search or to divide repeatedly */
+  for (auto const& [id, node] : compute_nodes_) {
+    if (compute_nodes_by_id_.size() <= id)
+      compute_nodes_by_id_.resize(id + 1, nullptr);
+    compute_nodes_by_id_[id] = node.get();
+  }
+  parent_strides_.assign(levels_ + 1, 1);
+  for (unsigned int i = 0; i < levels_; i++)
+    parent_strides_[i + 1] = parent_strides_[i] * num_parents_per_node_[i];
+
   if (this->levels_ == 0) {
     return;
   }
@@ -8,29 +8,21 @@
 #include <xbt/string.hpp>
 
 #include "src/kernel/resource/NetworkModel.hpp"
+#include "src/xbt/parallel.hpp"
 
-#include <climits>
+#include <barrier>
+#include <limits>
+#include <utility>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_routing_floyd, ker_platform, "Kernel Floyd Routing");
 
 namespace simgrid {
 namespace kernel::routing {
 
-void FloydZone::init_tables(unsigned int table_size)
-{
-  if (link_table_.size() != table_size) {
-    /* Resize and initialize Cost, Predecessor and Link tables */
-    cost_table_.resize(table_size);
-    link_table_.resize(table_size);
-    predecessor_table_.resize(table_size);
-    for (auto& cost : cost_table_)
-      cost.resize(table_size, ULONG_MAX); /* link cost from host to host */
-    for (auto& link : link_table_)
-      link.resize(table_size); /* actual link between src and dst */
-    for (auto& predecessor : predecessor_table_)
-      predecessor.resize(table_size, -1); /* predecessor host numbers */
-  }
-}
+/* Marks the absence of path in the cost table */
+static constexpr uint32_t NO_ROUTE = std::numeric_limits<uint32_t>::max();
+/* Smaller zones are not worth spawning threads when relaxing the paths */
+static constexpr unsigned long PARALLEL_THRESHOLD = 256;
 
 void FloydZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route* route, double* lat)
 {
@@ -38,12 +30,15 @@ void FloydZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
 
   /* create a result route */
   std::vector<Route*> route_stack;
-  unsigned long cur = dst->id();
+  const unsigned long table_size = get_table_size();
+  unsigned long cur              = dst->id();
   do {
-    long pred = predecessor_table_[src->id()][cur];
+    int32_t pred = predecessor_table_.size() == table_size * table_size
+                       ? predecessor_table_[src->id() * table_size + cur]
+                       : -1; // not sealed yet
     if (pred == -1)
       throw std::invalid_argument(xbt::string_printf("No route from '%s' to '%s'", src->get_cname(), dst->get_cname()));
-    route_stack.push_back(link_table_[pred][cur].get());
+    route_stack.push_back(link_table_.at(route_key(pred, cur)).get());
     cur = pred;
   } while (cur != src->id());
 
@@ -70,35 +65,29 @@ void FloydZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
 void FloydZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoint* gw_dst,
                           const std::vector<s4u::LinkInRoute>& link_list, bool symmetrical)
 {
-  /* set the size of table routing */
-  unsigned int table_size = get_table_size();
-  init_tables(table_size);
-
   add_route_check_params(src, dst, gw_src, gw_dst, link_list, symmetrical);
 
   /* Check that the route does not already exist */
   if (gw_dst && gw_src) // netzone route (to adapt the error message, if any)
-    xbt_assert(nullptr == link_table_[src->id()][dst->id()],
+    xbt_assert(not link_table_.contains(route_key(src->id(), dst->id())),
                "The route between %s@%s and %s@%s already exists (Rq: routes are symmetrical by default).",
                src->get_cname(), gw_src->get_cname(), dst->get_cname(), gw_dst->get_cname());
   else
-    xbt_assert(nullptr == link_table_[src->id()][dst->id()],
+    xbt_assert(not link_table_.contains(route_key(src->id(), dst->id())),
                "The route between %s and %s already exists (Rq: routes are symmetrical by default).", src->get_cname(),
                dst->get_cname());
 
-  link_table_[src->id()][dst->id()] = std::unique_ptr<Route>(
+  link_table_[route_key(src->id(), dst->id())] = std::unique_ptr<Route>(
       new_extended_route(get_hierarchy(), gw_src, gw_dst, get_link_list_impl(link_list, false), true));
-  predecessor_table_[src->id()][dst->id()] = src->id();
-  cost_table_[src->id()][dst->id()]        = link_table_[src->id()][dst->id()]->link_list_.size();
 
   if (symmetrical) {
     if (gw_dst && gw_src) // netzone route (to adapt the error message, if any)
       xbt_assert(
-          nullptr == link_table_[dst->id()][src->id()],
+          not link_table_.contains(route_key(dst->id(), src->id())),
           "The route between %s@%s and %s@%s already exists. You should not declare the reverse path as symmetrical.",
           dst->get_cname(), gw_dst->get_cname(), src->get_cname(), gw_src->get_cname());
     else
-      xbt_assert(nullptr == link_table_[dst->id()][src->id()],
+      xbt_assert(not link_table_.contains(route_key(dst->id(), src->id())),
                  "The route between %s and %s already exists in zone %s. You should not declare the reverse path as "
                  "symmetrical.",
                  dst->get_cname(), src->get_cname(), get_cname());
@@ -115,44 +104,80 @@ void FloydZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoi
       XBT_DEBUG("Load NetzoneRoute from \"%s(%s)\" to \"%s(%s)\"", dst->get_cname(), gw_src->get_cname(),
                 src->get_cname(), gw_dst->get_cname());
 
-    link_table_[dst->id()][src->id()] = std::unique_ptr<Route>(
+    link_table_[route_key(dst->id(), src->id())] = std::unique_ptr<Route>(
         new_extended_route(get_hierarchy(), gw_src, gw_dst, get_link_list_impl(link_list, true), false));
-    predecessor_table_[dst->id()][src->id()] = dst->id();
-    cost_table_[dst->id()][src->id()] =
-        link_table_[dst->id()][src->id()]->link_list_.size(); /* count of links, old model assume 1 */
+  }
+}
+
+void FloydZone::relax_rows(std::vector<uint32_t>& cost_table, unsigned long pivot, unsigned long first,
+                           unsigned long last)
+{
+  /* Neither the pivot row nor the pivot column can be modified by this step (costs are non-negative), so several
+   * threads can relax disjoint blocks of rows concurrently and get the exact same result than a sequential loop */
+  const unsigned long table_size = get_table_size();
+  const uint32_t* pivot_cost     = &cost_table[pivot * table_size];
+  const int32_t* pivot_pred      = &predecessor_table_[pivot * table_size];
+  for (unsigned long a = first; a < last; a++) {
+    const uint64_t cost_to_pivot = cost_table[a * table_size + pivot];
+    if (cost_to_pivot == NO_ROUTE)
+      continue;
+    uint32_t* row_cost = &cost_table[a * table_size];
+    int32_t* row_pred  = &predecessor_table_[a * table_size];
+    for (unsigned long b = 0; b < table_size; b++) {
+      if (pivot_cost[b] != NO_ROUTE && cost_to_pivot + pivot_cost[b] < row_cost[b]) {
+        row_cost[b] = static_cast<uint32_t>(cost_to_pivot + pivot_cost[b]);
+        row_pred[b] = pivot_pred[b];
+      }
+    }
   }
 }
 
 void FloydZone::do_seal()
 {
-  /* set the size of table routing */
-  unsigned int table_size = get_table_size();
-  init_tables(table_size);
+  const unsigned long table_size = get_table_size();
+  xbt_assert(table_size < static_cast<unsigned long>(std::numeric_limits<int32_t>::max()),
+             "Too many vertices in zone %s for the Floyd routing", get_cname());
 
   /* Add the loopback if needed */
   if (get_network_model()->loopback_ && get_hierarchy() == RoutingMode::base) {
-    for (unsigned int i = 0; i < table_size; i++) {
-      auto& route = link_table_[i][i];
+    for (unsigned long i = 0; i < table_size; i++) {
+      auto& route = link_table_[route_key(i, i)];
       if (not route) {
         route.reset(new Route());
         route->link_list_.push_back(get_network_model()->loopback_.get());
-        predecessor_table_[i][i] = i;
-        cost_table_[i][i]        = 1;
       }
     }
   }
-  /* Calculate path costs */
-  for (unsigned int c = 0; c < table_size; c++) {
-    for (unsigned int a = 0; a < table_size; a++) {
-      for (unsigned int b = 0; b < table_size; b++) {
-        if (cost_table_[a][c] < ULONG_MAX && cost_table_[c][b] < ULONG_MAX &&
-            (cost_table_[a][b] == ULONG_MAX || (cost_table_[a][c] + cost_table_[c][b] < cost_table_[a][b]))) {
-          cost_table_[a][b]        = cost_table_[a][c] + cost_table_[c][b];
-          predecessor_table_[a][b] = predecessor_table_[c][b];
-        }
-      }
-    }
+
+  /* The predecessors that were loaded from a platform snapshot are still valid, as long as no vertex was added */
+  if (std::exchange(restored_predecessors_, false) && predecessor_table_.size() == table_size * table_size) {
+    XBT_DEBUG("Reuse the predecessors of zone %s (%lu vertices) from the platform snapshot", get_cname(), table_size);
+    return;
   }
+
+  /* Initialize the Cost and Predecessor tables from the one-hop routes. The cost is the count of links (the old model
+   * assumed 1). The cost table is only needed during the relaxation. */
+  std::vector<uint32_t> cost_table(table_size * table_size, NO_ROUTE);
+  predecessor_table_.assign(table_size * table_size, -1);
+  for (auto const& [key, route] : link_table_) {
+    unsigned long src                          = key >> 32;
+    unsigned long dst                          = key & 0xffffffffUL;
+    cost_table[src * table_size + dst]         = static_cast<uint32_t>(route->link_list_.size());
+    predecessor_table_[src * table_size + dst] = static_cast<int32_t>(src);
+  }
+
+  /* Calculate path costs, each thread taking care of a contiguous block of rows */
+  unsigned nthreads = table_size < PARALLEL_THRESHOLD ? 1 : get_nthreads();
+  XBT_DEBUG("Relax the paths of zone %s (%lu vertices) with %u thread(s)", get_cname(), table_size, nthreads);
+  std::barrier sync(nthreads);
+  xbt::parallel_run(nthreads, [this, &cost_table, &sync, table_size](unsigned rank, unsigned nworkers) {
+    const unsigned long first = table_size * rank / nworkers;
+    const unsigned long last  = table_size * (rank + 1) / nworkers;
+    for (unsigned long c = 0; c < table_size; c++) {
+      relax_rows(cost_table, c, first, last);
+      sync.arrive_and_wait();
+    }
+  });
 }
 } // namespace kernel::routing
 
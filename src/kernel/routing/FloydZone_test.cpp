@@ -24,3 +24,114 @@ TEST_CASE("kernel::routing::FloydZone: mix new routes and hosts", "")
     REQUIRE_NOTHROW(zone->add_route(cpu, nic, {link}));
   }
 }
+
+TEST_CASE("kernel::routing::FloydZone: parallel relaxation on a ring", "")
+{
+  simgrid::s4u::Engine e("test");
+  simgrid::s4u::Engine::set_config("routing/nthreads:4");
+  auto* zone = e.get_netzone_root()->add_netzone_floyd("test");
+
+  const int ring_size = 300; // large enough to use several threads
+  std::vector<const simgrid::s4u::Host*> hosts;
+  for (int i = 0; i < ring_size; i++)
+    hosts.push_back(zone->add_host("host" + std::to_string(i), 1e9));
+  for (int i = 0; i < ring_size; i++) {
+    const simgrid::s4u::Link* link = zone->add_link("link" + std::to_string(i), 1e6);
+    zone->add_route(hosts[i], hosts[(i + 1) % ring_size], {link});
+  }
+  zone->seal();
+
+  for (int dst : {1, 42, 150, 151, 299}) {
+    std::vector<simgrid::s4u::Link*> links;
+    hosts[0]->route_to(hosts[dst], links, nullptr);
+    REQUIRE(links.size() == static_cast<size_t>(std::min(dst, ring_size - dst)));
+  }
+  std::vector<simgrid::s4u::Link*> links;
+  hosts[0]->route_to(hosts[299], links, nullptr);
+  REQUIRE(links.front()->get_name() == "link299");
+}
+
+TEST_CASE("kernel::routing::FloydZone: batched route queries", "")
+{
+  simgrid::s4u::Engine e("test");
+  simgrid::s4u::Engine::set_config("routing/nthreads:4");
+  auto* zone = e.get_netzone_root()->add_netzone_floyd("test");
+
+  const int ring_size = 20;
+  std::vector<simgrid::s4u::Host*> hosts;
+  for (int i = 0; i < ring_size; i++)
+    hosts.push_back(zone->add_host("host" + std::to_string(i), 1e9));
+  for (int i = 0; i < ring_size; i++) {
+    const simgrid::s4u::Link* link = zone->add_link("link" + std::to_string(i), 1e6)->set_latency(1);
+    zone->add_route(hosts[i], hosts[(i + 1) % ring_size], {link});
+  }
+  zone->seal();
+
+  std::vector<std::pair<const simgrid::s4u::Host*, const simgrid::s4u::Host*>> pairs;
+  for (int dst = 1; dst < ring_size; dst++)
+    pairs.emplace_back(hosts[0], hosts[dst]);
+  auto routes = e.get_routes(pairs);
+  REQUIRE(routes.size() == pairs.size());
+  for (size_t i = 0; i < pairs.size(); i++) {
+    auto [links, latency] = pairs[i].first->route_to(pairs[i].second);
+    REQUIRE(routes[i].first == links);
+    REQUIRE(routes[i].second == latency);
+  }
+
+  auto latencies = e.get_latency_matrix(hosts);
+  REQUIRE(latencies.size() == hosts.size() * hosts.size());
+  for (int src = 0; src < ring_size; src++)
+    for (int dst = 0; dst < ring_size; dst++) {
+      int hops = (dst - src + ring_size) % ring_size;
+      REQUIRE(latencies[src * ring_size + dst] == std::min(hops, ring_size - hops));
+    }
+}
+
+/* Builds rings of different sizes below a Dijkstra zone, seals everything and describes the outcome */
+static std::vector<std::string> seal_rings(const std::string& nthreads)
+{
+  static std::vector<std::string> sealed_zones;
+  static const bool connected = [] {
+    simgrid::s4u::NetZone::on_seal_cb(
+        [](simgrid::s4u::NetZone const& zone) { sealed_zones.push_back(zone.get_name()); });
+    return true;
+  }();
+  REQUIRE(connected);
+  sealed_zones.clear();
+
+  simgrid::s4u::Engine e("test");
+  simgrid::s4u::Engine::set_config("routing/nthreads:" + nthreads);
+
+  auto* top = e.get_netzone_root()->add_netzone_dijkstra("top", false);
+  std::vector<simgrid::s4u::NetZone*> rings;
+  for (int r = 0; r < 6; r++) {
+    auto* ring          = rings.emplace_back(top->add_netzone_floyd("ring" + std::to_string(r)));
+    const int ring_size = 10 + 5 * r;
+    std::vector<const simgrid::s4u::Host*> hosts;
+    for (int i = 0; i < ring_size; i++)
+      hosts.push_back(ring->add_host("host" + std::to_string(r) + "-" + std::to_string(i), 1e9));
+    for (int i = 0; i < ring_size; i++) {
+      const auto* link = ring->add_link("link" + std::to_string(r) + "-" + std::to_string(i), 1e6);
+      ring->add_route(hosts[i], hosts[(i + 1) % ring_size], {link});
+    }
+    ring->set_gateway(hosts[0]);
+  }
+  for (int r = 1; r < 6; r++)
+    top->add_route(rings[r - 1], rings[r], {top->add_link("wan" + std::to_string(r), 1e9)});
+  e.get_netzone_root()->seal(); // Engine::seal_platform() only seals the first engine of the process
+
+  std::vector<std::string> res = sealed_zones; // the signals must come in the same order
+
+  for (int r = 0; r < 6; r++) {
+    std::vector<simgrid::s4u::Link*> links;
+    e.host_by_name("host0-3")->route_to(e.host_by_name("host" + std::to_string(r) + "-7"), links, nullptr);
+    res.push_back(std::to_string(links.size()) + " links to ring " + std::to_string(r));
+  }
+  return res;
+}
+
+TEST_CASE("kernel::routing::FloydZone: several zones sealed concurrently", "")
+{
+  auto expected = seal_rings("1");
+  REQUIRE(seal_rings("4") == expected);
+}
@@ -8,47 +8,88 @@
 
 #include "src/kernel/resource/NetworkModel.hpp"
 
+#include <algorithm>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_routing_full, ker_platform, "Kernel Full Routing");
 
 namespace simgrid {
 namespace kernel::routing {
 
+size_t FullZone::RouteHash::operator()(const Route* route) const
+{
+  auto combine = [](size_t seed, const void* ptr) {
+    return seed ^ (std::hash<const void*>()(ptr) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+  };
+  size_t seed = combine(combine(route->link_list_.size(), route->gw_src_), route->gw_dst_);
+  for (const auto* link : route->link_list_)
+    seed = combine(seed, link);
+  return seed;
+}
+
+bool FullZone::RouteEqual::operator()(const Route* a, const Route* b) const
+{
+  return a->gw_src_ == b->gw_src_ && a->gw_dst_ == b->gw_dst_ && a->link_list_ == b->link_list_;
+}
+
 void FullZone::check_routing_table()
 {
-  unsigned int table_size = get_table_size();
-  /* assure routing_table is table_size X table_size */
-  if (routing_table_.size() != table_size) {
-    routing_table_.resize(table_size);
-    for (auto& j : routing_table_) {
-      j.resize(table_size);
-    }
+  unsigned long table_size = get_table_size();
+  /* assure routing_table is at least table_size X table_size. Grow it geometrically, as it is laid out again each time */
+  if (table_stride_ < table_size) {
+    unsigned long new_stride = std::max(table_size, 2 * table_stride_);
+    std::vector<uint32_t> new_table(new_stride * new_stride, 0);
+    for (unsigned long src = 0; src < table_stride_; src++)
+      std::copy_n(&routing_table_[src * table_stride_], table_stride_, &new_table[src * new_stride]);
+    routing_table_ = std::move(new_table);
+    table_stride_  = new_stride;
   }
 }
 
+uint32_t FullZone::intern_route(Route* route)
+{
+  std::unique_ptr<Route> new_route(route);
+  auto [elm, inserted] = route_index_.try_emplace(new_route.get(), static_cast<uint32_t>(distinct_routes_.size()));
+  if (inserted)
+    distinct_routes_.push_back(std::move(new_route));
+  return elm->second + 1;
+}
+
 void FullZone::do_seal()
 {
   check_routing_table();
   /* Add the loopback if needed */
   if (get_network_model()->loopback_ && get_hierarchy() == RoutingMode::base) {
     for (unsigned int i = 0; i < get_table_size(); i++) {
-      auto& route = routing_table_[i][i];
-      if (not route) {
-        route.reset(new Route());
+      if (table_entry(i, i) == 0) {
+        auto* route = new Route();
         route->link_list_.push_back(get_network_model()->loopback_.get());
+        table_entry(i, i) = intern_route(route);
       }
     }
   }
+
+  /* Release the spare rows and columns that were preallocated to add new elements */
+  unsigned long table_size = get_table_size();
+  if (table_stride_ != table_size) {
+    std::vector<uint32_t> new_table(table_size * table_size);
+    for (unsigned long src = 0; src < table_size; src++)
+      std::copy_n(&routing_table_[src * table_stride_], table_size, &new_table[src * table_size]);
+    routing_table_ = std::move(new_table);
+    table_stride_  = table_size;
+  }
+  XBT_DEBUG("Zone %s: %zu distinct routes for %lu elements", get_cname(), distinct_routes_.size(), table_size);
 }
 
 void FullZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route* res, double* lat)
 {
   XBT_DEBUG("full getLocalRoute from %s[%lu] to %s[%lu]", src->get_cname(), src->id(), dst->get_cname(), dst->id());
 
-  const auto& e_route = routing_table_[src->id()][dst->id()];
+  uint32_t entry = src->id() < table_stride_ && dst->id() < table_stride_ ? table_entry(src->id(), dst->id()) : 0;
 
-  if (e_route != nullptr) {
-    res->gw_src_ = e_route->gw_src_;
-    res->gw_dst_ = e_route->gw_dst_;
+  if (entry != 0) {
+    const Route* e_route = distinct_routes_[entry - 1].get();
+    res->gw_src_         = e_route->gw_src_;
+    res->gw_dst_         = e_route->gw_dst_;
     add_link_latency(res->link_list_, e_route->link_list_, lat);
   }
 }
@@ -61,17 +102,17 @@ void FullZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoin
 
   /* Check that the route does not already exist */
   if (gw_dst && gw_src) // inter-zone route (to adapt the error message, if any)
-    xbt_assert(nullptr == routing_table_[src->id()][dst->id()],
+    xbt_assert(0 == table_entry(src->id(), dst->id()),
                "The route between %s@%s and %s@%s already exists (Rq: routes are symmetrical by default).",
                src->get_cname(), gw_src->get_cname(), dst->get_cname(), gw_dst->get_cname());
   else
-    xbt_assert(nullptr == routing_table_[src->id()][dst->id()],
+    xbt_assert(0 == table_entry(src->id(), dst->id()),
                "The route between %s and %s already exists (Rq: routes are symmetrical by default).", src->get_cname(),
                dst->get_cname());
 
   /* Add the route to the base */
-  routing_table_[src->id()][dst->id()] = std::unique_ptr<Route>(
-      new_extended_route(get_hierarchy(), gw_src, gw_dst, get_link_list_impl(link_list, false), true));
+  table_entry(src->id(), dst->id()) =
+      intern_route(new_extended_route(get_hierarchy(), gw_src, gw_dst, get_link_list_impl(link_list, false), true));
 
   if (symmetrical && src != dst) {
     if (gw_dst && gw_src) {
@@ -81,16 +122,16 @@ void FullZone::add_route(NetPoint* src, NetPoint* dst, NetPoint* gw_src, NetPoin
     }
     if (gw_dst && gw_src) // inter-zone route (to adapt the error message, if any)
       xbt_assert(
-          nullptr == routing_table_[dst->id()][src->id()],
+          0 == table_entry(dst->id(), src->id()),
           "The route between %s@%s and %s@%s already exists. You should not declare the reverse path as symmetrical.",
           dst->get_cname(), gw_dst->get_cname(), src->get_cname(), gw_src->get_cname());
     else
-      xbt_assert(nullptr == routing_table_[dst->id()][src->id()],
+      xbt_assert(0 == table_entry(dst->id(), src->id()),
                  "The route between %s and %s already exists. You should not declare the reverse path as symmetrical.",
                  dst->get_cname(), src->get_cname());
 
-    routing_table_[dst->id()][src->id()] = std::unique_ptr<Route>(
-        new_extended_route(get_hierarchy(), gw_src, gw_dst, get_link_list_impl(link_list, true), false));
+    table_entry(dst->id(), src->id()) =
+        intern_route(new_extended_route(get_hierarchy(), gw_src, gw_dst, get_link_list_impl(link_list, true), false));
   }
 }
 } // namespace kernel::routing
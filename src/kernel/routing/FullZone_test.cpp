@@ -25,3 +25,37 @@ TEST_CASE("kernel::routing::FullZone: mix new routes and hosts", "[bug]")
     REQUIRE_NOTHROW(zone->add_route(cpu, nic, {link}));
   }
 }
+
+TEST_CASE("kernel::routing::FullZone: identical routes are shared", "")
+{
+  simgrid::s4u::Engine e("test");
+  auto* zone = e.get_netzone_root()->add_netzone_full("test");
+
+  const simgrid::s4u::Link* backbone = zone->add_link("backbone", 1e9);
+  std::vector<const simgrid::s4u::Host*> hosts;
+  for (int i = 0; i < 4; i++)
+    hosts.push_back(zone->add_host("host" + std::to_string(i), 1e9));
+  for (int i = 0; i < 4; i++)
+    for (int j = i + 1; j < 4; j++)
+      zone->add_route(hosts[i], hosts[j], {backbone});
+  // Add a new host after the routes, to check that the routing table grows correctly
+  const simgrid::s4u::Host* late = zone->add_host("late", 1e9);
+  const simgrid::s4u::Link* link = zone->add_link("late_link", 1e9);
+  zone->add_route(hosts[0], late, std::vector<const simgrid::s4u::Link*>{backbone, link});
+  zone->seal();
+
+  // One route through the backbone (both ways), one to the late host (both ways), one loopback
+  const auto* full = static_cast<simgrid::kernel::routing::FullZone*>(zone->get_impl());
+  REQUIRE(full->get_distinct_route_count() == 3);
+
+  std::vector<simgrid::s4u::Link*> links;
+  hosts[3]->route_to(hosts[1], links, nullptr);
+  REQUIRE(links.size() == 1);
+  REQUIRE(links[0]->get_name() == "backbone");
+
+  links.clear();
+  late->route_to(hosts[0], links, nullptr);
+  REQUIRE(links.size() == 2); // This add_route() declares the way back explicitly, with the links in the same order
+  REQUIRE(links[0]->get_name() == "backbone");
+  REQUIRE(links[1]->get_name() == "late_link");
+}
@@ -25,16 +25,15 @@ NetPoint::NetPoint(const std::string& name, NetPoint::Type componentType) : name
   simgrid::kernel::routing::NetPoint::on_creation(*this);
 }
 
-std::vector<NetZoneImpl*> NetPoint::get_all_englobing_zones() const
+void NetPoint::update_englobing_zones()
 {
-  std::vector<NetZoneImpl*> path;
+  englobing_zones_.clear();
   NetZoneImpl* current = this->englobing_zone_;
   while (current != nullptr) {
-    path.insert(path.begin(), current);
+    englobing_zones_.insert(englobing_zones_.begin(), current);
     current = current->get_parent();
   }
-  path.shrink_to_fit();
-  return path;
+  englobing_zones_.shrink_to_fit();
 }
 
 NetPoint* NetPoint::set_englobing_zone(NetZoneImpl* netzone_p)
@@ -42,6 +41,7 @@ NetPoint* NetPoint::set_englobing_zone(NetZoneImpl* netzone_p)
   englobing_zone_ = netzone_p;
   if (netzone_p != nullptr)
     id_ = netzone_p->add_component(this);
+  update_englobing_zones();
   return this;
 }
 
@@ -19,9 +19,16 @@
 #include "src/kernel/resource/VirtualMachineImpl.hpp"
 #include "src/simgrid/module.hpp"
 #include "src/simgrid/sg_config.hpp"
+#include "src/xbt/parallel.hpp"
 #include "xbt/asserts.hpp"
 #include "xbt/log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_platform, kernel, "Kernel platform-related information");
 
 namespace simgrid {
@@ -35,6 +42,19 @@ xbt::signal<void(bool symmetrical, kernel::routing::NetPoint* src, kernel::routi
                  std::vector<kernel::resource::StandardLinkImpl*> const& link_list)>
     NetZoneImpl::on_route_creation;
 
+static config::Flag<int> cfg_routing_nthreads{
+    "routing/nthreads", "Number of threads used to precompute the routing tables (lower than 1: one per core)", 0};
+
+/* Set in the workers of seal_local_zones(), which already keep all threads busy */
+static thread_local bool sealing_concurrently = false;
+
+unsigned NetZoneImpl::get_nthreads()
+{
+  if (sealing_concurrently)
+    return 1;
+  return xbt::resolve_nthreads(cfg_routing_nthreads);
+}
+
 NetZoneImpl::NetZoneImpl(const std::string& name) : piface_(this), name_(name)
 {
   auto* engine = s4u::Engine::get_instance();
@@ -155,8 +175,8 @@ s4u::Host* NetZoneImpl::add_host(const std::string& name, const std::vector<doub
               "Impossible to create host: %s. Invalid CPU model: nullptr. Have you set the parent of this NetZone: %s?",
               name.c_str(), get_cname());
   xbt_enforce(not sealed_, "Impossible to create host: %s. NetZone %s already sealed", name.c_str(), get_cname());
-  auto* host   = (new resource::HostImpl(name))->set_englobing_zone(this);
-  hosts_[name] = host;
+  auto* host                = (new resource::HostImpl(name))->set_englobing_zone(this);
+  hosts_[host->get_name()] = host;
   host->get_iface()->set_netpoint((new NetPoint(name, NetPoint::Type::Host))->set_englobing_zone(this));
 
   cpu_model_pm_->create_cpu(host->get_iface(), speed_per_pstate);
@@ -176,8 +196,9 @@ s4u::Link* NetZoneImpl::add_link(const std::string& name, const std::vector<doub
       "Impossible to create link: %s. Invalid network model: nullptr. Have you set the parent of this NetZone: %s?",
       name.c_str(), get_cname());
   xbt_enforce(not sealed_, "Impossible to create link: %s. NetZone %s already sealed", name.c_str(), get_cname());
-  links_[name] = do_create_link(name, bandwidths);
-  return links_[name]->get_iface();
+  auto* link                = do_create_link(name, bandwidths);
+  links_[link->get_name()] = link;
+  return link->get_iface();
 }
 
 s4u::SplitDuplexLink* NetZoneImpl::add_split_duplex_link(const std::string& name, const std::vector<double>& bw_up,
@@ -191,8 +212,10 @@ s4u::SplitDuplexLink* NetZoneImpl::add_split_duplex_link(const std::string& name
 
   auto* link_up             = add_link(name + "_UP", bw_up)->get_impl();
   auto* link_down           = add_link(name + "_DOWN", bw_down)->get_impl();
-  split_duplex_links_[name] = std::make_unique<resource::SplitDuplexLinkImpl>(name, link_up, link_down);
-  return split_duplex_links_[name]->get_iface();
+  auto link = std::make_unique<resource::SplitDuplexLinkImpl>(name, link_up, link_down);
+  auto* res = link->get_iface();
+  split_duplex_links_.insert_or_assign(link->get_name(), std::move(link));
+  return res;
 }
 
 s4u::Disk* NetZoneImpl::add_disk(const std::string& name, double read_bandwidth, double write_bandwidth)
@@ -357,7 +380,7 @@ void NetZoneImpl::add_bypass_route(NetPoint* src, NetPoint* dst, NetPoint* gw_sr
 
 bool NetZoneImpl::get_bypass_route(const NetPoint* src, const NetPoint* dst,
                                    /* OUT */ std::vector<resource::StandardLinkImpl*>& links, double* latency,
-                                   std::unordered_set<NetZoneImpl*>& netzones)
+                                   std::unordered_set<NetZoneImpl*>* netzones)
 {
   // If never set a bypass route return nullptr without any further computations
   if (bypass_routes_.empty())
@@ -377,34 +400,28 @@ bool NetZoneImpl::get_bypass_route(const NetPoint* src, const NetPoint* dst,
 
   /* Engage recursive search */
 
-  /* (1) find the path to the root routing component */
-  std::vector<NetZoneImpl*> path_src;
-  NetZoneImpl* current = src->get_englobing_zone();
-  while (current != nullptr) {
-    path_src.push_back(current);
-    current = current->parent_;
-  }
-
-  std::vector<NetZoneImpl*> path_dst;
-  current = dst->get_englobing_zone();
-  while (current != nullptr) {
-    path_dst.push_back(current);
-    current = current->parent_;
-  }
+  /* (1) find the path to the root routing component, from the root */
+  const std::vector<NetZoneImpl*>& zones_src = src->get_all_englobing_zones();
+  const std::vector<NetZoneImpl*>& zones_dst = dst->get_all_englobing_zones();
 
   /* (2) find the common parent */
-  while (path_src.size() > 1 && path_dst.size() > 1 && path_src.back() == path_dst.back()) {
-    path_src.pop_back();
-    path_dst.pop_back();
-  }
+  size_t common = 0;
+  while (common + 1 < zones_src.size() && common + 1 < zones_dst.size() && zones_src[common] == zones_dst[common])
+    common++;
+  /* The paths go from the netpoints up to the common parent, that is not included */
+  size_t path_src_size = zones_src.size() - common;
+  size_t path_dst_size = zones_dst.size() - common;
+  auto path_src        = [&zones_src](unsigned index) { return zones_src[zones_src.size() - 1 - index]; };
+  auto path_dst        = [&zones_dst](unsigned index) { return zones_dst[zones_dst.size() - 1 - index]; };
 
   /* (3) Search for a bypass making the path up to the ancestor useless */
   const BypassRoute* bypassedRoute = nullptr;
   std::pair<kernel::routing::NetPoint*, kernel::routing::NetPoint*> key;
   // Search for a bypass with the given indices. Returns true if found. Initialize variables `bypassedRoute' and `key'.
-  auto lookup = [&bypassedRoute, &key, &path_src, &path_dst, this](unsigned src_index, unsigned dst_index) {
-    if (src_index < path_src.size() && dst_index < path_dst.size()) {
-      key      = {path_src[src_index]->netpoint_, path_dst[dst_index]->netpoint_};
+  auto lookup = [&bypassedRoute, &key, &path_src, &path_dst, path_src_size, path_dst_size, this](unsigned src_index,
+                                                                                               unsigned dst_index) {
+    if (src_index < path_src_size && dst_index < path_dst_size) {
+      key      = {path_src(src_index)->netpoint_, path_dst(dst_index)->netpoint_};
       auto bpr = bypass_routes_.find(key);
       if (bpr != bypass_routes_.end()) {
         bypassedRoute = bpr->second;
@@ -414,7 +431,7 @@ bool NetZoneImpl::get_bypass_route(const NetPoint* src, const NetPoint* dst,
     return false;
   };
 
-  for (unsigned max = 0, max_index = std::max(path_src.size(), path_dst.size()); max < max_index; max++) {
+  for (unsigned max = 0, max_index = std::max(path_src_size, path_dst_size); max < max_index; max++) {
     for (unsigned i = 0; i < max; i++) {
       if (lookup(i, max) || lookup(max, i))
         break;
@@ -429,10 +446,10 @@ bool NetZoneImpl::get_bypass_route(const NetPoint* src, const NetPoint* dst,
               "calls to getRoute",
               src->get_cname(), dst->get_cname(), bypassedRoute->links.size());
     if (src != key.first)
-      get_global_route_with_netzones(src, bypassedRoute->gw_src, links, latency, netzones);
+      find_global_route(src, bypassedRoute->gw_src, links, latency, netzones);
     add_link_latency(links, bypassedRoute->links, latency);
     if (dst != key.second)
-      get_global_route_with_netzones(bypassedRoute->gw_dst, dst, links, latency, netzones);
+      find_global_route(bypassedRoute->gw_dst, dst, links, latency, netzones);
     return true;
   }
   XBT_DEBUG("No bypass route from '%s' to '%s'.", src->get_cname(), dst->get_cname());
@@ -442,20 +459,100 @@ bool NetZoneImpl::get_bypass_route(const NetPoint* src, const NetPoint* dst,
 void NetZoneImpl::get_global_route(const NetPoint* src, const NetPoint* dst,
                                    /* OUT */ std::vector<resource::StandardLinkImpl*>& links, double* latency)
 {
-  std::unordered_set<NetZoneImpl*> netzones;
-  get_global_route_with_netzones(src, dst, links, latency, netzones);
+  find_global_route(src, dst, links, latency, nullptr);
+}
+
+void NetZoneImpl::get_global_routes(const std::vector<std::pair<const NetPoint*, const NetPoint*>>& pairs,
+                                    /* OUT */ std::vector<std::vector<resource::StandardLinkImpl*>>* links,
+                                    /* OUT */ std::vector<double>* latencies)
+{
+  if (links)
+    links->assign(pairs.size(), {});
+  if (latencies)
+    latencies->assign(pairs.size(), 0.0);
+
+  unsigned nthreads = 1;
+  if (const auto* root = EngineImpl::get_instance()->get_netzone_root(); root && root->can_route_concurrently())
+    nthreads = get_nthreads();
+  XBT_DEBUG("Compute %zu routes on %u threads", pairs.size(), nthreads);
+
+  xbt::parallel_for(pairs.size(), nthreads, [&pairs, links, latencies](size_t begin, size_t end) {
+    std::vector<resource::StandardLinkImpl*> route_links;
+    for (size_t i = begin; i < end; i++) {
+      std::vector<resource::StandardLinkImpl*>& target = links ? (*links)[i] : route_links;
+      target.clear();
+      get_global_route(pairs[i].first, pairs[i].second, target, latencies ? &(*latencies)[i] : nullptr);
+    }
+  });
+}
+
+bool NetZoneImpl::can_route_concurrently() const
+{
+  return has_reentrant_routing() && std::all_of(children_.begin(), children_.end(),
+                                                [](const NetZoneImpl* child) { return child->can_route_concurrently(); });
 }
 
+namespace {
+/* Buffers of the route lookups, kept from one lookup to the next so that they stop allocating once they have grown.
+ * Floyd and Dijkstra zones look up global routes from their get_local_route(), so each nesting level gets its own. */
+struct RouteScratch {
+  Route route;
+  std::vector<resource::StandardLinkImpl*> links;
+};
+
+class RouteScratchHolder {
+  RouteScratch* scratch_;
+
+  static std::vector<std::unique_ptr<RouteScratch>>& pool()
+  {
+    thread_local std::vector<std::unique_ptr<RouteScratch>> pool;
+    return pool;
+  }
+  static size_t& depth()
+  {
+    thread_local size_t depth = 0;
+    return depth;
+  }
+
+public:
+  RouteScratchHolder()
+  {
+    if (depth() == pool().size())
+      pool().push_back(std::make_unique<RouteScratch>());
+    scratch_ = pool()[depth()++].get();
+  }
+  ~RouteScratchHolder() { depth()--; }
+  RouteScratchHolder(const RouteScratchHolder&)            = delete;
+  RouteScratchHolder& operator=(const RouteScratchHolder&) = delete;
+
+  /** Returns the route of that level, emptied */
+  Route& fresh_route()
+  {
+    Route& route = scratch_->route;
+    route.src_ = route.dst_ = route.gw_src_ = route.gw_dst_ = nullptr;
+    route.link_list_.clear();
+    return route;
+  }
+  /** Returns the link list of that level, emptied */
+  std::vector<resource::StandardLinkImpl*>& fresh_links()
+  {
+    scratch_->links.clear();
+    return scratch_->links;
+  }
+};
+} // namespace
+
+/* The zones below the common ancestor start at index below_common_ancestor in the englobing zones of src and dst */
 static void find_common_ancestors(const NetPoint* src, const NetPoint* dst,
                                   /* OUT */ NetZoneImpl** common_ancestor, NetZoneImpl** src_ancestor,
-                                  NetZoneImpl** dst_ancestor, std::vector<NetZoneImpl*>* src_path,
-                                  std::vector<NetZoneImpl*>* dst_path)
+                                  NetZoneImpl** dst_ancestor, size_t* below_common_ancestor)
 {
   /* Deal with the easy base case */
   if (src->get_englobing_zone() == dst->get_englobing_zone()) {
-    *common_ancestor = src->get_englobing_zone();
-    *src_ancestor    = *common_ancestor;
-    *dst_ancestor    = *common_ancestor;
+    *common_ancestor       = src->get_englobing_zone();
+    *src_ancestor          = *common_ancestor;
+    *dst_ancestor          = *common_ancestor;
+    *below_common_ancestor = 0;
     return;
   }
 
@@ -465,15 +562,14 @@ static void find_common_ancestors(const NetPoint* src, const NetPoint* dst,
   xbt_enforce(src_as, "Host %s must be in a netzone", src->get_cname());
   xbt_enforce(dst_as, "Host %s must be in a netzone", dst->get_cname());
 
-  *src_ancestor    = nullptr;
-  *dst_ancestor    = nullptr;
-  *common_ancestor = nullptr;
+  const std::vector<NetZoneImpl*>& src_path = src->get_all_englobing_zones();
+  const std::vector<NetZoneImpl*>& dst_path = dst->get_all_englobing_zones();
 
   size_t common_ancestor_index = 0;
 
-  size_t min_size = std::min(src_path->size(), dst_path->size());
+  size_t min_size = std::min(src_path.size(), dst_path.size());
 
-  xbt_assert(min_size > 0 && (src_path->at(0) == dst_path->at(0)),
+  xbt_assert(min_size > 0 && (src_path[0] == dst_path[0]),
              "No common ancestor found for '%s' and '%s'. Please check your platform file.", src->get_cname(),
              dst->get_cname());
 
@@ -483,30 +579,25 @@ static void find_common_ancestors(const NetPoint* src, const NetPoint* dst,
    * This works because all SimGrid platforms have a unique root element (that is the first element of both paths).
    */
   for (size_t i = 0; i < min_size; i++) {
-    if (src_path->at(i) != dst_path->at(i))
+    if (src_path[i] != dst_path[i])
       break;
     common_ancestor_index = i;
   }
 
-  *common_ancestor = src_path->at(common_ancestor_index);
+  *common_ancestor       = src_path[common_ancestor_index];
+  *below_common_ancestor = common_ancestor_index + 1;
 
-  /* (2) remove the common part from the paths (including the common ancestor)
-   *  'erase' does not include the last position, so we add 1 to last position index
+  /* (2) set the src and dst ancestors
+   * If nothing remains of xxx_path below the common ancestor, the NetPoint of xxx is in the netzone of the ancestor.
+   * Otherwise, the NetPoint is in a sub-netzone of the ancestor (the first element below the common ancestor).
    */
-  src_path->erase(src_path->begin(), src_path->begin() + common_ancestor_index + 1);
-  dst_path->erase(dst_path->begin(), dst_path->begin() + common_ancestor_index + 1);
-
-  /* (3) set the src and dst ancestors
-   * If xxx_path is empty, this means that the NetPoint of xxx is in the netzone of the ancestor.
-   * Otherwise, the NetPoint is in a sub-netzone of the ancestor (the first element of xxx_path).
-   */
-  if (!src_path->empty())
-    *src_ancestor = src_path->front();
+  if (*below_common_ancestor < src_path.size())
+    *src_ancestor = src_path[*below_common_ancestor];
   else
     *src_ancestor = *common_ancestor;
 
-  if (!dst_path->empty())
-    *dst_ancestor = dst_path->front();
+  if (*below_common_ancestor < dst_path.size())
+    *dst_ancestor = dst_path[*below_common_ancestor];
   else
     *dst_ancestor = *common_ancestor;
 
@@ -519,20 +610,22 @@ static void find_common_ancestors(const NetPoint* src, const NetPoint* dst,
 /* Compute the route between a leaf NetPoint and an upper router */
 void NetZoneImpl::get_interzone_route(const NetPoint* netpoint, NetPoint* gateway, const bool gateway_to_netpoint,
                                       std::vector<kernel::resource::StandardLinkImpl*>& links, double* latency,
-                                      std::vector<NetZoneImpl*>* zones_path)
+                                      std::vector<NetZoneImpl*>::const_iterator zones_begin,
+                                      std::vector<NetZoneImpl*>::const_iterator zones_end)
 {
   XBT_DEBUG("get_interzone_route netpoint='%s' (in '%s') gw='%s' gateway_to_netpoint=%d", netpoint->get_cname(),
             netpoint->get_englobing_zone()->get_cname(), gateway->get_cname(), gateway_to_netpoint);
 
-  Route route = Route();
+  RouteScratchHolder scratch;
+  Route& route = scratch.fresh_route();
   NetPoint* current;
   std::vector<simgrid::kernel::resource::StandardLinkImpl*>::iterator link_insert_pos;
-  auto it = zones_path->begin();
+  auto it = zones_begin;
 
   // Starting from the parent zone, we go down to the zone containing the NetPoint,
   // adding the routes between the zones to links in the order specified by gateway_to_netpoint
   while (netpoint->get_englobing_zone() != gateway->get_englobing_zone()) {
-    xbt_assert(it != zones_path->end(), "The NetPoint '%s' has no route to the gateway '%s'", netpoint->get_cname(),
+    xbt_assert(it != zones_end, "The NetPoint '%s' has no route to the gateway '%s'", netpoint->get_cname(),
                gateway->get_cname());
     current = (*it)->netpoint_;
 
@@ -565,7 +658,7 @@ void NetZoneImpl::get_interzone_route(const NetPoint* netpoint, NetPoint* gatewa
       gateway = route.gw_src_;
       links.insert(links.begin(), route.link_list_.rbegin(), route.link_list_.rend());
     }
-    route = Route();
+    scratch.fresh_route();
     it++;
   };
 
@@ -586,40 +679,53 @@ void NetZoneImpl::get_interzone_route(const NetPoint* netpoint, NetPoint* gatewa
   }
 }
 
-/* Compute the list of links that connect two NetPoints */
 void NetZoneImpl::get_global_route_with_netzones(const NetPoint* src, const NetPoint* dst,
                                                  /* OUT */ std::vector<resource::StandardLinkImpl*>& links,
                                                  double* latency, std::unordered_set<NetZoneImpl*>& netzones)
 {
-  Route route;
+  find_global_route(src, dst, links, latency, &netzones);
+}
+
+/* Compute the list of links that connect two NetPoints */
+void NetZoneImpl::find_global_route(const NetPoint* src, const NetPoint* dst,
+                                    /* OUT */ std::vector<resource::StandardLinkImpl*>& links, double* latency,
+                                    std::unordered_set<NetZoneImpl*>* netzones)
+{
   XBT_DEBUG("Resolve route from '%s' to '%s'", src->get_cname(), dst->get_cname());
 
   NetZoneImpl* common_ancestor;
   NetZoneImpl* src_ancestor;
   NetZoneImpl* dst_ancestor;
-
-  /* For src and dst : get the path from the root-zone to the NetPoint */
-  std::vector<NetZoneImpl*> src_path = src->get_all_englobing_zones();
-  std::vector<NetZoneImpl*> dst_path = dst->get_all_englobing_zones();
+  size_t below_common_ancestor;
 
   XBT_DEBUG("\tfind_common_ancestors: src '%s' dst '%s' :", src->get_cname(), dst->get_cname());
-  find_common_ancestors(src, dst, &common_ancestor, &src_ancestor, &dst_ancestor, &src_path, &dst_path);
+  find_common_ancestors(src, dst, &common_ancestor, &src_ancestor, &dst_ancestor, &below_common_ancestor);
   XBT_DEBUG("\tfind_common_ancestors: common ancestor '%s' src ancestor '%s' dst ancestor '%s'",
             common_ancestor->get_cname(), src_ancestor->get_cname(), dst_ancestor->get_cname());
 
-  netzones.insert(src_path.begin(), src_path.end());
-  netzones.insert(common_ancestor);
-  netzones.insert(dst_path.begin(), dst_path.end());
+  /* For src and dst : the path from the root-zone to the NetPoint, without the common part */
+  const std::vector<NetZoneImpl*>& src_path = src->get_all_englobing_zones();
+  const std::vector<NetZoneImpl*>& dst_path = dst->get_all_englobing_zones();
+  auto src_below = src_path.cbegin() + static_cast<std::ptrdiff_t>(std::min(below_common_ancestor, src_path.size()));
+  auto dst_below = dst_path.cbegin() + static_cast<std::ptrdiff_t>(std::min(below_common_ancestor, dst_path.size()));
+
+  if (netzones != nullptr) {
+    netzones->insert(src_below, src_path.cend());
+    netzones->insert(common_ancestor);
+    netzones->insert(dst_below, dst_path.cend());
+  }
 
   /* Check whether a direct bypass is defined. If so, use it and bail out */
   if (common_ancestor->get_bypass_route(src, dst, links, latency, netzones))
     return;
 
+  RouteScratchHolder scratch;
+  Route& route = scratch.fresh_route();
   if (src->get_englobing_zone() == dst->get_englobing_zone()) {
     XBT_DEBUG("\tNo need to resolve global route since src and dst are in the same netzone '%s'", src->get_cname());
-    route.link_list_ = std::move(links);
+    std::swap(route.link_list_, links);
     src->get_englobing_zone()->get_local_route(src, dst, &route, latency);
-    links = std::move(route.link_list_);
+    std::swap(route.link_list_, links);
     return;
   } else {
     /* Get the route from the source ancestor and the destination ancestor */
@@ -630,38 +736,32 @@ void NetZoneImpl::get_global_route_with_netzones(const NetPoint* src, const NetP
     if (src_ancestor != common_ancestor) {
       XBT_DEBUG("\tsrc_ancestor '%s' is not the common ancestor '%s'", src_ancestor->get_cname(),
                 common_ancestor->get_cname());
-      std::vector<resource::StandardLinkImpl*> src_to_src_ancestor;
+      std::vector<resource::StandardLinkImpl*>& src_to_src_ancestor = scratch.fresh_links();
       xbt_assert(route.gw_src_ != nullptr,
                  "No Gateway (gw_src) for zone %s found in route, please check your platform. If this error remains, "
                  "please report it.",
                  src_ancestor->get_cname());
 
-      /* Since we got the source ancestor gateway, we have to remove the source ancestor from the path */
-      src_path.erase(src_path.begin());
-
-      /* Insert the route from the source to the source ancestor into the global route */
-      get_interzone_route(src, route.gw_src_, false, src_to_src_ancestor, latency, &src_path);
-      std::move(src_to_src_ancestor.begin(), src_to_src_ancestor.end(), std::back_inserter(links));
+      /* Since we got the source ancestor gateway, the path goes down from below the source ancestor */
+      get_interzone_route(src, route.gw_src_, false, src_to_src_ancestor, latency, src_below + 1, src_path.cend());
+      links.insert(links.end(), src_to_src_ancestor.begin(), src_to_src_ancestor.end());
     }
     /* Insert the route from the source ancestor to the destination ancestor into the global route */
-    std::move(route.link_list_.begin(), route.link_list_.end(), std::back_inserter(links));
+    links.insert(links.end(), route.link_list_.begin(), route.link_list_.end());
     /* Get the route from the destination ancestor to the destination, if the destination ancestor is not the common
      * ancestor */
     if (dst_ancestor != common_ancestor) {
       XBT_DEBUG("\tdst_ancestor '%s' is not the common ancestor '%s'", dst_ancestor->get_cname(),
                 common_ancestor->get_cname());
-      std::vector<resource::StandardLinkImpl*> dst_ancestor_to_dst;
+      std::vector<resource::StandardLinkImpl*>& dst_ancestor_to_dst = scratch.fresh_links();
       xbt_assert(route.gw_dst_ != nullptr,
                  "No Gateway (gw_dst) for zone %s found in route, please check your platform. If this error remains, "
                  "please report it.",
                  dst_ancestor->get_cname());
 
-      /* Since we got the destination ancestor gateway, we have to remove the destination ancestor from the path */
-      dst_path.erase(dst_path.begin());
-
-      /* Insert the route from the destination ancestor to the destination into the global route */
-      get_interzone_route(dst, route.gw_dst_, true, dst_ancestor_to_dst, latency, &dst_path);
-      std::move(begin(dst_ancestor_to_dst), end(dst_ancestor_to_dst), std::back_inserter(links));
+      /* Since we got the destination ancestor gateway, the path goes down from below the destination ancestor */
+      get_interzone_route(dst, route.gw_dst_, true, dst_ancestor_to_dst, latency, dst_below + 1, dst_path.cend());
+      links.insert(links.end(), dst_ancestor_to_dst.begin(), dst_ancestor_to_dst.end());
     }
   }
 }
@@ -743,7 +843,57 @@ void NetZoneImpl::seal()
   /* already sealed netzone */
   if (sealed_)
     return;
-  do_seal(); // derived class' specific sealing procedure
+  seal_local_zones();
+  seal_recursively();
+}
+
+void NetZoneImpl::seal_local_zones()
+{
+  /* Gather the zones of this subtree that can be sealed concurrently, in the order of the sequential sealing */
+  std::vector<NetZoneImpl*> zones;
+  std::vector<NetZoneImpl*> pending = {this};
+  while (not pending.empty()) {
+    NetZoneImpl* zone = pending.back();
+    pending.pop_back();
+    if (zone->sealed_)
+      continue;
+    if (zone->has_local_seal())
+      zones.push_back(zone);
+    pending.insert(pending.end(), zone->children_.rbegin(), zone->children_.rend());
+  }
+
+  /* A single zone is better sealed as usual, with all the threads for its own precomputations */
+  auto nthreads = static_cast<unsigned>(std::min<size_t>(get_nthreads(), zones.size()));
+  if (nthreads < 2)
+    return;
+
+  XBT_DEBUG("Seal %zu zones on %u threads", zones.size(), nthreads);
+  std::vector<std::exception_ptr> errors(zones.size());
+  std::atomic<size_t> next_zone{0};
+  xbt::parallel_run(nthreads, [&zones, &errors, &next_zone](unsigned /*rank*/, unsigned /*nworkers*/) {
+    sealing_concurrently = true;
+    for (size_t i = next_zone++; i < zones.size(); i = next_zone++) {
+      try {
+        zones[i]->do_seal();
+        zones[i]->pre_sealed_ = true;
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+    sealing_concurrently = false;
+  });
+  /* Report the error of the first zone in sealing order, whatever the thread that got it */
+  for (auto const& error : errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+void NetZoneImpl::seal_recursively()
+{
+  if (sealed_)
+    return;
+  if (not std::exchange(pre_sealed_, false))
+    do_seal(); // derived class' specific sealing procedure
 
   // for zone with a single host, this host is its own default gateway
   if (gateways_.empty() && hosts_.size() == 1)
@@ -762,12 +912,27 @@ void NetZoneImpl::seal()
   for (auto const& [_, link] : links_)
     link->get_iface()->seal();
 
-  for (auto* sub_net : get_children()) {
-    sub_net->seal();
+  for (auto* sub_net : children_) {
+    sub_net->seal_recursively();
   }
   sealed_ = true;
+  EngineImpl::get_instance()->on_platform_change();
   s4u::NetZone::on_seal(piface_);
 }
+
+void NetZoneImpl::create_lazily(const std::function<void()>& create)
+{
+  bool was_sealed = sealed_;
+  sealed_         = false;
+  try {
+    create();
+  } catch (...) {
+    sealed_ = was_sealed;
+    throw;
+  }
+  sealed_ = was_sealed;
+}
+
 void NetZoneImpl::unseal()
 {
   /* already unsealed netzone */
@@ -775,14 +940,24 @@ void NetZoneImpl::unseal()
     return;
 
   sealed_ = false;
+  EngineImpl::get_instance()->on_platform_change();
   s4u::NetZone::on_unseal(piface_);
 }
 
+void NetZoneImpl::update_englobing_zones()
+{
+  for (auto* vertex : vertices_)
+    vertex->update_englobing_zones();
+  for (auto* child : children_)
+    child->update_englobing_zones();
+}
+
 NetZoneImpl* NetZoneImpl::set_parent(NetZoneImpl* parent)
 {
   xbt_enforce(not sealed_, "Impossible to set parent to an already sealed NetZone(%s)", this->get_cname());
   parent_ = parent;
   netpoint_->set_englobing_zone(parent_);
+  update_englobing_zones();
   if (parent) {
     /* adding this class as child */
     parent->add_child(this);
@@ -0,0 +1,787 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <simgrid/kernel/routing/DijkstraZone.hpp>
+#include <simgrid/kernel/routing/DragonflyZone.hpp>
+#include <simgrid/kernel/routing/EmptyZone.hpp>
+#include <simgrid/kernel/routing/FatTreeZone.hpp>
+#include <simgrid/kernel/routing/FloydZone.hpp>
+#include <simgrid/kernel/routing/FullZone.hpp>
+#include <simgrid/kernel/routing/NetPoint.hpp>
+#include <simgrid/kernel/routing/StarZone.hpp>
+#include <simgrid/kernel/routing/TorusZone.hpp>
+#include <simgrid/kernel/routing/VivaldiZone.hpp>
+#include <simgrid/s4u/Disk.hpp>
+#include <simgrid/s4u/Engine.hpp>
+#include <simgrid/s4u/Host.hpp>
+#include <simgrid/s4u/Link.hpp>
+#include <xbt/asserts.hpp>
+#include <xbt/string.hpp>
+
+#include "src/kernel/resource/CpuImpl.hpp"
+#include "src/kernel/resource/DiskImpl.hpp"
+#include "src/kernel/resource/HostImpl.hpp"
+#include "src/kernel/resource/NetworkModel.hpp"
+#include "src/kernel/resource/SplitDuplexLinkImpl.hpp"
+#include "src/kernel/resource/StandardLinkImpl.hpp"
+#include "src/kernel/routing/PlatformSnapshot.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_routing_snapshot, ker_platform, "Kernel platform snapshots");
+
+namespace simgrid::kernel::routing {
+
+/* The file starts with this magic number, followed by the format version and a marker of the byte order */
+static constexpr std::array<char, 8> MAGIC  = {'S', 'G', 'P', 'L', 'A', 'T', 'F', '\0'};
+static constexpr uint32_t VERSION           = 1;
+static constexpr uint32_t BYTE_ORDER_MARKER = 0x01020304;
+static constexpr uint32_t NONE              = std::numeric_limits<uint32_t>::max(); // no netpoint
+
+enum class ZoneKind : uint8_t { FULL, FLOYD, DIJKSTRA, DIJKSTRA_CACHE, STAR, EMPTY, TORUS, FAT_TREE, DRAGONFLY };
+enum class VertexKind : uint8_t { HOST, ROUTER, NETZONE };
+
+static bool is_cluster(ZoneKind kind)
+{
+  return kind == ZoneKind::TORUS || kind == ZoneKind::FAT_TREE || kind == ZoneKind::DRAGONFLY;
+}
+
+/*************************************************************************************************/
+class SnapshotWriter {
+  std::ofstream stream_;
+  std::string path_;
+  std::unordered_map<const NetPoint*, uint32_t> netpoints_;
+  std::unordered_map<const resource::StandardLinkImpl*, uint32_t> links_;
+  std::unordered_map<const NetZoneImpl*, uint32_t> zones_;
+
+public:
+  explicit SnapshotWriter(const std::string& path) : stream_(path, std::ios::binary | std::ios::trunc), path_(path)
+  {
+    xbt_enforce(stream_.is_open(), "Cannot open '%s' to save the platform snapshot", path.c_str());
+  }
+
+  template <typename T> void put(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    stream_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  void put_string(const std::string& str)
+  {
+    put(static_cast<uint32_t>(str.size()));
+    stream_.write(str.data(), static_cast<std::streamsize>(str.size()));
+  }
+  template <typename T> void put_vector(const std::vector<T>& values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    put(static_cast<uint64_t>(values.size()));
+    stream_.write(reinterpret_cast<const char*>(values.data()),
+                  static_cast<std::streamsize>(values.size() * sizeof(T)));
+  }
+  void put_properties(const std::unordered_map<std::string, std::string>* properties)
+  {
+    /* sorted, so that saving the same platform twice gives the same file */
+    std::map<std::string, std::string, std::less<>> sorted;
+    if (properties)
+      sorted.insert(properties->begin(), properties->end());
+    put(static_cast<uint32_t>(sorted.size()));
+    for (auto const& [key, value] : sorted) {
+      put_string(key);
+      put_string(value);
+    }
+  }
+
+  /* The netpoints, links and netzones are referred to by their rank in the file */
+  void add_netpoint(const NetPoint* netpoint) { netpoints_.try_emplace(netpoint, netpoints_.size()); }
+  void put_netpoint(const NetPoint* netpoint)
+  {
+    if (netpoint == nullptr) {
+      put(NONE);
+      return;
+    }
+    auto it = netpoints_.find(netpoint);
+    xbt_enforce(it != netpoints_.end(), "Cannot snapshot a reference to '%s', which is not part of the platform",
+                netpoint->get_cname());
+    put(it->second);
+  }
+  void add_link(const resource::StandardLinkImpl* link) { links_.try_emplace(link, links_.size()); }
+  void put_link(const resource::StandardLinkImpl* link)
+  {
+    auto it = links_.find(link);
+    xbt_enforce(it != links_.end(), "Cannot snapshot a route through link '%s', which was created by a netzone",
+                link->get_cname());
+    put(it->second);
+  }
+  void add_zone(const NetZoneImpl* zone)
+  {
+    zones_.try_emplace(zone, zones_.size());
+    add_netpoint(zone->get_netpoint());
+  }
+  uint32_t get_zone_rank(const NetZoneImpl* zone) const { return zones_.at(zone); }
+
+  void close()
+  {
+    stream_.close();
+    xbt_enforce(not stream_.fail(), "Error while writing the platform snapshot '%s'", path_.c_str());
+  }
+};
+
+/*************************************************************************************************/
+class SnapshotReader {
+  void* mapping_ = MAP_FAILED;
+  size_t size_   = 0;
+  size_t pos_    = 0;
+  std::string path_;
+
+public:
+  std::vector<NetPoint*> netpoints;
+  std::vector<s4u::Link*> links;
+  std::vector<NetZoneImpl*> zones;
+  std::unordered_map<const NetZoneImpl*, size_t> leaves_rank; // rank of the first leaf of each cluster
+
+  explicit SnapshotReader(const std::string& path) : path_(path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    xbt_enforce(fd >= 0, "Cannot open the platform snapshot '%s': %s", path.c_str(), strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      size_    = static_cast<size_t>(st.st_size);
+      mapping_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    xbt_enforce(mapping_ != MAP_FAILED, "Cannot map the platform snapshot '%s' in memory", path.c_str());
+  }
+  SnapshotReader(const SnapshotReader&)            = delete;
+  SnapshotReader& operator=(const SnapshotReader&) = delete;
+  ~SnapshotReader() { munmap(mapping_, size_); }
+
+  const char* take(size_t bytes)
+  {
+    xbt_enforce(bytes <= size_ - pos_, "Truncated platform snapshot '%s'", path_.c_str());
+    const char* res = static_cast<const char*>(mapping_) + pos_;
+    pos_ += bytes;
+    return res;
+  }
+  bool at_end() const { return pos_ == size_; }
+
+  template <typename T> T get()
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+  std::string get_string()
+  {
+    auto size = get<uint32_t>();
+    return std::string(take(size), size);
+  }
+  template <typename T> std::vector<T> get_vector()
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto count = get<uint64_t>();
+    xbt_enforce(count <= (size_ - pos_) / sizeof(T), "Truncated platform snapshot '%s'", path_.c_str());
+    std::vector<T> values(count);
+    if (count > 0)
+      std::memcpy(values.data(), take(count * sizeof(T)), count * sizeof(T));
+    return values;
+  }
+  std::unordered_map<std::string, std::string> get_properties()
+  {
+    std::unordered_map<std::string, std::string> properties;
+    for (auto count = get<uint32_t>(); count > 0; count--) {
+      std::string key = get_string();
+      properties[key] = get_string();
+    }
+    return properties;
+  }
+
+  NetPoint* get_netpoint()
+  {
+    auto rank = get<uint32_t>();
+    if (rank == NONE)
+      return nullptr;
+    xbt_enforce(rank < netpoints.size() && netpoints[rank], "Invalid netpoint in platform snapshot '%s'",
+                path_.c_str());
+    return netpoints[rank];
+  }
+  s4u::Link* get_link()
+  {
+    auto rank = get<uint32_t>();
+    xbt_enforce(rank < links.size(), "Invalid link in platform snapshot '%s'", path_.c_str());
+    return links[rank];
+  }
+  void add_zone(NetZoneImpl* zone)
+  {
+    zones.push_back(zone);
+    netpoints.push_back(zone->get_netpoint());
+  }
+};
+
+/*************************************************************************************************/
+/* Resources are saved through their public interface, and loaded into plain descriptions first: the leaves of the
+ * clusters are only created by the cluster when it gets sealed, and their links may even be created later on */
+
+struct LinkDesc {
+  std::string name;
+  double bandwidth;
+  double latency;
+  s4u::Link::SharingPolicy policy;
+  int concurrency_limit;
+  std::unordered_map<std::string, std::string> properties;
+};
+
+struct DiskDesc {
+  std::string name;
+  double read_bandwidth;
+  double write_bandwidth;
+  std::unordered_map<std::string, std::string> properties;
+};
+
+struct HostDesc {
+  std::string name;
+  std::vector<double> speeds;
+  int core_count;
+  unsigned long pstate;
+  std::unordered_map<std::string, std::string> properties;
+  std::vector<DiskDesc> disks;
+};
+
+struct LeafDesc {
+  HostDesc host;
+  LinkDesc loopback;
+  LinkDesc limiter;
+};
+
+struct ClusterDesc {
+  std::vector<LeafDesc> leaves;
+  std::vector<std::pair<std::string, unsigned long>> gateways; // name -> leaf position
+};
+
+static void save_link(SnapshotWriter& out, const s4u::Link* link)
+{
+  auto policy = link->get_sharing_policy();
+  xbt_enforce(policy != s4u::Link::SharingPolicy::NONLINEAR && policy != s4u::Link::SharingPolicy::WIFI,
+              "Cannot snapshot link '%s': its sharing policy depends on the code", link->get_cname());
+  xbt_enforce(not link->get_impl()->has_profile(), "Cannot snapshot link '%s': its profiles cannot be saved",
+              link->get_cname());
+  out.put_string(link->get_name());
+  out.put(link->get_bandwidth());
+  out.put(link->get_latency());
+  out.put(policy);
+  out.put(link->get_concurrency_limit());
+  out.put_properties(link->get_properties());
+}
+
+static LinkDesc read_link(SnapshotReader& in)
+{
+  LinkDesc link;
+  link.name              = in.get_string();
+  link.bandwidth         = in.get<double>();
+  link.latency           = in.get<double>();
+  link.policy            = in.get<s4u::Link::SharingPolicy>();
+  link.concurrency_limit = in.get<int>();
+  link.properties        = in.get_properties();
+  return link;
+}
+
+/* Sets the characteristics of a link that was created with the right name and bandwidth */
+static s4u::Link* setup_link(s4u::Link* link, const LinkDesc& desc)
+{
+  link->set_latency(desc.latency);
+  if (desc.policy != link->get_sharing_policy())
+    link->set_sharing_policy(desc.policy);
+  if (desc.concurrency_limit != link->get_concurrency_limit())
+    link->set_concurrency_limit(desc.concurrency_limit);
+  link->set_properties(desc.properties);
+  return link->seal();
+}
+
+static void save_host(SnapshotWriter& out, const s4u::Host* host)
+{
+  xbt_enforce(not host->get_cpu()->has_profile(), "Cannot snapshot host '%s': its profiles cannot be saved",
+              host->get_cname());
+  out.put_string(host->get_name());
+  std::vector<double> speeds(host->get_pstate_count());
+  for (unsigned long i = 0; i < speeds.size(); i++)
+    speeds[i] = host->get_pstate_speed(i);
+  out.put_vector(speeds);
+  out.put(host->get_core_count());
+  out.put(static_cast<uint64_t>(host->get_pstate()));
+  out.put_properties(host->get_properties());
+  auto disks = host->get_disks();
+  out.put(static_cast<uint32_t>(disks.size()));
+  for (auto const* disk : disks) {
+    xbt_enforce(not disk->get_impl()->has_profile(), "Cannot snapshot disk '%s': its profiles cannot be saved",
+                disk->get_cname());
+    out.put_string(disk->get_name());
+    out.put(disk->get_read_bandwidth());
+    out.put(disk->get_write_bandwidth());
+    out.put_properties(disk->get_properties());
+  }
+}
+
+static HostDesc read_host(SnapshotReader& in)
+{
+  HostDesc host;
+  host.name       = in.get_string();
+  host.speeds     = in.get_vector<double>();
+  host.core_count = in.get<int>();
+  host.pstate     = in.get<uint64_t>();
+  host.properties = in.get_properties();
+  host.disks.resize(in.get<uint32_t>());
+  for (auto& disk : host.disks) {
+    disk.name            = in.get_string();
+    disk.read_bandwidth  = in.get<double>();
+    disk.write_bandwidth = in.get<double>();
+    disk.properties      = in.get_properties();
+  }
+  return host;
+}
+
+static s4u::Host* create_host(s4u::NetZone* zone, const HostDesc& desc)
+{
+  s4u::Host* host = zone->add_host(desc.name, desc.speeds)->set_core_count(desc.core_count);
+  host->set_properties(desc.properties);
+  for (auto const& disk : desc.disks)
+    host->add_disk(disk.name, disk.read_bandwidth, disk.write_bandwidth)->set_properties(disk.properties)->seal();
+  host->seal();
+  if (desc.pstate != 0)
+    host->set_pstate(desc.pstate);
+  return host;
+}
+
+/*************************************************************************************************/
+ZoneKind PlatformSnapshot::get_kind(const NetZoneImpl* zone)
+{
+  xbt_enforce(not dynamic_cast<const VivaldiZone*>(zone), "Cannot snapshot the Vivaldi netzone %s", zone->get_cname());
+  if (dynamic_cast<const StarZone*>(zone))
+    return ZoneKind::STAR;
+  if (dynamic_cast<const TorusZone*>(zone))
+    return ZoneKind::TORUS;
+  if (dynamic_cast<const FatTreeZone*>(zone))
+    return ZoneKind::FAT_TREE;
+  if (dynamic_cast<const DragonflyZone*>(zone))
+    return ZoneKind::DRAGONFLY;
+  if (dynamic_cast<const FullZone*>(zone))
+    return ZoneKind::FULL;
+  if (dynamic_cast<const FloydZone*>(zone))
+    return ZoneKind::FLOYD;
+  if (const auto* dijkstra = dynamic_cast<const DijkstraZone*>(zone))
+    return dijkstra->cached_ ? ZoneKind::DIJKSTRA_CACHE : ZoneKind::DIJKSTRA;
+  if (dynamic_cast<const EmptyZone*>(zone))
+    return ZoneKind::EMPTY;
+  throw std::invalid_argument(
+      xbt::string_printf("Cannot snapshot netzone %s: this kind of netzone is not supported", zone->get_cname()));
+}
+
+void PlatformSnapshot::save_zone(SnapshotWriter& out, const NetZoneImpl* zone)
+{
+  xbt_enforce(zone->bypass_routes_.empty(), "Cannot snapshot the bypass routes of netzone %s", zone->get_cname());
+  out.add_zone(zone);
+  out.put_string(zone->get_name());
+  ZoneKind kind = get_kind(zone);
+  out.put(kind);
+  out.put_properties(zone->get_iface()->get_properties());
+  if (is_cluster(kind)) {
+    save_cluster(out, zone);
+    return;
+  }
+
+  /* The split-duplex links first, as they create their members */
+  std::unordered_set<const resource::StandardLinkImpl*> members;
+  out.put(static_cast<uint32_t>(zone->split_duplex_links_.size()));
+  for (auto const& [_, link] : zone->split_duplex_links_) {
+    out.put_string(link->get_name());
+    for (auto const* member : {link->get_link_up(), link->get_link_down()}) {
+      save_link(out, member);
+      out.add_link(member->get_impl());
+      members.insert(member->get_impl());
+    }
+  }
+  out.put(static_cast<uint32_t>(zone->links_.size() - members.size()));
+  for (auto const& [_, link] : zone->links_) {
+    if (members.contains(link))
+      continue;
+    save_link(out, link->get_iface());
+    out.add_link(link);
+  }
+
+  /* The vertices are created in the same order on load, so that they get the same ids (the tables rely on them) */
+  std::unordered_map<const NetPoint*, const NetZoneImpl*> children;
+  for (auto const* child : zone->get_children())
+    children[child->get_netpoint()] = child;
+  out.put(static_cast<uint64_t>(zone->get_table_size()));
+  for (auto const* vertex : zone->get_vertices()) {
+    if (vertex->is_netzone()) {
+      out.put(VertexKind::NETZONE);
+      save_zone(out, children.at(vertex));
+    } else if (vertex->is_router()) {
+      out.put(VertexKind::ROUTER);
+      out.put_string(vertex->get_name());
+      out.add_netpoint(vertex);
+    } else {
+      out.put(VertexKind::HOST);
+      save_host(out, zone->hosts_.at(vertex->get_name())->get_iface());
+      out.add_netpoint(vertex);
+    }
+  }
+}
+
+void PlatformSnapshot::save_cluster(SnapshotWriter& out, const NetZoneImpl* zone)
+{
+  const auto* cluster = static_cast<const ClusterBase*>(zone);
+  xbt_enforce(not cluster->netzone_cb_, "Cannot snapshot the cluster %s: its leaves are netzones", zone->get_cname());
+  xbt_enforce(not cluster->lazy_links_, "Cannot snapshot the cluster %s: its links are created lazily",
+              zone->get_cname());
+  xbt_enforce(zone->get_table_size() == static_cast<unsigned long>(cluster->get_tot_elements()),
+              "Cannot snapshot the cluster %s: it is not sealed or contains other elements than its leaves",
+              zone->get_cname());
+
+  out.put(cluster->link_bw_);
+  out.put(cluster->link_lat_);
+  out.put(cluster->link_sharing_policy_);
+  if (const auto* torus = dynamic_cast<const TorusZone*>(zone)) {
+    out.put_vector(std::vector<uint64_t>(torus->dimensions_.begin(), torus->dimensions_.end()));
+  } else if (const auto* fat_tree = dynamic_cast<const FatTreeZone*>(zone)) {
+    out.put(static_cast<uint32_t>(fat_tree->levels_));
+    out.put_vector(fat_tree->num_children_per_node_);
+    out.put_vector(fat_tree->num_parents_per_node_);
+    out.put_vector(fat_tree->num_port_lower_level_);
+  } else {
+    const auto* dragonfly = static_cast<const DragonflyZone*>(zone);
+    for (unsigned int value : {dragonfly->num_groups_, dragonfly->num_links_blue_, dragonfly->num_chassis_per_group_,
+                               dragonfly->num_links_black_, dragonfly->num_blades_per_chassis_,
+                               dragonfly->num_links_green_, dragonfly->num_nodes_per_blade_})
+      out.put(static_cast<uint32_t>(value));
+  }
+
+  /* The leaves, which are numbered in the order of their positions */
+  out.put(static_cast<uint8_t>(cluster->has_loopback_));
+  out.put(static_cast<uint8_t>(cluster->has_limiter_));
+  out.put(static_cast<uint64_t>(zone->get_table_size()));
+  for (auto const* vertex : zone->get_vertices()) {
+    save_host(out, zone->hosts_.at(vertex->get_name())->get_iface());
+    out.add_netpoint(vertex);
+    if (cluster->has_loopback_)
+      save_link(out, cluster->private_links_.at(cluster->node_pos(vertex->id())).first->get_iface());
+    if (cluster->has_limiter_)
+      save_link(out, cluster->private_links_.at(cluster->node_pos_with_loopback(vertex->id())).first->get_iface());
+  }
+  /* The gateways are leaves, that are only created when sealing the cluster */
+  out.put(static_cast<uint32_t>(zone->gateways_.size()));
+  for (auto const& [name, gateway] : zone->gateways_) {
+    xbt_enforce(gateway->get_englobing_zone() == zone, "Cannot snapshot the gateway %s of cluster %s",
+                gateway->get_cname(), zone->get_cname());
+    out.put_string(name);
+    out.put(static_cast<uint64_t>(gateway->id()));
+  }
+}
+
+/* Saves the declared routes and the gateways of each netzone after the ones of its children, as the netzones are sealed
+ * in this order when loading the snapshot */
+void PlatformSnapshot::save_routes(SnapshotWriter& out, const NetZoneImpl* zone)
+{
+  for (auto const* child : zone->get_children())
+    save_routes(out, child);
+
+  out.put(out.get_zone_rank(zone));
+  if (is_cluster(get_kind(zone))) // Everything is built when the cluster is sealed
+    return;
+
+  /* Get the routes as they were declared (not symmetrical anymore), except the loopbacks that the seal adds */
+  const auto* loopback = zone->get_network_model()->loopback_.get();
+  const auto vertices  = zone->get_vertices();
+  std::vector<Route> routes;
+  auto add_route = [&routes, &vertices, loopback](unsigned long src, unsigned long dst, const Route& route) {
+    if (src == dst && route.link_list_.size() == 1 && route.link_list_.front() == loopback)
+      return;
+    auto& saved      = routes.emplace_back(vertices[src], vertices[dst], route.gw_src_, route.gw_dst_);
+    saved.link_list_ = route.link_list_;
+  };
+
+  if (const auto* full = dynamic_cast<const FullZone*>(zone)) {
+    for (unsigned long src = 0; src < vertices.size(); src++)
+      for (unsigned long dst = 0; dst < vertices.size(); dst++)
+        if (uint32_t entry = full->routing_table_[src * full->table_stride_ + dst]; entry != 0)
+          add_route(src, dst, *full->distinct_routes_[entry - 1]);
+  } else if (const auto* floyd = dynamic_cast<const FloydZone*>(zone)) {
+    std::map<uint64_t, const Route*> sorted; // Deterministic order
+    for (auto const& [key, route] : floyd->link_table_)
+      sorted.try_emplace(key, route.get());
+    for (auto const& [key, route] : sorted)
+      add_route(key >> 32, key & 0xffffffffUL, *route);
+  } else if (const auto* dijkstra = dynamic_cast<const DijkstraZone*>(zone)) {
+    for (size_t i = 0; i < dijkstra->edge_routes_.size(); i++)
+      add_route(dijkstra->edge_ends_[i].first, dijkstra->edge_ends_[i].second, *dijkstra->edge_routes_[i]);
+  } else if (const auto* star = dynamic_cast<const StarZone*>(zone)) {
+    std::map<unsigned long, const StarZone::StarRoute*> sorted;
+    for (auto const& [id, route] : star->routes_)
+      sorted.try_emplace(id, &route);
+    for (auto const& [id, star_route] : sorted) {
+      NetPoint* netpoint = vertices[id];
+      if (star_route->has_loopback())
+        routes.emplace_back(netpoint, netpoint, nullptr, nullptr).link_list_ = star_route->loopback;
+      if (star_route->has_links_up())
+        routes.emplace_back(netpoint, nullptr, star_route->gateway, nullptr).link_list_ = star_route->links_up;
+      if (star_route->has_links_down())
+        routes.emplace_back(nullptr, netpoint, nullptr, star_route->gateway).link_list_ = star_route->links_down;
+    }
+  }
+
+  out.put(static_cast<uint64_t>(routes.size()));
+  for (auto const& route : routes) {
+    out.put_netpoint(route.src_);
+    out.put_netpoint(route.dst_);
+    out.put_netpoint(route.gw_src_);
+    out.put_netpoint(route.gw_dst_);
+    out.put(static_cast<uint32_t>(route.link_list_.size()));
+    for (auto const* link : route.link_list_)
+      out.put_link(link);
+  }
+
+  out.put(static_cast<uint32_t>(zone->gateways_.size()));
+  for (auto const& [name, gateway] : zone->gateways_) {
+    out.put_string(name);
+    out.put_netpoint(gateway);
+  }
+
+  /* The tables that are long to compute */
+  const auto* floyd = dynamic_cast<const FloydZone*>(zone);
+  out.put(static_cast<uint8_t>(floyd != nullptr));
+  if (floyd)
+    out.put_vector(floyd->predecessor_table_);
+}
+
+/*************************************************************************************************/
+NetZoneImpl* PlatformSnapshot::load_zone(SnapshotReader& in, NetZoneImpl* parent)
+{
+  std::string name = in.get_string();
+  auto kind        = in.get<ZoneKind>();
+  auto properties  = in.get_properties();
+
+  NetZoneImpl* zone;
+  if (parent == nullptr) { // The root netzone always exists already
+    zone = s4u::Engine::get_instance()->get_netzone_root()->get_impl();
+    xbt_enforce(kind == ZoneKind::FULL, "Invalid platform snapshot: the root netzone should be a Full one");
+    xbt_enforce(zone->get_table_size() == 0 && zone->links_.empty() && zone->get_children().empty(),
+                "Cannot load a platform snapshot into a platform that is not empty");
+  } else if (is_cluster(kind)) {
+    zone = load_cluster(in, parent, kind, name);
+    zone->get_iface()->set_properties(properties);
+    return zone;
+  } else {
+    s4u::NetZone* parent_iface = parent->get_iface();
+    switch (kind) {
+      case ZoneKind::FULL:
+        zone = parent_iface->add_netzone_full(name)->get_impl();
+        break;
+      case ZoneKind::FLOYD:
+        zone = parent_iface->add_netzone_floyd(name)->get_impl();
+        break;
+      case ZoneKind::DIJKSTRA:
+      case ZoneKind::DIJKSTRA_CACHE:
+        zone = parent_iface->add_netzone_dijkstra(name, kind == ZoneKind::DIJKSTRA_CACHE)->get_impl();
+        break;
+      case ZoneKind::STAR:
+        zone = parent_iface->add_netzone_star(name)->get_impl();
+        break;
+      case ZoneKind::EMPTY:
+        zone = parent_iface->add_netzone_empty(name)->get_impl();
+        break;
+      default:
+        throw std::invalid_argument("Invalid platform snapshot: unknown kind of netzone for " + name);
+    }
+  }
+  zone->get_iface()->set_properties(properties);
+  in.add_zone(zone);
+
+  s4u::NetZone* iface = zone->get_iface();
+  for (auto count = in.get<uint32_t>(); count > 0; count--) {
+    std::string link_name = in.get_string();
+    LinkDesc up           = read_link(in);
+    LinkDesc down         = read_link(in);
+    const auto* link      = iface->add_split_duplex_link(link_name, up.bandwidth, down.bandwidth);
+    in.links.push_back(setup_link(link->get_link_up(), up));
+    in.links.push_back(setup_link(link->get_link_down(), down));
+  }
+  for (auto count = in.get<uint32_t>(); count > 0; count--) {
+    LinkDesc desc = read_link(in);
+    in.links.push_back(setup_link(iface->add_link(desc.name, desc.bandwidth), desc));
+  }
+
+  for (auto count = in.get<uint64_t>(); count > 0; count--) {
+    switch (in.get<VertexKind>()) {
+      case VertexKind::NETZONE:
+        load_zone(in, zone);
+        break;
+      case VertexKind::ROUTER:
+        in.netpoints.push_back(zone->add_router(in.get_string()));
+        break;
+      case VertexKind::HOST:
+        in.netpoints.push_back(create_host(iface, read_host(in))->get_netpoint());
+        break;
+      default:
+        throw std::invalid_argument("Invalid platform snapshot: unknown kind of vertex in " + name);
+    }
+  }
+  return zone;
+}
+
+NetZoneImpl* PlatformSnapshot::load_cluster(SnapshotReader& in, NetZoneImpl* parent, ZoneKind kind,
+                                            const std::string& name)
+{
+  auto bandwidth = in.get<double>();
+  auto latency   = in.get<double>();
+  auto policy    = in.get<s4u::Link::SharingPolicy>();
+
+  s4u::NetZone* zone;
+  if (kind == ZoneKind::TORUS) {
+    auto dimensions = in.get_vector<uint64_t>();
+    zone            = parent->get_iface()->add_netzone_torus(
+        name, std::vector<unsigned long>(dimensions.begin(), dimensions.end()), bandwidth, latency, policy);
+  } else if (kind == ZoneKind::FAT_TREE) {
+    auto levels = in.get<uint32_t>();
+    auto down   = in.get_vector<unsigned int>();
+    auto up     = in.get_vector<unsigned int>();
+    auto count  = in.get_vector<unsigned int>();
+    zone        = parent->get_iface()->add_netzone_fatTree(name, levels, down, up, count, bandwidth, latency, policy);
+  } else {
+    std::array<unsigned int, 7> params;
+    for (auto& param : params)
+      param = in.get<uint32_t>();
+    zone = parent->get_iface()->add_netzone_dragonfly(name, {params[0], params[1]}, {params[2], params[3]},
+                                                      {params[4], params[5]}, params[6], bandwidth, latency, policy);
+  }
+  in.add_zone(zone->get_impl());
+
+  /* The leaves are created by the callbacks when the cluster gets sealed (or even later for lazy links) */
+  auto desc         = std::make_shared<ClusterDesc>();
+  bool has_loopback = in.get<uint8_t>() != 0;
+  bool has_limiter  = in.get<uint8_t>() != 0;
+  desc->leaves.resize(in.get<uint64_t>());
+  for (auto& leaf : desc->leaves) {
+    leaf.host = read_host(in);
+    if (has_loopback)
+      leaf.loopback = read_link(in);
+    if (has_limiter)
+      leaf.limiter = read_link(in);
+  }
+  for (auto count = in.get<uint32_t>(); count > 0; count--) {
+    std::string gateway_name = in.get_string();
+    desc->gateways.emplace_back(gateway_name, in.get<uint64_t>());
+  }
+  in.leaves_rank[zone->get_impl()] = in.netpoints.size();
+  in.netpoints.resize(in.netpoints.size() + desc->leaves.size(), nullptr);
+
+  zone->set_host_cb([desc](s4u::NetZone* cluster, const std::vector<unsigned long>& /*coord*/, unsigned long id) {
+    s4u::Host* host = create_host(cluster, desc->leaves.at(id).host);
+    for (auto const& [gateway_name, position] : desc->gateways)
+      if (position == id)
+        cluster->set_gateway(gateway_name, host->get_netpoint());
+    return host;
+  });
+  if (has_loopback)
+    zone->set_loopback_cb([desc](s4u::NetZone* cluster, const std::vector<unsigned long>& /*coord*/, unsigned long id) {
+      const LinkDesc& link = desc->leaves.at(id).loopback;
+      return setup_link(cluster->add_link(link.name, link.bandwidth), link);
+    });
+  if (has_limiter)
+    zone->set_limiter_cb([desc](s4u::NetZone* cluster, const std::vector<unsigned long>& /*coord*/, unsigned long id) {
+      const LinkDesc& link = desc->leaves.at(id).limiter;
+      return setup_link(cluster->add_link(link.name, link.bandwidth), link);
+    });
+  return zone->get_impl();
+}
+
+void PlatformSnapshot::load_routes(SnapshotReader& in)
+{
+  auto rank = in.get<uint32_t>();
+  xbt_enforce(rank < in.zones.size(), "Invalid netzone in platform snapshot");
+  NetZoneImpl* zone = in.zones[rank];
+
+  if (auto it = in.leaves_rank.find(zone); it != in.leaves_rank.end()) { // Clusters create their leaves when sealed
+    zone->seal();
+    const auto vertices = zone->get_vertices();
+    std::copy(vertices.begin(), vertices.end(), in.netpoints.begin() + static_cast<long>(it->second));
+    return;
+  }
+
+  std::vector<s4u::LinkInRoute> links;
+  for (auto count = in.get<uint64_t>(); count > 0; count--) {
+    NetPoint* src    = in.get_netpoint();
+    NetPoint* dst    = in.get_netpoint();
+    NetPoint* gw_src = in.get_netpoint();
+    NetPoint* gw_dst = in.get_netpoint();
+    links.clear();
+    for (auto link_count = in.get<uint32_t>(); link_count > 0; link_count--)
+      links.emplace_back(in.get_link());
+    zone->add_route(src, dst, gw_src, gw_dst, links, false);
+  }
+
+  for (auto count = in.get<uint32_t>(); count > 0; count--) {
+    std::string name = in.get_string();
+    zone->set_gateway(name, in.get_netpoint());
+  }
+
+  if (in.get<uint8_t>() != 0) {
+    auto* floyd = dynamic_cast<FloydZone*>(zone);
+    xbt_enforce(floyd, "Invalid platform snapshot: netzone %s has no Floyd routing", zone->get_cname());
+    floyd->predecessor_table_     = in.get_vector<int32_t>();
+    floyd->restored_predecessors_ = true;
+  }
+
+  if (zone->get_parent() != nullptr) // The root is sealed with the rest of the platform
+    zone->seal();
+}
+
+/*************************************************************************************************/
+bool PlatformSnapshot::is_snapshot(const std::string& path)
+{
+  std::array<char, MAGIC.size()> magic;
+  std::ifstream stream(path, std::ios::binary);
+  return stream.read(magic.data(), magic.size()) && magic == MAGIC;
+}
+
+void PlatformSnapshot::save(const NetZoneImpl* root, const std::string& path)
+{
+  XBT_DEBUG("Save the platform snapshot '%s'", path.c_str());
+  SnapshotWriter out(path);
+  out.put(MAGIC);
+  out.put(VERSION);
+  out.put(BYTE_ORDER_MARKER);
+  save_zone(out, root);
+  save_routes(out, root);
+  out.close();
+}
+
+void PlatformSnapshot::load(const std::string& path)
+{
+  XBT_DEBUG("Load the platform snapshot '%s'", path.c_str());
+  SnapshotReader in(path);
+  auto magic = in.get<std::array<char, MAGIC.size()>>();
+  xbt_enforce(magic == MAGIC, "'%s' is not a platform snapshot", path.c_str());
+  xbt_enforce(in.get<uint32_t>() == VERSION, "Unsupported version of platform snapshot in '%s'", path.c_str());
+  xbt_enforce(in.get<uint32_t>() == BYTE_ORDER_MARKER,
+              "The platform snapshot '%s' was saved on a machine with another byte order", path.c_str());
+  load_zone(in, nullptr);
+  while (not in.at_end())
+    load_routes(in);
+  s4u::Engine::on_platform_created();
+}
+
+} // namespace simgrid::kernel::routing
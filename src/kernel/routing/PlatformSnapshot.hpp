@@ -0,0 +1,50 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_KERNEL_ROUTING_PLATFORMSNAPSHOT_HPP
+#define SIMGRID_KERNEL_ROUTING_PLATFORMSNAPSHOT_HPP
+
+#include <simgrid/forward.h>
+
+#include <cstdint>
+#include <string>
+
+namespace simgrid::kernel::routing {
+
+class SnapshotReader;
+class SnapshotWriter;
+enum class ZoneKind : uint8_t;
+
+/** @brief Binary snapshots of a sealed platform, which load much faster than the platform description they come from.
+ *
+ * A snapshot replays the construction of the platform through the NetZone API (netzones, hosts, disks, links, routers,
+ * declared routes and gateways), without any parsing. It also stores the routing tables that are long to compute (the
+ * predecessors of the Floyd zones), so that sealing the loaded platform does not compute them again. The file is
+ * mapped in memory when loading it, and these tables are copied from the mapping in one go.
+ *
+ * The netzones built by the user code (Vivaldi, Wi-Fi, clusters whose leaves are netzones or whose links are created
+ * lazily) cannot be saved, nor can the bypass routes. The profiles attached to the resources are not saved either.
+ */
+class XBT_PRIVATE PlatformSnapshot {
+  static ZoneKind get_kind(const NetZoneImpl* zone);
+  static void save_zone(SnapshotWriter& out, const NetZoneImpl* zone);
+  static void save_cluster(SnapshotWriter& out, const NetZoneImpl* zone);
+  static void save_routes(SnapshotWriter& out, const NetZoneImpl* zone);
+  static NetZoneImpl* load_zone(SnapshotReader& in, NetZoneImpl* parent);
+  static NetZoneImpl* load_cluster(SnapshotReader& in, NetZoneImpl* parent, ZoneKind kind, const std::string& name);
+  static void load_routes(SnapshotReader& in);
+
+public:
+  /** @brief Whether that file starts like a platform snapshot */
+  static bool is_snapshot(const std::string& path);
+  /** @brief Saves the platform rooted at @c root (which must be sealed) into that file */
+  static void save(const NetZoneImpl* root, const std::string& path);
+  /** @brief Rebuilds the platform saved in that file into the (empty) root netzone of the current engine */
+  static void load(const std::string& path);
+};
+
+} // namespace simgrid::kernel::routing
+
+#endif
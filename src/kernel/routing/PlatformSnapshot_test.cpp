@@ -0,0 +1,150 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/3rd-party/catch.hpp"
+
+#include "simgrid/s4u/Disk.hpp"
+#include "simgrid/kernel/ProfileBuilder.hpp"
+#include "simgrid/s4u/Engine.hpp"
+#include "simgrid/s4u/Host.hpp"
+#include "simgrid/s4u/Link.hpp"
+#include "simgrid/s4u/NetZone.hpp"
+#include "src/kernel/routing/NetZone_test.hpp" // CreateHost callback
+
+#include <cstdio>
+#include <filesystem>
+
+namespace sg4 = simgrid::s4u;
+
+/* A Floyd ring and a star connected through the root, plus a torus with loopbacks */
+static void build_platform(const sg4::Engine& e)
+{
+  auto* root = e.get_netzone_root();
+
+  auto* ring = root->add_netzone_floyd("ring");
+  std::vector<const sg4::Host*> hosts;
+  for (int i = 0; i < 6; i++)
+    hosts.push_back(ring->add_host("ring-" + std::to_string(i), std::vector<double>{1e9, 5e8})->set_core_count(2));
+  ring->add_host("storage", 1e9)->set_property("role", "storage")->add_disk("ssd", 2e8, 1e8)->seal();
+  for (int i = 0; i < 6; i++) {
+    const auto* link = ring->add_link("ring-link-" + std::to_string(i), 1e9)->set_latency(1e-6);
+    ring->add_route(hosts[i], hosts[(i + 1) % 6], {link});
+  }
+  ring->add_route(sg4::Host::by_name("storage"), hosts[3], {ring->add_link("storage-link", 1e8)->set_latency(1e-5)});
+  ring->set_gateway(hosts[0]);
+  ring->seal();
+
+  auto* star = root->add_netzone_star("star");
+  for (int i = 0; i < 4; i++) {
+    const auto* host = star->add_host("star-" + std::to_string(i), 2e9);
+    const auto* link = star->add_split_duplex_link("star-link-" + std::to_string(i), 1e9)->set_latency(1e-4);
+    star->add_route(host, nullptr, {{link, sg4::LinkInRoute::Direction::UP}}, true);
+  }
+  star->set_gateway(star->add_router("star-router"));
+  star->set_property("kind", "star");
+  star->seal();
+
+  root->add_route(ring, star, {root->add_link("backbone", 1e10)->set_latency(1e-3)->set_property("wan", "yes")});
+
+  root->add_netzone_torus("torus", {2, 2, 2}, 1e9, 1e-5, sg4::Link::SharingPolicy::SPLITDUPLEX)
+      ->set_host_cb(CreateHost{})
+      ->set_loopback_cb([](sg4::NetZone* zone, const std::vector<unsigned long>& /*coord*/, unsigned long id) {
+        return zone->add_link("torus-loopback-" + std::to_string(id), 1e10)
+            ->set_sharing_policy(sg4::Link::SharingPolicy::FATPIPE);
+      })
+      ->seal();
+}
+
+/* Describes the routes between some pairs of hosts, as the names of their links and their latency */
+static std::vector<std::string> describe_routes(const sg4::Engine& e)
+{
+  std::vector<std::pair<std::string, std::string>> pairs = {
+      {"ring-0", "ring-3"}, {"ring-5", "ring-1"}, {"storage", "ring-1"}, {"ring-2", "star-3"},
+      {"star-1", "star-2"}, {"star-0", "ring-4"}, {"0", "7"},          {"3", "3"}};
+  std::vector<std::string> res;
+  for (auto const& [src, dst] : pairs) {
+    std::vector<sg4::Link*> links;
+    double latency = 0;
+    e.host_by_name(src)->route_to(e.host_by_name(dst), links, &latency);
+    std::string desc = src + "->" + dst + ":" + std::to_string(latency);
+    for (auto const* link : links)
+      desc += " " + link->get_name();
+    res.push_back(desc);
+  }
+  return res;
+}
+
+TEST_CASE("kernel::routing::PlatformSnapshot: save and load a platform", "")
+{
+  std::string path = (std::filesystem::temp_directory_path() / "simgrid-snapshot-test.bin").string();
+  std::vector<std::string> expected;
+  size_t host_count;
+  size_t link_count;
+  {
+    sg4::Engine e("test");
+    build_platform(e);
+    e.save_platform_snapshot(path);
+    expected   = describe_routes(e);
+    host_count = e.get_host_count();
+    link_count = e.get_link_count();
+  }
+
+  sg4::Engine e("test");
+  e.load_platform(path);
+  std::remove(path.c_str());
+  /* seal_platform() only does its job once per process, so seal the root zone directly: the loaded platform must seal */
+  auto* root = e.get_netzone_root();
+  REQUIRE_NOTHROW(root->seal());
+  REQUIRE_THROWS(root->add_router("too-late"));
+
+  REQUIRE(e.get_host_count() == host_count);
+  REQUIRE(e.get_link_count() == link_count);
+  REQUIRE(describe_routes(e) == expected);
+
+  const auto* host = e.host_by_name("ring-2");
+  REQUIRE(host->get_core_count() == 2);
+  REQUIRE(host->get_pstate_count() == 2);
+  REQUIRE(host->get_pstate_speed(1) == 5e8);
+  const auto* storage = e.host_by_name("storage");
+  REQUIRE(storage->get_property("role") == std::string("storage"));
+  REQUIRE(storage->get_disks().size() == 1);
+  REQUIRE(storage->get_disks().front()->get_write_bandwidth() == 1e8);
+  REQUIRE(e.link_by_name("backbone")->get_property("wan") == std::string("yes"));
+  REQUIRE(e.split_duplex_link_by_name("star-link-2")->get_link_up()->get_latency() == 1e-4);
+  REQUIRE(e.link_by_name("torus-loopback-5")->get_sharing_policy() == sg4::Link::SharingPolicy::FATPIPE);
+  REQUIRE(e.netzone_by_name_or_null("star")->get_property("kind") == std::string("star"));
+}
+
+TEST_CASE("kernel::routing::PlatformSnapshot: unsupported platforms", "")
+{
+  std::string path = (std::filesystem::temp_directory_path() / "simgrid-snapshot-test.bin").string();
+  sg4::Engine e("test");
+  e.get_netzone_root()->add_netzone_vivaldi("vivaldi")->seal();
+  REQUIRE_THROWS(e.save_platform_snapshot(path));
+  std::remove(path.c_str());
+}
+
+TEST_CASE("kernel::routing::PlatformSnapshot: profiles cannot be saved", "")
+{
+  std::string path = (std::filesystem::temp_directory_path() / "simgrid-snapshot-test.bin").string();
+  sg4::Engine e("test");
+  auto* root = e.get_netzone_root();
+  auto* host = root->add_host("host", 1e9);
+  auto* link = root->add_link("link", 1e9);
+  root->add_route(host, root->add_host("other", 1e9), {link});
+  REQUIRE_NOTHROW(e.save_platform_snapshot(path));
+
+  SECTION("Profile on a link")
+  {
+    link->set_bandwidth_profile(simgrid::kernel::profile::ProfileBuilder::from_string("link-bw", "0 0.5\n", -1));
+    REQUIRE_THROWS(e.save_platform_snapshot(path));
+  }
+  SECTION("Profile on a host")
+  {
+    host->set_speed_profile(simgrid::kernel::profile::ProfileBuilder::from_string("host-speed", "0 0.5\n", -1));
+    REQUIRE_THROWS(e.save_platform_snapshot(path));
+  }
+  std::remove(path.c_str());
+}
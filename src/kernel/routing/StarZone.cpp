@@ -8,6 +8,8 @@
 #include "src/kernel/resource/NetworkModel.hpp"
 #include "xbt/string.hpp"
 
+#include <algorithm>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(ker_routing_star, ker_platform, "Kernel Star Routing");
 
 namespace simgrid {
@@ -15,11 +17,12 @@ namespace kernel::routing {
 StarZone::StarZone(const std::string& name) : ClusterZone(name) {}
 
 void StarZone::add_links_to_route(const std::vector<resource::StandardLinkImpl*>& links, Route* route, double* latency,
-                                  std::unordered_set<resource::StandardLinkImpl*>& added_links) const
+                                  size_t first) const
 {
   for (auto* link : links) {
-    /* do not add duplicated links in route->link_list_ */
-    if (not added_links.insert(link).second)
+    /* do not add duplicated links in route->link_list_ (the routes of a star are short, a set would cost more) */
+    if (std::find(route->link_list_.begin() + static_cast<std::ptrdiff_t>(first), route->link_list_.end(), link) !=
+        route->link_list_.end())
       continue;
     add_link_latency(route->link_list_, link, latency);
   }
@@ -32,10 +35,10 @@ void StarZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
 
   const auto& src_route = routes_.at(src->id());
   const auto& dst_route = routes_.at(dst->id());
-  std::unordered_set<resource::StandardLinkImpl*> added_links;
+  size_t first          = route->link_list_.size();
   /* loopback */
   if (src == dst && src_route.has_loopback()) {
-    add_links_to_route(src_route.loopback, route, latency, added_links);
+    add_links_to_route(src_route.loopback, route, latency, first);
     return;
   }
 
@@ -47,10 +50,10 @@ void StarZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
              src->get_cname(), dst->get_cname());
 
   /* going UP */
-  add_links_to_route(src_route.links_up, route, latency, added_links);
+  add_links_to_route(src_route.links_up, route, latency, first);
 
   /* going DOWN */
-  add_links_to_route(dst_route.links_down, route, latency, added_links);
+  add_links_to_route(dst_route.links_down, route, latency, first);
   /* gateways */
   route->gw_src_ = src_route.gateway;
   route->gw_dst_ = dst_route.gateway;
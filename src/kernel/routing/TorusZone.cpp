@@ -21,42 +21,54 @@ namespace kernel::routing {
 void TorusZone::create_torus_links(unsigned long id, int rank, unsigned long position)
 {
   /* Create all links that exist in the torus. Each rank creates @a dimensions-1 links */
-  unsigned long dim_product = 1; // Needed to calculate the next neighbor_id
-
-  for (unsigned long j = 0; j < dimensions_.size(); j++) {
-    unsigned long current_dimension =
-        dimensions_[j]; // which dimension are we currently in?
-                        // we need to iterate over all dimensions and create all links there
-    // The other node the link connects
-    unsigned long neighbor_rank_id = ((rank / dim_product) % current_dimension == current_dimension - 1)
-                                         ? rank - (current_dimension - 1) * dim_product
-                                         : rank + dim_product;
-    // name of neighbor is not right for non contiguous cluster radicals (as id != rank in this case)
-    std::string link_id = get_name() + "_link_from_" + std::to_string(id) + "_to_" + std::to_string(neighbor_rank_id);
-    const s4u::Link* linkup;
-    const s4u::Link* linkdown;
-    if (get_link_sharing_policy() == s4u::Link::SharingPolicy::SPLITDUPLEX) {
-      linkup   = add_link(link_id + "_UP", {get_link_bandwidth()})->set_latency(get_link_latency())->seal();
-      linkdown = add_link(link_id + "_DOWN", {get_link_bandwidth()})->set_latency(get_link_latency())->seal();
-
-    } else {
-      linkup   = add_link(link_id, {get_link_bandwidth()})->set_latency(get_link_latency())->seal();
-      linkdown = linkup;
-    }
-    /*
-     * Add the link to its appropriate position.
-     * Note that position rankId*(xbt_dynar_length(dimensions)+has_loopback?+has_limiter?)
-     * holds the link "rankId->rankId"
-     */
-    add_private_link_at(position + j, {linkup->get_impl(), linkdown->get_impl()});
-    dim_product *= current_dimension;
+  for (unsigned long j = 0; j < dimensions_.size(); j++)
+    create_torus_link(id, rank, position, j);
+}
+
+void TorusZone::create_torus_link(unsigned long id, unsigned long rank, unsigned long position, unsigned long j)
+{
+  unsigned long dim_product       = dim_products_[j]; // Needed to calculate the next neighbor_id
+  unsigned long current_dimension = dimensions_[j];   // which dimension are we currently in?
+  // The other node the link connects
+  unsigned long neighbor_rank_id = ((rank / dim_product) % current_dimension == current_dimension - 1)
+                                       ? rank - (current_dimension - 1) * dim_product
+                                       : rank + dim_product;
+  // name of neighbor is not right for non contiguous cluster radicals (as id != rank in this case)
+  std::string link_id = get_name() + "_link_from_" + std::to_string(id) + "_to_" + std::to_string(neighbor_rank_id);
+  const s4u::Link* linkup;
+  const s4u::Link* linkdown;
+  if (get_link_sharing_policy() == s4u::Link::SharingPolicy::SPLITDUPLEX) {
+    linkup   = add_link(link_id + "_UP", {get_link_bandwidth()})->set_latency(get_link_latency())->seal();
+    linkdown = add_link(link_id + "_DOWN", {get_link_bandwidth()})->set_latency(get_link_latency())->seal();
+
+  } else {
+    linkup   = add_link(link_id, {get_link_bandwidth()})->set_latency(get_link_latency())->seal();
+    linkdown = linkup;
   }
+  /*
+   * Add the link to its appropriate position.
+   * Note that position rankId*(xbt_dynar_length(dimensions)+has_loopback?+has_limiter?)
+   * holds the link "rankId->rankId"
+   */
+  add_private_link_at(position + j, {linkup->get_impl(), linkdown->get_impl()});
+}
+
+void TorusZone::create_lazy_links_at(unsigned long position)
+{
+  unsigned long id    = position / get_num_links_per_node();
+  unsigned long first = node_pos_with_loopback_limiter(id);
+  if (position < first) // loopback or limiter
+    ClusterBase::create_lazy_links_at(position);
+  else
+    create_torus_link(id, get_leaf_position(id), first, position - first);
 }
 
 void TorusZone::set_topology(const std::vector<unsigned long>& dimensions)
 {
   xbt_assert(not dimensions.empty(), "Torus dimensions cannot be empty");
   dimensions_ = dimensions;
+  dim_products_.resize(dimensions.size());
+  std::exclusive_scan(dimensions.begin(), dimensions.end(), dim_products_.begin(), 1UL, std::multiplies<>());
   set_tot_elements(std::accumulate(dimensions.begin(), dimensions.end(), 1, std::multiplies<>()));
   set_cluster_dimensions(dimensions);
   set_num_links_per_node(dimensions_.size());
@@ -82,19 +94,13 @@ void TorusZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
    */
 
   /*
-   * Arrays that hold the coordinates of the current node and the target; comparing the values at the i-th position of
-   * both arrays, we can easily assess whether we need to route into this dimension or not.
+   * The coordinates of every node are precomputed at seal time; comparing the values at the i-th position of the
+   * current node and of the target, we can easily assess whether we need to route into this dimension or not.
    */
   const unsigned long dsize = dimensions_.size();
-  std::vector<unsigned long> myCoords(dsize);
-  std::vector<unsigned long> targetCoords(dsize);
-  unsigned int dim_size_product = 1;
-  for (unsigned long i = 0; i < dsize; i++) {
-    unsigned long cur_dim_size = dimensions_[i];
-    myCoords[i]           = (src->id() / dim_size_product) % cur_dim_size;
-    targetCoords[i]       = (dst->id() / dim_size_product) % cur_dim_size;
-    dim_size_product *= cur_dim_size;
-  }
+  xbt_assert((std::max(src->id(), dst->id()) + 1) * dsize <= coords_.size(), "Torus %s: unknown node", get_cname());
+  const unsigned long* myCoords     = &coords_[src->id() * dsize];
+  const unsigned long* targetCoords = &coords_[dst->id() * dsize];
 
   /*
    * linkOffset describes the offset where the link we want to use is stored(+1 is added because each node has a link
@@ -105,18 +111,18 @@ void TorusZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
   bool use_lnk_up = false; // Is this link of the form "cur -> next" or "next -> cur"? false means: next -> cur
   unsigned long current_node = src->id();
   while (current_node != dst->id()) {
-    unsigned long next_node   = 0;
-    unsigned long dim_product = 1; // First, we will route in x-dimension
+    unsigned long next_node            = 0;
+    const unsigned long* currentCoords = &coords_[current_node * dsize];
     for (unsigned long j = 0; j < dsize; j++) {
-      const unsigned long cur_dim = dimensions_[j];
-      // current_node/dim_product = position in current dimension
-      if ((current_node / dim_product) % cur_dim != (dst->id() / dim_product) % cur_dim) {
+      const unsigned long cur_dim     = dimensions_[j];
+      const unsigned long dim_product = dim_products_[j];
+      if (currentCoords[j] != targetCoords[j]) {
         if ((targetCoords[j] > myCoords[j] &&
              targetCoords[j] <= myCoords[j] + cur_dim / 2) // Is the target node on the right, without the wrap-around?
             ||
             (myCoords[j] > cur_dim / 2 && (myCoords[j] + cur_dim / 2) % cur_dim >=
                                               targetCoords[j])) { // Or do we need to use the wrap around to reach it?
-          if ((current_node / dim_product) % cur_dim == cur_dim - 1)
+          if (currentCoords[j] == cur_dim - 1)
             next_node = (current_node + dim_product - dim_product * cur_dim);
           else
             next_node = (current_node + dim_product);
@@ -125,7 +131,7 @@ void TorusZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
           linkOffset = node_pos_with_loopback_limiter(current_node) + j;
           use_lnk_up = true;
         } else { // Route to the left
-          if ((current_node / dim_product) % cur_dim == 0)
+          if (currentCoords[j] == 0)
             next_node = (current_node - dim_product + dim_product * cur_dim);
           else
             next_node = (current_node - dim_product);
@@ -138,8 +144,6 @@ void TorusZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
                   next_node, linkOffset);
         break;
       }
-
-      dim_product *= cur_dim;
     }
 
     if (has_limiter()) { // limiter for sender
@@ -166,10 +170,19 @@ void TorusZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route*
 
 void TorusZone::do_seal()
 {
+  set_lazy_links(lazy_links_requested());
   for (int i = 0; i < get_tot_elements(); i++) {
     auto [netpoint, loopback, limiter] = fill_leaf_from_cb(i);
-    create_torus_links(netpoint->id(), i, node_pos_with_loopback_limiter(netpoint->id()));
+    if (not has_lazy_links())
+      create_torus_links(netpoint->id(), i, node_pos_with_loopback_limiter(netpoint->id()));
   }
+
+  /* Precompute the coordinates of every node, so that routing does not need to decompose the ids again */
+  const unsigned long dsize = dimensions_.size();
+  coords_.resize(get_table_size() * dsize);
+  for (unsigned long id = 0; id < get_table_size(); id++)
+    for (unsigned long j = 0; j < dsize; j++)
+      coords_[id * dsize + j] = (id / dim_products_[j]) % dimensions_[j];
 }
 
 } // namespace kernel::routing
@@ -50,3 +50,50 @@ TEST_CASE("kernel::routing::TorusZone: Invalid params", "")
                       std::invalid_argument);
   }
 }
+
+TEST_CASE("kernel::routing::TorusZone: Lazy links", "")
+{
+  simgrid::s4u::Engine e("test");
+
+  auto build = [&e](const std::string& name, bool lazy) {
+    simgrid::s4u::Engine::set_config("routing/lazy-cluster-links", lazy);
+    auto* zone = e.get_netzone_root()->add_netzone_torus(name, {4, 4}, 1e9, 10,
+                                                         simgrid::s4u::Link::SharingPolicy::SPLITDUPLEX);
+    zone->set_host_cb([name](simgrid::s4u::NetZone* z, const std::vector<unsigned long>& /*coord*/, unsigned long id) {
+      return z->add_host(name + "-" + std::to_string(id), "1Gf");
+    });
+    zone->set_loopback_cb([name](simgrid::s4u::NetZone* z, const std::vector<unsigned long>& /*coord*/,
+                                 unsigned long id) { return z->add_link(name + "-lo" + std::to_string(id), 1e10); });
+    zone->seal();
+  };
+  auto route_names = [&e](const std::string& name, int src, int dst) {
+    std::vector<simgrid::s4u::Link*> links;
+    e.host_by_name(name + "-" + std::to_string(src))->route_to(e.host_by_name(name + "-" + std::to_string(dst)), links,
+                                                               nullptr);
+    std::vector<std::string> names;
+    for (const auto* link : links)
+      names.push_back(link->get_name().substr(name.size()));
+    return names;
+  };
+
+  auto count_links = [&e](const std::string& name) { // Not the loopback of the network model, if already created
+    return e.get_filtered_links([&name](const simgrid::s4u::Link* link) { return link->get_name().starts_with(name); })
+        .size();
+  };
+
+  build("eager", false);
+  size_t eager_links = count_links("eager");
+  REQUIRE(eager_links == 16 * (1 + 2 * 2)); // one loopback and two split-duplex links per node
+  build("lazy", true);
+  REQUIRE(count_links("lazy") == 0);
+
+  REQUIRE(route_names("lazy", 0, 10) == route_names("eager", 0, 10));
+  REQUIRE(route_names("lazy", 5, 5) == route_names("eager", 5, 5));
+  REQUIRE(route_names("lazy", 15, 1) == route_names("eager", 15, 1));
+  size_t lazy_links = count_links("lazy");
+  REQUIRE(lazy_links > 0);
+  REQUIRE(lazy_links < eager_links);
+
+  route_names("lazy", 0, 10); // Already created links are reused
+  REQUIRE(count_links("lazy") == lazy_links);
+}
@@ -25,5 +25,6 @@ XBT_PUBLIC int simgrid_parse_get_int(const std::string& s);
 
 XBT_PUBLIC void simgrid_parse(bool fire_on_platform_created_callback); /* Entry-point to the parser */
 XBT_PUBLIC void parse_platform_file(const std::string& file);
+XBT_PUBLIC void parse_csv_deployment(const std::string& file);
 
 #endif
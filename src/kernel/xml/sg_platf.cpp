@@ -28,11 +28,17 @@
 #include "src/kernel/xml/platf.hpp"
 #include "src/kernel/xml/platf_private.hpp"
 #include "src/simgrid/sg_config.hpp"
+#include "xbt/file.hpp"
+#include "xbt/intern.hpp"
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 
 XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(platf_parse);
 
@@ -158,7 +164,7 @@ sg_platf_cluster_create_host(const simgrid::kernel::routing::ClusterCreationArgs
              "(total = %zu). Check the 'radical' parameter in XML",
              cluster->id.c_str(), id, cluster->radicals.size());
 
-  std::string host_id = cluster->prefix + std::to_string(cluster->radicals[id]) + cluster->suffix;
+  auto host_id = simgrid::xbt::InternedString::from_pattern(cluster->prefix, cluster->radicals[id], cluster->suffix);
   XBT_DEBUG("Cluster: creating host=%s speed=%f", host_id.c_str(), cluster->speeds.front());
   simgrid::s4u::Host* host = zone->add_host(host_id, cluster->speeds)
                                  ->set_core_count(cluster->core_amount)
@@ -411,7 +417,7 @@ static void sg_platf_new_cluster_flat(simgrid::kernel::routing::ClusterCreationA
   }
 
   for (int const& i : cluster->radicals) {
-    std::string host_id = cluster->prefix + std::to_string(i) + cluster->suffix;
+    auto host_id = simgrid::xbt::InternedString::from_pattern(cluster->prefix, i, cluster->suffix);
 
     XBT_DEBUG("<host\tid=\"%s\"\tspeed=\"%f\">", host_id.c_str(), cluster->speeds.front());
     const auto* host = zone->add_host(host_id, cluster->speeds)
@@ -533,11 +539,11 @@ static void sg_platf_build_cabinet(simgrid::kernel::routing::StarZone* zone,
                                    const simgrid::s4u::Link* backbone)
 {
   for (int const& radical : args->radicals) {
-    std::string id   = args->prefix + std::to_string(radical) + args->suffix;
+    auto id          = simgrid::xbt::InternedString::from_pattern(args->prefix, radical, args->suffix);
     auto const* host = zone->add_host(id, {args->speed})->seal();
 
-    const auto* link_up   = zone->add_link("link_" + id + "_UP", {args->bw})->set_latency(args->lat)->seal();
-    const auto* link_down = zone->add_link("link_" + id + "_DOWN", {args->bw})->set_latency(args->lat)->seal();
+    const auto* link_up   = zone->add_link("link_" + id.str() + "_UP", {args->bw})->set_latency(args->lat)->seal();
+    const auto* link_down = zone->add_link("link_" + id.str() + "_DOWN", {args->bw})->set_latency(args->lat)->seal();
 
     sg_platf_cluster_set_hostlink(zone, host->get_netpoint(), link_up, link_down, backbone);
   }
@@ -646,6 +652,116 @@ void sg_platf_new_actor(simgrid::kernel::routing::ActorCreationArgs* actor)
   }
 }
 
+/** @brief Loads a CSV deployment file, each line describing an actor as host,function,start_time,kill_time,on_failure
+ * followed by the arguments of the actor (the last fields can be omitted, or left empty to get their default).
+ *
+ * This is meant for the deployments of many actors. The file is read line by line, each distinct host and function
+ * name is looked up only once, and all the actors starting at the same later date are created by a single timer.
+ */
+void parse_csv_deployment(const std::string& file)
+{
+  auto fs = std::unique_ptr<std::ifstream>(simgrid::xbt::path_ifsopen(file));
+  xbt_assert(not fs->fail(), "Cannot open deployment file '%s' (path=%s)", file.c_str(),
+             simgrid::xbt::path_to_string().c_str());
+
+  const auto* engine = simgrid::s4u::Engine::get_instance();
+  std::map<std::string, simgrid::s4u::Host*, std::less<>> hosts;
+  std::map<std::string, simgrid::kernel::actor::ActorCodeFactory, std::less<>> factories;
+  std::map<double, std::vector<simgrid::kernel::actor::ProcessArg*>> delayed_actors; // by start date
+  const std::unordered_map<std::string, std::string> no_properties;
+
+  std::string line;
+  std::vector<std::string_view> fields;
+  for (int lineno = 1; std::getline(*fs, line); lineno++) {
+    if (not line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty() || line.front() == '#')
+      continue;
+    fields.clear();
+    for (size_t begin = 0, end; begin <= line.size(); begin = end + 1) {
+      end = std::min(line.find(',', begin), line.size());
+      fields.emplace_back(line.data() + begin, end - begin);
+    }
+    xbt_assert(fields.size() >= 2, "%s:%d: an actor needs at least a host and a function", file.c_str(), lineno);
+    auto get_double = [&fields, &file, lineno](size_t i) {
+      if (i >= fields.size() || fields[i].empty())
+        return -1.0;
+      std::string field(fields[i]);
+      size_t len = 0;
+      double res = 0;
+      try {
+        res = std::stod(field, &len);
+      } catch (const std::logic_error&) {
+        len = 0;
+      }
+      xbt_assert(len == field.size(), "%s:%d: invalid number '%s'", file.c_str(), lineno, field.c_str());
+      return res;
+    };
+
+    auto host_it = hosts.find(fields[0]);
+    if (host_it == hosts.end()) {
+      std::string name(fields[0]);
+      auto* host = engine->host_by_name_or_null(name);
+      xbt_assert(host, "%s:%d: Cannot create an actor on host '%s', that does not exist", file.c_str(), lineno,
+                 name.c_str());
+      host_it = hosts.try_emplace(std::move(name), host).first;
+    }
+    auto factory_it = factories.find(fields[1]);
+    if (factory_it == factories.end()) {
+      std::string name(fields[1]);
+      auto factory = engine->get_impl()->get_function(name);
+      xbt_assert(factory, "%s:%d: Function '%s' not registered", file.c_str(), lineno, name.c_str());
+      factory_it = factories.try_emplace(std::move(name), std::move(factory)).first;
+    }
+    double start_time = get_double(2);
+    double kill_time  = get_double(3);
+    std::string_view on_failure = fields.size() > 4 ? fields[4] : std::string_view();
+    xbt_assert(on_failure.empty() || on_failure == "DIE" || on_failure == "RESTART",
+               "%s:%d: Invalid on failure behavior (expecting DIE or RESTART)", file.c_str(), lineno);
+    bool auto_restart = on_failure == "RESTART";
+
+    std::vector<std::string> args;
+    args.reserve(fields.size() > 5 ? fields.size() - 4 : 1);
+    args.emplace_back(factory_it->first);
+    for (size_t i = 5; i < fields.size(); i++)
+      args.emplace_back(fields[i]);
+
+    simgrid::s4u::Host* host               = host_it->second;
+    simgrid::kernel::actor::ActorCode code = factory_it->second(std::move(args));
+    auto* arg = new simgrid::kernel::actor::ProcessArg(factory_it->first, code, nullptr, host, kill_time, no_properties,
+                                                       auto_restart, /*daemon=*/false, /*restart_count=*/0);
+    host->get_impl()->add_actor_at_boot(arg);
+
+    if (start_time > simgrid::s4u::Engine::get_clock()) {
+      delayed_actors[start_time].push_back(new simgrid::kernel::actor::ProcessArg(
+          factory_it->first, code, nullptr, host, kill_time, no_properties, auto_restart, /*daemon=*/false,
+          /*restart_count=*/0));
+      continue;
+    }
+    XBT_DEBUG("Starting actor %s(%s) right now", arg->name.c_str(), host->get_cname());
+    try {
+      simgrid::kernel::actor::ActorImpl::create(arg);
+    } catch (simgrid::HostFailureException const&) {
+      XBT_WARN("Starting actor %s(%s) failed because its host is turned off.", arg->name.c_str(), host->get_cname());
+    }
+  }
+
+  for (auto& [date, args] : delayed_actors) {
+    XBT_DEBUG("%zu actors will be started at time %f", args.size(), date);
+    simgrid::kernel::timer::Timer::set(date, [args = std::move(args)]() {
+      for (auto* arg : args) {
+        try {
+          simgrid::kernel::actor::ActorImpl::create(arg);
+        } catch (simgrid::HostFailureException const&) {
+          XBT_WARN("Starting actor %s(%s) failed because its host is turned off.", arg->name.c_str(),
+                   arg->host->get_cname());
+        }
+        delete arg;
+      }
+    });
+  }
+}
+
 /**
  * @brief Auxiliary function to build the object NetZoneImpl
  *
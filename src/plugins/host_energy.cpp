@@ -10,16 +10,24 @@
 #include <simgrid/s4u/Host.hpp>
 #include <simgrid/s4u/VirtualMachine.hpp>
 #include <simgrid/simcall.hpp>
+#include <xbt/config.hpp>
 
 #include "src/kernel/activity/ActivityImpl.hpp"
 #include "src/kernel/resource/CpuImpl.hpp"
+#include "src/kernel/resource/models/ptask_L07.hpp"
 #include "src/simgrid/module.hpp"
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <vector>
 
 SIMGRID_REGISTER_PLUGIN(host_energy, "Cpu energy consumption.", &sg_host_energy_plugin_init)
 
+/* Also used by the link energy plugin */
+static simgrid::config::Flag<bool> cfg_lazy_energy{
+    "plugin/energy/lazy",
+    "Only compute the power of hosts and links once after each of their changes, and integrate it on demand", false};
+
 /** @defgroup plugin_host_energy plugin_host_energy Plugin Host Energy
 
   @beginrst
@@ -160,7 +168,19 @@ class HostEnergy {
    */
   bool host_was_used_ = false;
 
+  /* With plugin/energy/lazy, the callbacks only integrate power_ up to now. The power is recomputed after the next
+   * solve, when the load that follows the change is known, and then reused until the next change of the host */
+  bool lazy_    = cfg_lazy_energy;
+  bool stale_   = false; /*< Whether power_ is to be recomputed from the load of the next solve */
+  double power_ = 0.0;   /*< Power consumed since last_updated_ (lazy mode) */
+  double settled_date_ = last_updated_; /*< The load is known after this date (later than the change for the parallel
+                                           tasks that are still paying their latency, as they do not load the CPU yet) */
+  static std::vector<HostEnergy*> stale_hosts_;
+
   void init_watts_range_list();
+  void mark_stale();
+  void refresh();
+  bool is_settled(double now) const { return settled_date_ + sg_precision_timing < now; }
   friend void ::on_simulation_end(); // For access to host_was_used_
 
 public:
@@ -180,9 +200,12 @@ public:
   double get_power_range_slope_at(int pstate) const;
   double get_last_update_time() const { return last_updated_; }
   void update();
+  void delay_refresh(double date) { settled_date_ = std::max(settled_date_, date); }
+  static void refresh_stale_hosts();
 };
 
 simgrid::xbt::Extension<simgrid::s4u::Host, HostEnergy> HostEnergy::EXTENSION_ID;
+std::vector<HostEnergy*> HostEnergy::stale_hosts_;
 
 /* Returns whether power consumption values were provided for all pstates. */
 bool HostEnergy::has_pstate_power_values() const {
@@ -192,6 +215,21 @@ bool HostEnergy::has_pstate_power_values() const {
 /* Computes the consumption so far. Called lazily on need. */
 void HostEnergy::update()
 {
+  if (lazy_) {
+    /* O(1) unless the power is still unknown since an earlier date: the current load is the one of that period */
+    double now = simgrid::s4u::Engine::get_clock();
+    if (last_updated_ < now) {
+      if (stale_)
+        power_ = get_current_watts_value();
+      total_energy_ += power_ * (now - last_updated_);
+      last_updated_ = now;
+    }
+    delay_refresh(now);
+    pstate_ = host_->is_on() ? host_->get_pstate() : pstate_off_;
+    mark_stale();
+    return;
+  }
+
   double start_time  = last_updated_;
   double finish_time = simgrid::s4u::Engine::get_clock();
   //
@@ -222,9 +260,36 @@ void HostEnergy::update()
   pstate_ = host_->is_on() ? host_->get_pstate() : pstate_off_;
 }
 
+void HostEnergy::mark_stale()
+{
+  if (not stale_) {
+    stale_ = true;
+    stale_hosts_.push_back(this);
+  }
+}
+
+void HostEnergy::refresh()
+{
+  power_ = get_current_watts_value();
+  stale_ = false;
+}
+
+/* Called at the end of each solve: the load of the hosts that changed before this period is now known */
+void HostEnergy::refresh_stale_hosts()
+{
+  double now = simgrid::s4u::Engine::get_clock();
+  std::erase_if(stale_hosts_, [now](HostEnergy* host_energy) {
+    if (host_energy->stale_ && host_energy->is_settled(now))
+      host_energy->refresh();
+    return not host_energy->stale_;
+  });
+}
+
 HostEnergy::HostEnergy(simgrid::s4u::Host* ptr) : host_(ptr)
 {
   init_watts_range_list();
+  if (lazy_)
+    mark_stale();
 
   const char* off_power_str = host_->get_property("wattage_off");
   if (off_power_str != nullptr) {
@@ -238,7 +303,11 @@ HostEnergy::HostEnergy(simgrid::s4u::Host* ptr) : host_(ptr)
   /* watts_off is 0 by default */
 }
 
-HostEnergy::~HostEnergy() = default;
+HostEnergy::~HostEnergy()
+{
+  if (lazy_)
+    std::erase(stale_hosts_, this);
+}
 
 double HostEnergy::get_watt_idle_at(int pstate) const
 {
@@ -344,6 +413,13 @@ double HostEnergy::get_current_watts_value(double cpu_load) const
 
 double HostEnergy::get_consumed_energy()
 {
+  if (lazy_) {
+    double now = simgrid::s4u::Engine::get_clock();
+    if (stale_ && is_settled(now))
+      simgrid::kernel::actor::simcall_answered(std::bind(&HostEnergy::refresh, this));
+    return total_energy_ + power_ * (now - last_updated_);
+  }
+
   if (last_updated_ < simgrid::s4u::Engine::get_clock()) // We need to simcall this as it modifies the environment
     simgrid::kernel::actor::simcall_answered(std::bind(&HostEnergy::update, this));
 
@@ -431,7 +507,8 @@ static void on_action_state_change(simgrid::kernel::resource::CpuAction const& a
       // Get the host_energy extension for the relevant host
       auto* host_energy = host->extension<HostEnergy>();
 
-      if (host_energy->get_last_update_time() < simgrid::s4u::Engine::get_clock())
+      // In lazy mode, the power must be recomputed even if the consumption was already integrated up to now
+      if (cfg_lazy_energy || host_energy->get_last_update_time() < simgrid::s4u::Engine::get_clock())
         host_energy->update();
     }
   }
@@ -502,6 +579,7 @@ void sg_host_energy_plugin_init()
   simgrid::s4u::Exec::on_suspend_cb(on_activity_suspend_resume);
   simgrid::s4u::Exec::on_resume_cb(on_activity_suspend_resume);
   simgrid::s4u::Engine::on_simulation_end_cb(&on_simulation_end);
+  simgrid::s4u::Engine::on_time_advance_cb([](double) { HostEnergy::refresh_stale_hosts(); });
   // We may only have one actor on a node. If that actor executes something like
   //   compute -> recv -> compute
   // the recv operation will not trigger a "Host::on_exec_state_change_cb". This means
@@ -509,7 +587,17 @@ void sg_host_energy_plugin_init()
   // during the recv call. By updating at the beginning of a compute, we can
   // fix that. (If the cpu is not idle, this is not required.)
   simgrid::s4u::Exec::on_start_cb([](simgrid::s4u::Exec const& activity) {
-    if (activity.get_host_number() == 1) { // We only run on one host
+    if (cfg_lazy_energy) { // The power of all the hosts of parallel tasks must be recomputed once they load the CPUs
+      double settled_date = simgrid::s4u::Engine::get_clock();
+      if (const auto* ptask = dynamic_cast<simgrid::kernel::resource::L07Action*>(activity.get_impl()->model_action_))
+        settled_date += ptask->get_latency();
+      for (simgrid::s4u::Host* host : activity.get_impl()->get_hosts()) {
+        if (const auto* vm = dynamic_cast<simgrid::s4u::VirtualMachine*>(host))
+          host = vm->get_pm();
+        host->extension<HostEnergy>()->update();
+        host->extension<HostEnergy>()->delay_refresh(settled_date);
+      }
+    } else if (activity.get_host_number() == 1) { // We only run on one host
       simgrid::s4u::Host* host = activity.get_host();
       if (const auto* vm = dynamic_cast<simgrid::s4u::VirtualMachine*>(host))
         host = vm->get_pm();
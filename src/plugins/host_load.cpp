@@ -5,11 +5,10 @@
 
 #include <simgrid/plugins/load.h>
 #include <simgrid/s4u/Engine.hpp>
-#include <simgrid/s4u/Exec.hpp>
 #include <simgrid/s4u/Host.hpp>
 #include <simgrid/s4u/VirtualMachine.hpp>
 
-#include "src/kernel/activity/ExecImpl.hpp"
+#include "src/kernel/resource/CpuImpl.hpp"
 #include "src/simgrid/module.hpp" // SIMGRID_REGISTER_PLUGIN
 
 // Makes sure that this plugin can be activated from the command line with ``--cfg=plugin:host_load``
@@ -22,11 +21,12 @@ In addition, this constitutes a good introductory example on how to write a plug
 It attaches an extension to each host to store some data, and places callbacks in the following signals:
 
   - :cpp:func:`simgrid::s4u::Host::on_creation_cb`: Attach a new extension to the newly created host.
-  - :cpp:func:`simgrid::s4u::Exec::on_start_cb`: Make note that a new execution started, increasing the load.
-  - :cpp:func:`simgrid::s4u::Exec::on_completion_cb`: Make note that an execution completed, decreasing the load.
   - :cpp:func:`simgrid::s4u::Host::on_onoff_cb`: Do what is appropriate when the host gets turned off or on.
   - :cpp:func:`simgrid::s4u::Host::on_speed_change_cb`: Do what is appropriate when the DVFS is modified.
 
+  The computed flops and the idle time are not accounted by the plugin: they are read from the usage integrals that
+  the CPU maintains anyway, so the plugin does not need to follow the executions.
+
   Note that extensions are automatically destroyed when the host gets destroyed.
   @endrst
 */
@@ -35,8 +35,6 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(host_load, plugin, "Logging specific to the Host
 
 namespace simgrid::plugin {
 
-static const double activity_uninitialized_remaining_cost = -1;
-
 /** This class stores the extra data needed by this plugin about a given host
  *
  * It is stored as an extension of s4u::Host. Such extensions are retrieved by type as follows:
@@ -61,7 +59,10 @@ public:
       , last_updated_(simgrid_get_clock())
       , last_reset_(simgrid_get_clock())
       , current_speed_(host_->get_speed())
-      , current_flops_(host_->get_load())
+      , flops_at_reset_(host_->get_cpu()->get_usage_integral())
+      , busy_at_reset_(host_->get_cpu()->get_busy_time())
+      , busy_at_creation_(busy_at_reset_)
+      , creation_date_(last_reset_)
   {
   }
   HostLoad() = delete;
@@ -73,21 +74,28 @@ public:
    *
    * That's the ratio (amount of flops that were actually computed) / (amount of flops that could have been computed at full speed)
    */
-  double get_average_load() { update(); return (theor_max_flops_ == 0) ? 0 : computed_flops_ / theor_max_flops_; };
+  double get_average_load()
+  {
+    update();
+    return (theor_max_flops_ == 0) ? 0 : get_computed_flops() / theor_max_flops_;
+  }
   /** Amount of flops computed since last reset() */
-  double get_computed_flops() { update(); return computed_flops_; }
+  double get_computed_flops() const { return host_->get_cpu()->get_usage_integral() - flops_at_reset_; }
   /** Return idle time since last reset() */
-  double get_idle_time() { update(); return idle_time_; }
+  double get_idle_time() const
+  {
+    return simgrid_get_clock() - last_reset_ - (host_->get_cpu()->get_busy_time() - busy_at_reset_);
+  }
   /** Return idle time over the whole simulation */
-  double get_total_idle_time() { update(); return total_idle_time_; }
+  double get_total_idle_time() const
+  {
+    return simgrid_get_clock() - creation_date_ - (host_->get_cpu()->get_busy_time() - busy_at_creation_);
+  }
   void update();
-  void add_activity(simgrid::kernel::activity::ExecImpl* activity);
   void reset();
 
 private:
   simgrid::s4u::Host* host_ = nullptr;
-  /* Stores all currently ongoing activities (computations) on this machine */
-  std::map<simgrid::kernel::activity::ExecImpl*, /* cost still remaining*/ double> current_activities;
   double last_updated_      = 0;
   double last_reset_        = 0;
   /**
@@ -95,62 +103,21 @@ private:
    * will already have changed once we get notified
    */
   double current_speed_     = 0;
-  /**
-   * How many flops are currently used by all the processes running on this
-   * host?
-   */
-  double current_flops_     = 0;
-  double computed_flops_    = 0;
-  double idle_time_         = 0;
-  double total_idle_time_   = 0; /* This updated but never gets reset */
   double theor_max_flops_   = 0;
+  /* Usage integrals of the CPU at the last reset() and at the creation of this extension */
+  double flops_at_reset_    = 0;
+  double busy_at_reset_     = 0;
+  double busy_at_creation_  = 0;
+  double creation_date_     = 0;
 };
 
 // Create the static field that the extension mechanism needs
 simgrid::xbt::Extension<simgrid::s4u::Host, HostLoad> HostLoad::EXTENSION_ID;
 
-void HostLoad::add_activity(simgrid::kernel::activity::ExecImpl* activity)
-{
-  current_activities.insert({activity, activity_uninitialized_remaining_cost});
-}
-
 void HostLoad::update()
 {
   double now = simgrid_get_clock();
 
-  // This loop updates the flops that the host executed for the ongoing computations
-  auto iter = begin(current_activities);
-  while (iter != end(current_activities)) {
-    const auto& activity                   = iter->first;  // Just an alias
-    auto& remaining_cost_after_last_update = iter->second; // Just an alias
-    auto& action                           = activity->model_action_;
-    auto current_iter                      = iter;
-    ++iter;
-
-    if (action != nullptr && action->get_finish_time() != now &&
-        activity->get_state() == kernel::activity::State::RUNNING) {
-      if (remaining_cost_after_last_update == activity_uninitialized_remaining_cost) {
-        remaining_cost_after_last_update = action->get_cost();
-      }
-      double computed_flops_since_last_update = remaining_cost_after_last_update - /*remaining now*/activity->get_remaining();
-      computed_flops_                        += computed_flops_since_last_update;
-      remaining_cost_after_last_update        = activity->get_remaining();
-    } else if (activity->get_state() == kernel::activity::State::DONE) {
-      computed_flops_ += remaining_cost_after_last_update;
-      current_activities.erase(current_iter);
-    }
-  }
-
-  /* Current flop per second computed by the cpu; current_flops = k * pstate_speed_in_flops, k @in {0, 1, ..., cores-1}
-   * designates number of active cores; will be 0 if CPU is currently idle */
-  current_flops_ = host_->get_load();
-
-  if (current_flops_ == 0) {
-    idle_time_ += (now - last_updated_);
-    total_idle_time_ += (now - last_updated_);
-    XBT_DEBUG("[%s]: Currently idle -> Added %f seconds to idle time (totaling %fs)", host_->get_cname(), (now - last_updated_), idle_time_);
-  }
-
   theor_max_flops_ += current_speed_ * host_->get_core_count() * (now - last_updated_);
   current_speed_ = host_->get_speed();
   last_updated_  = now;
@@ -171,8 +138,7 @@ void HostLoad::update()
  */
 double HostLoad::get_current_load() const
 {
-  // We don't need to call update() here because it is called every time an action terminates or starts
-  return current_flops_ / (host_->get_speed() * host_->get_core_count());
+  return host_->get_load() / (host_->get_speed() * host_->get_core_count());
 }
 
 /*
@@ -182,10 +148,9 @@ void HostLoad::reset()
 {
   last_updated_    = simgrid_get_clock();
   last_reset_      = simgrid_get_clock();
-  idle_time_       = 0;
-  computed_flops_  = 0;
   theor_max_flops_ = 0;
-  current_flops_   = host_->get_load();
+  flops_at_reset_  = host_->get_cpu()->get_usage_integral();
+  busy_at_reset_   = host_->get_cpu()->get_busy_time();
   current_speed_   = host_->get_speed();
 }
 } // namespace simgrid::plugin
@@ -231,32 +196,6 @@ void sg_host_load_plugin_init()
     host.extension_set(new HostLoad(&host));
   });
 
-  simgrid::s4u::Exec::on_start_cb([](simgrid::s4u::Exec const& activity) {
-    if (activity.get_host_number() == 1) { // We only run on one host
-      simgrid::s4u::Host* host         = activity.get_host();
-      if (const auto* vm = dynamic_cast<simgrid::s4u::VirtualMachine*>(host))
-        host = vm->get_pm();
-      xbt_assert(host != nullptr);
-      host->extension<HostLoad>()->add_activity(static_cast<simgrid::kernel::activity::ExecImpl*>(activity.get_impl()));
-      host->extension<HostLoad>()->update(); // If the system was idle until now, we need to update *before*
-                                             // this computation starts running so we can keep track of the
-                                             // idle time. (Communication operations don't trigger this hook!)
-    }
-    else { // This runs on multiple hosts
-      XBT_WARN("HostLoad plugin currently does not support executions on several hosts");
-    }
-  });
-  simgrid::s4u::Exec::on_completion_cb([](simgrid::s4u::Exec const& exec) {
-    if (exec.get_host_number() == 1) { // We only run on one host
-      simgrid::s4u::Host* host = exec.get_host();
-      if (const auto* vm = dynamic_cast<simgrid::s4u::VirtualMachine*>(host))
-        host = vm->get_pm();
-      xbt_assert(host != nullptr);
-      host->extension<HostLoad>()->update();
-    } else { // This runs on multiple hosts
-      XBT_WARN("HostLoad plugin currently does not support executions on several hosts");
-    }
-  });
   simgrid::s4u::Host::on_onoff_cb(&on_host_change);
   simgrid::s4u::Host::on_speed_change_cb(&on_host_change);
 }
@@ -11,9 +11,11 @@
 #include "simgrid/s4u/Link.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 #include "src/simgrid/module.hpp"
+#include "xbt/config.hpp"
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <vector>
 
 SIMGRID_REGISTER_PLUGIN(link_energy, "Link energy consumption.", &sg_link_energy_plugin_init)
 
@@ -54,22 +56,83 @@ class LinkEnergy {
   double total_energy_{0.0};
   double last_updated_{0.0}; /*< Timestamp of the last energy update event*/
 
+  /* Lazy mode (plugin/energy/lazy), as in the host energy plugin: power_ is consumed since last_updated_, and it is
+   * only recomputed after the solve that follows a change of the link */
+  bool lazy_{config::get_value<bool>("plugin/energy/lazy")};
+  bool stale_{false};
+  double power_{0.0};
+  static std::vector<LinkEnergy*> stale_links_;
+
   double get_power() const;
+  void mark_stale();
+  void refresh();
 
 public:
   static xbt::Extension<simgrid::s4u::Link, LinkEnergy> EXTENSION_ID;
 
-  explicit LinkEnergy(s4u::Link* ptr) : link_(ptr), last_updated_(simgrid::s4u::Engine::get_clock()) {}
+  explicit LinkEnergy(s4u::Link* ptr) : link_(ptr), last_updated_(simgrid::s4u::Engine::get_clock())
+  {
+    if (lazy_)
+      mark_stale();
+  }
+  LinkEnergy(const LinkEnergy&)            = delete;
+  LinkEnergy& operator=(const LinkEnergy&) = delete;
+  ~LinkEnergy()
+  {
+    if (lazy_)
+      std::erase(stale_links_, this);
+  }
 
   void init_watts_range_list();
   double get_consumed_energy();
   void update();
+  static void refresh_stale_links();
 };
 
 xbt::Extension<s4u::Link, LinkEnergy> LinkEnergy::EXTENSION_ID;
+std::vector<LinkEnergy*> LinkEnergy::stale_links_;
+
+void LinkEnergy::mark_stale()
+{
+  if (not stale_) {
+    stale_ = true;
+    stale_links_.push_back(this);
+  }
+}
+
+void LinkEnergy::refresh()
+{
+  if (not inited_)
+    init_watts_range_list();
+  power_ = get_power();
+  stale_ = false;
+}
+
+/* Called at the end of each solve: the load of the links that changed before this period is now known */
+void LinkEnergy::refresh_stale_links()
+{
+  double now = simgrid::s4u::Engine::get_clock();
+  std::erase_if(stale_links_, [now](LinkEnergy* link_energy) {
+    if (link_energy->stale_ && link_energy->last_updated_ < now)
+      link_energy->refresh();
+    return not link_energy->stale_;
+  });
+}
 
 void LinkEnergy::update()
 {
+  if (lazy_) {
+    double now = simgrid::s4u::Engine::get_clock();
+    if (last_updated_ < now) {
+      if (stale_)
+        refresh();
+      total_energy_ += power_ * (now - last_updated_);
+      last_updated_ = now;
+    }
+    mark_stale();
+    return;
+  }
+
   if (not inited_)
     init_watts_range_list();
 
@@ -137,6 +200,12 @@ double LinkEnergy::get_power() const
 
 double LinkEnergy::get_consumed_energy()
 {
+  if (lazy_) {
+    double now = simgrid::s4u::Engine::get_clock();
+    if (stale_ && last_updated_ < now)
+      kernel::actor::simcall_answered(std::bind(&LinkEnergy::refresh, this));
+    return total_energy_ + power_ * (now - last_updated_);
+  }
   if (last_updated_ < simgrid::s4u::Engine::get_clock()) // We need to simcall this as it modifies the environment
     kernel::actor::simcall_answered(std::bind(&LinkEnergy::update, this));
   return this->total_energy_;
@@ -216,6 +285,7 @@ void sg_link_energy_plugin_init()
   simgrid::s4u::Comm::on_completion_cb(&on_communication);
 
   simgrid::s4u::Engine::on_simulation_end_cb(&on_simulation_end);
+  simgrid::s4u::Engine::on_time_advance_cb([](double) { LinkEnergy::refresh_stale_links(); });
 }
 
 /** @ingroup plugin_link_energy
@@ -42,11 +42,10 @@ class LinkLoad {
   s4u::Link* link_{};      /*< The link onto which this data is attached*/
   bool is_tracked_{false}; /*<Whether the link is tracked or not*/
 
-  double cumulated_bytes_{};      /*< Cumulated load since last reset*/
+  double bytes_at_reset_{};       /*< Usage integral of the link at the last reset*/
   double min_bytes_per_second_{}; /*< Minimum instantaneous load observed since last reset*/
   double max_bytes_per_second_{}; /*< Maximum instantaneous load observed since last reset*/
   double last_reset_{};           /*< Timestamp of the last reset (init timestamp by default)*/
-  double last_updated_{};         /*< Timestamp of the last energy update event*/
 
 public:
   static xbt::Extension<s4u::Link, LinkLoad> EXTENSION_ID;
@@ -95,13 +94,12 @@ void LinkLoad::reset()
 {
   XBT_DEBUG("Resetting load of link '%s'", link_->get_cname());
 
-  cumulated_bytes_      = 0.0;
+  bytes_at_reset_       = link_->get_impl()->get_usage_integral();
   min_bytes_per_second_ = std::numeric_limits<double>::max();
   max_bytes_per_second_ = std::numeric_limits<double>::lowest();
   XBT_DEBUG("min_bytes_per_second_ = %g", min_bytes_per_second_);
   XBT_DEBUG("max_bytes_per_second_ = %g", max_bytes_per_second_);
-  last_reset_   = simgrid::s4u::Engine::get_clock();
-  last_updated_ = last_reset_;
+  last_reset_ = simgrid::s4u::Engine::get_clock();
 }
 
 void LinkLoad::update()
@@ -112,28 +110,16 @@ void LinkLoad::update()
              " Please track your link with sg_link_load_track before trying to access any of its load metrics.",
              link_->get_cname());
 
+  // The cumulated load is integrated by the link itself. Only the extrema of the instantaneous load are tracked here.
   double current_instantaneous_bytes_per_second = link_->get_load();
-  double now                                    = simgrid::s4u::Engine::get_clock();
-
-  // Update minimum/maximum observed values if needed
   min_bytes_per_second_ = std::min(min_bytes_per_second_, current_instantaneous_bytes_per_second);
   max_bytes_per_second_ = std::max(max_bytes_per_second_, current_instantaneous_bytes_per_second);
-
-  // Update cumulated load
-  double duration_since_last_update = now - last_updated_;
-  double bytes_since_last_update    = duration_since_last_update * current_instantaneous_bytes_per_second;
-  XBT_DEBUG("Cumulated %g bytes since last update (duration of %g seconds)", bytes_since_last_update,
-            duration_since_last_update);
-  xbt_assert(bytes_since_last_update >= 0, "LinkLoad plugin inconsistency: negative amount of bytes is accumulated.");
-
-  cumulated_bytes_ += bytes_since_last_update;
-  last_updated_ = now;
 }
 
 double LinkLoad::get_cumulated_bytes()
 {
   update();
-  return cumulated_bytes_;
+  return link_->get_impl()->get_usage_integral() - bytes_at_reset_;
 }
 double LinkLoad::get_min_bytes_per_second()
 {
@@ -148,11 +134,9 @@ double LinkLoad::get_max_bytes_per_second()
 
 double LinkLoad::get_average_bytes()
 {
-  update();
-
   double now = simgrid::s4u::Engine::get_clock();
   if (now > last_reset_)
-    return cumulated_bytes_ / (now - last_reset_);
+    return get_cumulated_bytes() / (now - last_reset_);
   else
     return 0;
 }
@@ -20,6 +20,7 @@
 #include "src/kernel/resource/NetworkModel.hpp"
 #include "src/kernel/resource/SplitDuplexLinkImpl.hpp"
 #include "src/kernel/resource/StandardLinkImpl.hpp"
+#include "src/kernel/routing/PlatformSnapshot.hpp"
 #include "src/mc/mc.h"
 #include "src/mc/mc_replay.hpp"
 #include "src/simgrid/module.hpp"
@@ -276,6 +277,12 @@ void Engine::seal_platform() const
   pimpl_->seal_platform();
 }
 
+void Engine::save_platform_snapshot(const std::string& path) const
+{
+  seal_platform();
+  kernel::routing::PlatformSnapshot::save(pimpl_->netzone_root_, path);
+}
+
 static void flatify_hosts(Engine const& engine, std::stringstream& ss)
 {
   // Regular hosts
@@ -426,8 +433,8 @@ void Engine::register_function(const std::string& name, const std::function<void
 /** Registers the main function of an actor that will be launched from the deployment file */
 void Engine::register_function(const std::string& name, const std::function<void(std::vector<std::string>)>& code)
 {
-  kernel::actor::ActorCodeFactory code_factory = [code{code}](std::vector<std::string> args) mutable {
-    return std::bind(std::move(code), std::move(args));
+  kernel::actor::ActorCodeFactory code_factory = [code](std::vector<std::string> args) {
+    return std::bind(code, std::move(args));
   };
   register_function(name, code_factory);
 }
@@ -575,10 +582,11 @@ Link* Engine::link_by_name_or_null(const std::string& name) const
 Mailbox* Engine::mailbox_by_name_or_create(const std::string& name) const
 {
   /* two actors may have pushed the same mbox_create simcall at the same time */
-  kernel::activity::MailboxImpl* mbox = kernel::actor::simcall_answered([&name, this] {
-    auto [m, inserted] = pimpl_->mailboxes_.try_emplace(name, nullptr);
+  xbt::InternedString interned_name(name); // Hash the name in the actor, even with parallel contexts
+  kernel::activity::MailboxImpl* mbox = kernel::actor::simcall_answered([&interned_name, &name, this] {
+    auto [m, inserted] = pimpl_->mailboxes_.try_emplace(interned_name, nullptr);
     if (inserted) {
-      m->second = new kernel::activity::MailboxImpl(name);
+      m->second = new kernel::activity::MailboxImpl(interned_name);
       XBT_DEBUG("Creating a mailbox at %p with name %s", m->second, name.c_str());
     }
     return m->second;
@@ -589,10 +597,11 @@ Mailbox* Engine::mailbox_by_name_or_create(const std::string& name) const
 MessageQueue* Engine::message_queue_by_name_or_create(const std::string& name) const
 {
   /* two actors may have pushed the same mbox_create simcall at the same time */
-  kernel::activity::MessageQueueImpl* queue = kernel::actor::simcall_answered([&name, this] {
-    auto [m, inserted] = pimpl_->mqueues_.try_emplace(name, nullptr);
+  xbt::InternedString interned_name(name); // Hash the name in the actor, even with parallel contexts
+  kernel::activity::MessageQueueImpl* queue = kernel::actor::simcall_answered([&interned_name, &name, this] {
+    auto [m, inserted] = pimpl_->mqueues_.try_emplace(interned_name, nullptr);
     if (inserted) {
-      m->second = new kernel::activity::MessageQueueImpl(name);
+      m->second = new kernel::activity::MessageQueueImpl(interned_name);
       XBT_DEBUG("Creating a message queue at %p with name %s", m->second, name.c_str());
     }
     return m->second;
@@ -631,6 +640,41 @@ std::vector<Link*> Engine::get_filtered_links(const std::function<bool(Link*)>&
   return res;
 }
 
+std::vector<std::pair<std::vector<Link*>, double>>
+Engine::get_routes(const std::vector<std::pair<const Host*, const Host*>>& pairs) const
+{
+  std::vector<std::pair<const kernel::routing::NetPoint*, const kernel::routing::NetPoint*>> netpoints;
+  netpoints.reserve(pairs.size());
+  for (auto const& [src, dst] : pairs)
+    netpoints.emplace_back(src->get_netpoint(), dst->get_netpoint());
+
+  std::vector<std::vector<kernel::resource::StandardLinkImpl*>> links;
+  std::vector<double> latencies;
+  kernel::routing::NetZoneImpl::get_global_routes(netpoints, &links, &latencies);
+
+  std::vector<std::pair<std::vector<Link*>, double>> res(pairs.size());
+  for (size_t i = 0; i < pairs.size(); i++) {
+    res[i].first.reserve(links[i].size());
+    for (auto* link : links[i])
+      res[i].first.push_back(link->get_iface());
+    res[i].second = latencies[i];
+  }
+  return res;
+}
+
+std::vector<double> Engine::get_latency_matrix(const std::vector<Host*>& hosts) const
+{
+  std::vector<std::pair<const kernel::routing::NetPoint*, const kernel::routing::NetPoint*>> netpoints;
+  netpoints.reserve(hosts.size() * hosts.size());
+  for (auto const* src : hosts)
+    for (auto const* dst : hosts)
+      netpoints.emplace_back(src->get_netpoint(), dst->get_netpoint());
+
+  std::vector<double> latencies;
+  kernel::routing::NetZoneImpl::get_global_routes(netpoints, nullptr, &latencies);
+  return latencies;
+}
+
 size_t Engine::get_actor_count() const
 {
   return pimpl_->get_actor_count();
@@ -759,7 +803,10 @@ NetZone* Engine::netzone_by_name_or_null(const std::string& name) const
 /** @brief Retrieve the netpoint of the given name (or nullptr if not found) */
 kernel::routing::NetPoint* Engine::netpoint_by_name_or_null(const std::string& name) const
 {
-  auto netp = pimpl_->netpoints_.find(name);
+  auto interned_name = xbt::InternedString::find(name);
+  if (not interned_name) // No entity was ever named that way
+    return nullptr;
+  auto netp = pimpl_->netpoints_.find(*interned_name);
   return netp == pimpl_->netpoints_.end() ? nullptr : netp->second;
 }
 
@@ -783,14 +830,15 @@ std::vector<kernel::routing::NetPoint*> Engine::get_all_netpoints() const
 /** @brief Register a new netpoint to the system */
 void Engine::netpoint_register(kernel::routing::NetPoint* point)
 {
-  simgrid::kernel::actor::simcall_answered([this, point] { pimpl_->netpoints_[point->get_name()] = point; });
+  simgrid::kernel::actor::simcall_answered([this, point] { pimpl_->netpoints_[point->get_interned_name()] = point; });
 }
 
 /** @brief Unregister a given netpoint */
 void Engine::netpoint_unregister(kernel::routing::NetPoint* point)
 {
   kernel::actor::simcall_answered([this, point] {
-    pimpl_->netpoints_.erase(point->get_name());
+    pimpl_->netpoints_.erase(point->get_interned_name());
+    pimpl_->on_platform_change();
     delete point;
   });
 }
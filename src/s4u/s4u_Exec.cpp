@@ -9,11 +9,15 @@
 #include <simgrid/s4u/ActivitySet.hpp>
 #include <simgrid/s4u/Exec.hpp>
 #include <simgrid/s4u/Host.hpp>
+#include <xbt/asserts.hpp>
 
 #include "src/kernel/activity/ExecImpl.hpp"
 #include "src/kernel/actor/ActorImpl.hpp"
 #include "src/kernel/actor/SimcallObserver.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(s4u_exec, s4u_activity, "S4U asynchronous executions");
 
 namespace simgrid::s4u {
@@ -150,6 +154,18 @@ ExecPtr Exec::set_bytes_amounts(const std::vector<double>& bytes_amounts)
   return this;
 }
 
+ExecPtr Exec::set_transfers(const std::vector<Transfer>& transfers)
+{
+  xbt_assert(state_ == State::INITED || state_ == State::STARTING,
+             "Cannot change the transfers of an exec after its start");
+  xbt_enforce(std::all_of(transfers.begin(), transfers.end(),
+                          [](const Transfer& transfer) { return std::isfinite(transfer.bytes); }),
+              "transfers comprise infinite values!");
+  boost::static_pointer_cast<kernel::activity::ExecImpl>(pimpl_)->set_transfers(transfers);
+  parallel_ = true;
+  return this;
+}
+
 ExecPtr Exec::set_thread_count(int thread_count)
 {
   xbt_assert(state_ == State::INITED || state_ == State::STARTING,
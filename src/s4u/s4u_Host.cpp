@@ -185,7 +185,8 @@ size_t Host::get_actor_count() const
  */
 void Host::route_to(const Host* dest, std::vector<Link*>& links, double* latency) const
 {
-  std::vector<kernel::resource::StandardLinkImpl*> linkImpls;
+  thread_local std::vector<kernel::resource::StandardLinkImpl*> linkImpls; // reused to not allocate on each lookup
+  linkImpls.clear();
   this->route_to(dest, linkImpls, latency);
   for (auto* l : linkImpls)
     links.push_back(l->get_iface());
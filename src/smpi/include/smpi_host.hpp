@@ -15,14 +15,10 @@
 #include <xbt/Extendable.hpp>
 
 namespace simgrid::smpi {
-static auto factor_lambda(std::vector<double> const& values, double size)
-{
-  return values[0] + values[1] * size;
-}
 class Host {
-  kernel::resource::FactorSet orecv_{"smpi/or", 0.0, factor_lambda};
-  kernel::resource::FactorSet osend_{"smpi/os", 0.0, factor_lambda};
-  kernel::resource::FactorSet oisend_{"smpi/ois", 0.0, factor_lambda};
+  kernel::resource::FactorSet orecv_{"smpi/or", 0.0, &kernel::resource::FactorSet::affine};
+  kernel::resource::FactorSet osend_{"smpi/os", 0.0, &kernel::resource::FactorSet::affine};
+  kernel::resource::FactorSet oisend_{"smpi/ois", 0.0, &kernel::resource::FactorSet::affine};
   s4u::Host* host = nullptr;
   /**
    * @brief Generates warning message if user's config is conflicting (callback vs command line/xml)
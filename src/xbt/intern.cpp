@@ -0,0 +1,93 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "xbt/intern.hpp"
+#include "xbt/asserts.h"
+
+#include <array>
+#include <charconv>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace simgrid::xbt {
+
+class InternedString::Pool {
+  std::shared_mutex mutex_;
+  std::deque<Entry> entries_; // never moves the entries, so the keys of the index remain valid
+  std::unordered_map<std::string_view, const Entry*> index_;
+
+public:
+  const Entry* const empty_;
+
+  Pool() : empty_(insert("")) {}
+
+  const Entry* find(std::string_view str)
+  {
+    std::shared_lock lock(mutex_);
+    auto it = index_.find(str);
+    return it == index_.end() ? nullptr : it->second;
+  }
+
+  const Entry* insert(std::string_view str)
+  {
+    if (const Entry* entry = find(str))
+      return entry;
+    std::unique_lock lock(mutex_);
+    // Another thread may have interned the same string in between
+    if (auto it = index_.find(str); it != index_.end())
+      return it->second;
+    xbt_assert(entries_.size() < std::numeric_limits<uint32_t>::max(), "Too many interned strings");
+    const Entry* entry = &entries_.emplace_back(Entry{std::string(str), static_cast<uint32_t>(entries_.size())});
+    index_.try_emplace(entry->str, entry);
+    return entry;
+  }
+
+  size_t size()
+  {
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+  }
+};
+
+InternedString::Pool& InternedString::get_pool()
+{
+  // Never freed: the names of the entities that are destroyed at exit must remain valid
+  static auto* pool = new Pool();
+  return *pool;
+}
+
+InternedString::InternedString() : entry_(get_pool().empty_) {}
+
+InternedString::InternedString(std::string_view str) : entry_(get_pool().insert(str)) {}
+
+std::optional<InternedString> InternedString::find(std::string_view str)
+{
+  if (const Entry* entry = get_pool().find(str))
+    return InternedString(entry);
+  return std::nullopt;
+}
+
+InternedString InternedString::from_pattern(std::string_view prefix, long number, std::string_view suffix)
+{
+  std::array<char, 256> buffer;
+  const size_t digits = std::numeric_limits<long>::digits10 + 2; // and the sign
+  if (prefix.size() + digits + suffix.size() > buffer.size()) // Too long for the buffer: take the slow path
+    return InternedString(std::string(prefix) + std::to_string(number) + std::string(suffix));
+
+  char* pos = std::copy(prefix.begin(), prefix.end(), buffer.data());
+  pos       = std::to_chars(pos, buffer.data() + buffer.size(), number).ptr;
+  pos       = std::copy(suffix.begin(), suffix.end(), pos);
+  return InternedString(std::string_view(buffer.data(), pos - buffer.data()));
+}
+
+size_t InternedString::get_pool_size()
+{
+  return get_pool().size();
+}
+
+} // namespace simgrid::xbt
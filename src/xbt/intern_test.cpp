@@ -0,0 +1,79 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/3rd-party/catch.hpp"
+#include "xbt/intern.hpp"
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using simgrid::xbt::InternedString;
+
+TEST_CASE("xbt::InternedString: Interning strings", "")
+{
+  SECTION("Same characters, same entry")
+  {
+    InternedString a("intern-test-a");
+    InternedString b(std::string("intern-test-") + "a");
+    InternedString c("intern-test-c");
+    REQUIRE(a == b);
+    REQUIRE(a.id() == b.id());
+    REQUIRE(&a.str() == &b.str());
+    REQUIRE_FALSE(a == c);
+    REQUIRE(a < c);
+    REQUIRE_FALSE(c < a);
+    REQUIRE_FALSE(a < b);
+    REQUIRE(a.view() == "intern-test-a");
+    REQUIRE(std::string(a.c_str()) == "intern-test-a");
+    REQUIRE(InternedString().empty());
+    REQUIRE(InternedString() == InternedString(""));
+  }
+
+  SECTION("Lookup without interning")
+  {
+    REQUIRE_FALSE(InternedString::find("intern-test-never-interned").has_value());
+    size_t size = InternedString::get_pool_size();
+    REQUIRE_FALSE(InternedString::find("intern-test-never-interned").has_value());
+    REQUIRE(InternedString::get_pool_size() == size);
+
+    InternedString d("intern-test-d");
+    auto found = InternedString::find(std::string_view("intern-test-d-and-more").substr(0, 13));
+    REQUIRE(found.has_value());
+    REQUIRE(*found == d);
+  }
+
+  SECTION("Names generated from a pattern")
+  {
+    REQUIRE(InternedString::from_pattern("node-", 42, ".cluster") == InternedString("node-42.cluster"));
+    REQUIRE(InternedString::from_pattern("", 0, "") == InternedString("0"));
+    REQUIRE(InternedString::from_pattern("n", -7, "") == InternedString("n-7"));
+    std::string long_prefix(300, 'x');
+    REQUIRE(InternedString::from_pattern(long_prefix, 1, "y").str() == long_prefix + "1y");
+  }
+
+  SECTION("Concurrent interning")
+  {
+    constexpr int nthreads = 4;
+    constexpr int count    = 1000;
+    std::vector<std::vector<InternedString>> results(nthreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; t++)
+      threads.emplace_back([&results, t] {
+        for (int i = 0; i < count; i++)
+          results[t].push_back(InternedString::from_pattern("intern-test-thread-", i, ""));
+      });
+    for (auto& thread : threads)
+      thread.join();
+
+    std::unordered_set<InternedString> distinct;
+    for (int t = 0; t < nthreads; t++) {
+      REQUIRE(results[t] == results[0]);
+      distinct.insert(results[t].begin(), results[t].end());
+    }
+    REQUIRE(distinct.size() == count);
+  }
+}
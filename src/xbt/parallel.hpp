@@ -0,0 +1,76 @@
+/* Short-lived parallel loops, used to speed up some precomputations.        */
+
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef XBT_PARALLEL_HPP
+#define XBT_PARALLEL_HPP
+
+#include "src/sthread/sthread.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace simgrid::xbt {
+
+/** @brief Converts a user-provided thread amount into an actual one (values lower than 1 mean one thread per core) */
+inline unsigned resolve_nthreads(int nthreads)
+{
+  if (nthreads >= 1)
+    return static_cast<unsigned>(nthreads);
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/** @brief Runs @c fun(rank, nworkers) on @c nworkers threads and waits for all of them.
+ *
+ * The calling thread takes rank 0, so no thread is created at all when @c nworkers is 1. Unlike the Parmap, the
+ * workers are not bound to any context and can be used before the simulation starts (e.g. during platform sealing).
+ * If some workers throw, the exception of the lowest rank is rethrown once all workers are done.
+ */
+template <typename F> void parallel_run(unsigned nworkers, F&& fun)
+{
+  if (nworkers <= 1) {
+    fun(0U, 1U);
+    return;
+  }
+  sthread_pause_guard guard; // Put sthread on pause during this call on need
+  std::vector<std::exception_ptr> errors(nworkers);
+  auto run = [&fun, &errors, nworkers](unsigned rank) {
+    try {
+      fun(rank, nworkers);
+    } catch (...) {
+      errors[rank] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(nworkers - 1);
+  for (unsigned rank = 1; rank < nworkers; rank++)
+    workers.emplace_back(run, rank);
+  run(0U);
+  for (auto& worker : workers)
+    worker.join();
+  for (auto const& error : errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+/** @brief Splits [0, count) into at most @c nthreads contiguous chunks and runs @c fun(begin, end) on each of them in
+ * parallel */
+template <typename F> void parallel_for(size_t count, unsigned nthreads, F&& fun)
+{
+  auto nworkers = static_cast<unsigned>(std::min<size_t>(std::max(1U, nthreads), std::max<size_t>(1, count)));
+  parallel_run(nworkers, [count, &fun](unsigned rank, unsigned total) {
+    size_t begin = count * rank / total;
+    size_t end   = count * (rank + 1) / total;
+    if (begin < end)
+      fun(begin, end);
+  });
+}
+
+} // namespace simgrid::xbt
+
+#endif
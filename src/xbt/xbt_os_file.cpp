@@ -52,8 +52,10 @@ std::ifstream* simgrid::xbt::path_ifsopen(const std::string& name)
   xbt_assert(not name.empty());
 
   auto* fs = new std::ifstream();
-  if (name[0] == '/') // don't mess with absolute file names
+  if (name[0] == '/') { // don't mess with absolute file names
     fs->open(name.c_str(), std::ifstream::in);
+    return fs;
+  }
 
   /* search relative files in the path */
   for (auto const& path_elm : file_path) {
@@ -67,6 +69,22 @@ std::ifstream* simgrid::xbt::path_ifsopen(const std::string& name)
   return fs;
 }
 
+std::string simgrid::xbt::path_find(const std::string& name)
+{
+  xbt_assert(not name.empty());
+
+  if (name[0] == '/') // don't mess with absolute file names
+    return access(name.c_str(), R_OK) == 0 ? name : "";
+
+  /* search relative files in the path */
+  for (auto const& path_elm : file_path) {
+    std::string buff = path_elm + "/" + name;
+    if (access(buff.c_str(), R_OK) == 0)
+      return buff;
+  }
+  return "";
+}
+
 simgrid::xbt::Path::Path()
 {
   std::array<char, 2048> buffer;
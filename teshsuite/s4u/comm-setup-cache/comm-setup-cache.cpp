@@ -0,0 +1,117 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* The memoized setups of the communications (see network/setup-cache-size) must not change the simulated dates.
+ * Hosts A, B and C are chained by two links (AB and BC), and a wifi station is reached through BC:
+ *  - the same hosts communicate several times, in both directions;
+ *  - the user changes the bandwidth of AB and the latency of BC;
+ *  - a profile changes the bandwidth of AB;
+ *  - the rate of the wifi station changes (such routes are never memoized);
+ *  - with the "factor" argument, a bandwidth factor callback changes its value (the setups are then never memoized). */
+
+#include "simgrid/kernel/ProfileBuilder.hpp"
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(comm_setup_cache, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+static double bandwidth_factor = 1.0;
+
+static void send(const char* dest, double size)
+{
+  double start = sg4::Engine::get_clock();
+  sg4::Mailbox::by_name(dest)->put(new double(size), size);
+  XBT_INFO("Sent %.0f bytes to %s in %f seconds", size, dest, sg4::Engine::get_clock() - start);
+}
+
+static void sender(bool with_factor)
+{
+  send("B", 1e6);
+  send("B", 1e6);
+  send("C", 1e6);
+  send("C", 1e6);
+
+  XBT_INFO("Halve the bandwidth of AB, and raise the latency of BC");
+  sg4::Link* ab = sg4::Link::by_name("AB");
+  ab->set_bandwidth(ab->get_bandwidth() / 2);
+  send("B", 1e6);
+  sg4::Link::by_name("BC")->set_latency(1e-2);
+  send("C", 1e6);
+
+  XBT_INFO("Wait for the profile of AB to lower its bandwidth");
+  sg4::this_actor::sleep_until(20);
+  send("B", 1e6);
+  send("C", 1e6);
+
+  send("station", 1e6);
+  XBT_INFO("Lower the rate of the wifi station");
+  sg4::Link::by_name("AP")->set_host_wifi_rate(sg4::Host::by_name("station"), 1);
+  send("station", 1e6);
+
+  if (with_factor) {
+    XBT_INFO("Change the bandwidth factor");
+    bandwidth_factor = 0.5;
+    send("B", 1e6);
+    send("C", 1e6);
+  }
+}
+
+static void back_sender()
+{
+  sg4::this_actor::sleep_until(10);
+  send("A", 1e6);
+  send("A", 1e6);
+}
+
+static void receiver()
+{
+  sg4::Actor::self()->daemonize();
+  sg4::Mailbox* mailbox = sg4::Mailbox::by_name(sg4::this_actor::get_host()->get_name());
+  while (true)
+    mailbox->get_unique<double>();
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+  bool with_factor = argc > 1 && std::string(argv[1]) == "factor";
+
+  auto* root     = e.get_netzone_root();
+  auto* zone     = root->add_netzone_full("wired");
+  sg4::Host* a   = zone->add_host("A", 1e9);
+  sg4::Host* b   = zone->add_host("B", 1e9);
+  sg4::Host* c   = zone->add_host("C", 1e9);
+  sg4::Link* ab  = zone->add_link("AB", 1e7)->set_latency(1e-3);
+  const auto* bc = zone->add_link("BC", 1e7)->set_latency(1e-3);
+  ab->set_bandwidth_profile(simgrid::kernel::profile::ProfileBuilder::from_string("AB-bandwidth", "15 2500000\n", -1));
+  zone->add_route(a, b, {ab});
+  zone->add_route(b, c, {bc});
+  zone->add_route(a, c, std::vector<const sg4::Link*>{ab, bc});
+  zone->set_gateway(c);
+  zone->seal();
+
+  auto* wifi   = root->add_netzone_wifi("wifi");
+  auto* router = wifi->add_router("AP-router");
+  wifi->set_gateway(router);
+  wifi->set_property("access_point", "AP-router");
+  sg4::Host* station = wifi->add_host("station", 1e9);
+  sg4::Link* access  = wifi->add_link("AP", std::vector<double>{2e6, 1e6});
+  access->set_host_wifi_rate(station, 0);
+  wifi->seal();
+
+  root->add_route(zone, wifi, {root->add_link("backbone", 1e8)->set_latency(1e-3)});
+
+  if (with_factor)
+    root->set_bandwidth_factor_cb([](double, const sg4::Host*, const sg4::Host*, const std::vector<sg4::Link*>&,
+                                     const std::unordered_set<sg4::NetZone*>&) { return bandwidth_factor; });
+
+  a->add_actor("sender", sender, with_factor);
+  c->add_actor("back-sender", back_sender);
+  for (auto* host : {a, b, c, station})
+    host->add_actor("receiver", receiver);
+  e.run();
+
+  return 0;
+}
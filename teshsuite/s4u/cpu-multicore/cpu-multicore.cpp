@@ -0,0 +1,99 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Executions sharing a host of 4 cores, to compare the Multicore CPU model with Cas01 (they give the same dates):
+ *  - single-core executions, a 2-thread execution, a bounded one and a prioritized one share the cores;
+ *  - an execution is suspended and resumed, another one is canceled;
+ *  - the host slows down at some point;
+ *  - many tiny executions are started at once.
+ * The Multicore model also refuses to create virtual machines. */
+
+#include "simgrid/Exception.hpp"
+#include "simgrid/s4u.hpp"
+#include "xbt/config.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(cpu_multicore, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+static void execute(double flops, int threads, double bound, double priority)
+{
+  sg4::this_actor::exec_init(flops)->set_thread_count(threads)->set_bound(bound)->set_priority(priority)->wait();
+  XBT_INFO("Done");
+}
+
+static void suspended()
+{
+  sg4::ExecPtr exec = sg4::this_actor::exec_async(5e8);
+  sg4::this_actor::sleep_for(0.5);
+  exec->suspend();
+  XBT_INFO("Suspended with %.0f flops left", exec->get_remaining());
+  sg4::this_actor::sleep_for(1);
+  exec->resume();
+  exec->wait();
+  XBT_INFO("Done");
+}
+
+static void canceled()
+{
+  sg4::ExecPtr exec = sg4::this_actor::exec_async(1e10);
+  sg4::this_actor::sleep_for(3);
+  XBT_INFO("Cancel with %.0f flops left", exec->get_remaining());
+  exec->cancel();
+}
+
+static void monitor()
+{
+  sg4::Host* host = sg4::this_actor::get_host();
+  sg4::this_actor::sleep_for(1);
+  XBT_INFO("Load: %.0f flops/s", host->get_load());
+  sg4::this_actor::sleep_for(1);
+  host->set_pstate(1);
+  XBT_INFO("Slowed down to %.0f flops/s per core", host->get_speed());
+}
+
+static void tiny_executions()
+{
+  sg4::this_actor::sleep_for(5);
+  sg4::ActivitySet execs;
+  for (int i = 1; i <= 1000; i++)
+    execs.push(sg4::this_actor::exec_async(1e5 * (1 + i % 7)));
+  execs.wait_all();
+  XBT_INFO("All tiny executions are done");
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+
+  auto* zone      = e.get_netzone_root()->add_netzone_full("zone");
+  sg4::Host* host = zone->add_host("big", std::vector<double>{1e9, 5e8})->set_core_count(4);
+  zone->seal();
+
+  for (int i = 1; i <= 4; i++)
+    host->add_actor("single-" + std::to_string(i), execute, 3e8 * i, 1, -1, 1);
+  host->add_actor("threads", execute, 1e9, 2, -1, 1);
+  host->add_actor("bounded", execute, 2e8, 1, 1e8, 1);
+  host->add_actor("priority", execute, 1.1e9, 1, -1, 2);
+  host->add_actor("suspended", suspended);
+  host->add_actor("canceled", canceled);
+  host->add_actor("monitor", monitor);
+  host->add_actor("sleeper", [] {
+    sg4::this_actor::sleep_for(1.5);
+    XBT_INFO("Done");
+  });
+  host->add_actor("tiny", tiny_executions);
+
+  if (simgrid::config::get_value<std::string>("cpu/model") == "Multicore") {
+    try {
+      host->create_vm("vm", 1);
+    } catch (const simgrid::AssertionError& ex) {
+      XBT_INFO("%s", ex.what());
+    }
+  }
+
+  e.run();
+  XBT_INFO("Simulation ends");
+  return 0;
+}
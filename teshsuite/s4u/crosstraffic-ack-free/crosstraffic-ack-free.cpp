@@ -0,0 +1,57 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* All-to-all exchange over a star of split-duplex links, run with and without network/crosstraffic-ack-free.
+ * Every peer sends flows of different sizes to all the other peers at once, and the links of the odd peers are twice
+ * as fast as the others: the down links are saturated by the downloads and by the ACKs of the uploads, which is the
+ * worst case of the ACK-free approximation. The number of peers is given as first argument (default: 4). */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(crosstraffic_ack_free, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+static void peer(int me, int count)
+{
+  sg4::Mailbox* mailbox = sg4::Mailbox::by_name("peer-" + std::to_string(me));
+  sg4::ActivitySet flows;
+  for (int i = 0; i < count; i++) {
+    if (i == me)
+      continue;
+    double size = 1e7 * (1 + (me + i) % 3);
+    flows.push(sg4::Mailbox::by_name("peer-" + std::to_string(i))->put_async(new double(size), size));
+  }
+  std::vector<double*> payloads(count - 1);
+  for (auto& payload : payloads)
+    flows.push(mailbox->get_async<double>(&payload));
+
+  flows.wait_all();
+  for (const double* payload : payloads)
+    delete payload;
+  XBT_INFO("Done");
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+  int count = argc > 1 ? std::stoi(argv[1]) : 4;
+
+  auto* zone = e.get_netzone_root()->add_netzone_star("star");
+  std::vector<sg4::Host*> hosts;
+  for (int i = 0; i < count; i++) {
+    std::string name = "peer-" + std::to_string(i);
+    hosts.push_back(zone->add_host(name, 1e9));
+    const auto* link = zone->add_split_duplex_link("link-" + name, 1.25e8 * (1 + i % 2))->set_latency(1e-5);
+    zone->add_route(hosts.back(), nullptr, {{link, sg4::LinkInRoute::Direction::UP}}, true);
+  }
+  zone->seal();
+
+  for (int i = 0; i < count; i++)
+    hosts[i]->add_actor("peer", peer, i, count);
+
+  e.run();
+  XBT_INFO("Simulation ends");
+  return 0;
+}
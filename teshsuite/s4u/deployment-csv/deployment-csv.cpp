@@ -0,0 +1,40 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+static void worker(std::vector<std::string> args)
+{
+  std::string msg = "Started with " + std::to_string(args.size() - 1) + " argument(s):";
+  for (size_t i = 1; i < args.size(); i++)
+    msg += " '" + args[i] + "'";
+  XBT_INFO("%s", msg.c_str());
+}
+
+static void sleeper(std::vector<std::string> args)
+{
+  sg4::this_actor::on_exit([](bool failed) { XBT_INFO("Exiting (%s)", failed ? "killed" : "done"); });
+  XBT_INFO("Sleeping for %s seconds", args.at(1).c_str());
+  sg4::this_actor::sleep_for(std::stod(args.at(1)));
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+  xbt_assert(argc == 3, "Usage: %s platform_file deployment.csv", argv[0]);
+
+  e.load_platform(argv[1]);
+  e.register_function("worker", &worker);
+  e.register_function("sleeper", &sleeper);
+  e.load_deployment(argv[2]);
+  XBT_INFO("%zu actors deployed", e.get_actor_count());
+
+  e.run();
+  XBT_INFO("Simulation ended at %g", sg4::Engine::get_clock());
+  return 0;
+}
@@ -0,0 +1,160 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Benchmark of the cross-traffic, with and without ACK-free links (see network/crosstraffic-ack-free).
+ *
+ * teshsuite/s4u/evaluate-crosstraffic/evaluate-crosstraffic [workload:hosts:mode ...] [--cfg=...]
+ *
+ * The peers are connected by a star of split-duplex links, and the links of the odd peers are twice as fast as the
+ * others. They send flows of different sizes at once, following one of these workloads:
+ *  - gather: all the peers send to the first one, whose down link is saturated while the ACKs use the other links. The
+ *    flows all have different sizes, so that each one ends at its own date;
+ *  - alltoall: each peer sends to all the others, so the down links are saturated by the downloads and by the ACKs of
+ *    the uploads (as in teshsuite/s4u/crosstraffic-ack-free).
+ * One CSV line is displayed per run, with the simulated date, the time spent in the simulation and the peak memory.
+ *
+ * Modes are "ack" (the ACKs are shared on the way back, which is the default) and "ack-free". Without any run, a
+ * default sweep over both workloads and modes at several scales is done. Every run is done in its own process (this
+ * program calls itself) so that the memory measurements do not interfere.
+ */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/xbt_os_time.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <sys/resource.h>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(evaluate_crosstraffic, "Messages specific for this benchmark");
+
+namespace sg4 = simgrid::s4u;
+
+/* Peak resident set size of the process, in kiB (Linux) */
+static long get_peak_rss()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+static void peer(int me, std::vector<std::pair<int, double>> sends, int sources)
+{
+  sg4::Mailbox* mailbox = sg4::Mailbox::by_name("peer-" + std::to_string(me));
+  sg4::ActivitySet flows;
+  for (auto [dest, size] : sends)
+    flows.push(sg4::Mailbox::by_name("peer-" + std::to_string(dest))->put_async(new double(size), size));
+
+  std::vector<double*> payloads(sources);
+  for (auto& payload : payloads)
+    flows.push(mailbox->get_async<double>(&payload));
+
+  flows.wait_all();
+  for (const double* payload : payloads)
+    delete payload;
+}
+
+static void evaluate(int* argc, char** argv, const std::string& workload, int hosts, bool ack_free, bool header)
+{
+  sg4::Engine e(argc, argv);
+  sg4::Engine::set_config("network/crosstraffic-ack-free", ack_free);
+
+  auto* zone = e.get_netzone_root()->add_netzone_star("star");
+  std::vector<sg4::Host*> peers;
+  for (int i = 0; i < hosts; i++) {
+    std::string name = "peer-" + std::to_string(i);
+    peers.push_back(zone->add_host(name, 1e9));
+    const auto* link = zone->add_split_duplex_link("link-" + name, 1.25e8 * (1 + i % 2))->set_latency(1e-5);
+    zone->add_route(peers.back(), nullptr, {{link, sg4::LinkInRoute::Direction::UP}}, true);
+  }
+  zone->seal();
+
+  int flow_count = 0;
+  for (int i = 0; i < hosts; i++) {
+    std::vector<std::pair<int, double>> sends;
+    int sources = 0;
+    if (workload == "gather") { // Every flow ends at its own date
+      if (i > 0)
+        sends.emplace_back(0, 1e6 * i);
+      else
+        sources = hosts - 1;
+    } else {
+      for (int j = 0; j < hosts; j++)
+        if (j != i)
+          sends.emplace_back(j, 1e7 * (1 + (i + j) % 3));
+      sources = hosts - 1;
+    }
+    flow_count += static_cast<int>(sends.size());
+    peers[i]->add_actor("peer", peer, i, sends, sources);
+  }
+
+  xbt_os_timer_t timer = xbt_os_timer_new();
+  xbt_os_cputimer_start(timer);
+  e.run();
+  xbt_os_cputimer_stop(timer);
+  double run_time = xbt_os_timer_elapsed(timer);
+  xbt_os_timer_free(timer);
+
+  if (header)
+    printf("workload,hosts,mode,flows,simulated_s,run_s,peak_rss_kib\n");
+  printf("%s,%d,%s,%d,%f,%f,%ld\n", workload.c_str(), hosts, ack_free ? "ack-free" : "ack", flow_count,
+         sg4::Engine::get_clock(), run_time, get_peak_rss());
+  fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+  bool header = true;
+  std::vector<std::string> specs;
+  std::string forwarded; // the options given to the sub-processes
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--no-header")
+      header = false;
+    else if (arg.rfind("--", 0) != 0)
+      specs.push_back(arg);
+    if (arg.rfind("--", 0) == 0 && arg != "--no-header")
+      forwarded += " '" + arg + "'";
+  }
+
+  if (specs.empty()) { // Default sweep: both workloads and modes at several scales
+    for (int hosts : {256, 1024, 2048})
+      for (std::string mode : {"ack", "ack-free"})
+        specs.push_back("gather:" + std::to_string(hosts) + ":" + mode);
+    for (int hosts : {16, 64, 128})
+      for (std::string mode : {"ack", "ack-free"})
+        specs.push_back("alltoall:" + std::to_string(hosts) + ":" + mode);
+  }
+
+  if (specs.size() > 1) { // Evaluate each run in a separate process
+    if (header)
+      printf("workload,hosts,mode,flows,simulated_s,run_s,peak_rss_kib\n");
+    fflush(stdout);
+    for (auto const& spec : specs) {
+      std::string cmd = std::string("'") + argv[0] + "' --no-header" + forwarded + " '" + spec + "'";
+      if (std::system(cmd.c_str()) != 0) {
+        fprintf(stderr, "Evaluation of %s failed\n", spec.c_str());
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  auto first  = specs.front().find(':');
+  auto second = specs.front().find(':', first == std::string::npos ? first : first + 1);
+  xbt_assert(second != std::string::npos, "Invalid run '%s', expecting workload:hosts:mode", specs.front().c_str());
+  std::string workload = specs.front().substr(0, first);
+  int hosts            = std::stoi(specs.front().substr(first + 1, second - first - 1));
+  std::string mode     = specs.front().substr(second + 1);
+  xbt_assert(workload == "gather" || workload == "alltoall", "Unknown workload '%s', expecting gather or alltoall",
+             workload.c_str());
+  xbt_assert(hosts > 1, "At least 2 hosts are needed");
+  xbt_assert(mode == "ack" || mode == "ack-free", "Unknown mode '%s', expecting ack or ack-free", mode.c_str());
+
+  evaluate(&argc, argv, workload, hosts, mode == "ack-free", header);
+  return 0;
+}
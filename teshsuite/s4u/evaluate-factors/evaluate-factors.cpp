@@ -0,0 +1,132 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Microbenchmark of the network and SMPI factors, that are evaluated for every communication.
+ *
+ * teshsuite/s4u/evaluate-factors/evaluate-factors [--lookups=N]
+ *
+ * Each factor set (the default SMPI latency and bandwidth factors, and an SMPI overhead such as smpi/os) is evaluated
+ * for the same random message sizes, both by the FactorSet and by a linear scan of the intervals that calls the
+ * lambda of the matching interval, as FactorSet did before compiling its intervals. One CSV line is displayed per
+ * factor set, with the time per lookup of both approaches. The program fails if they ever disagree.
+ */
+
+#include "src/kernel/resource/FactorSet.hpp"
+#include "xbt/asserts.h"
+#include "xbt/log.h"
+
+#include <algorithm>
+#include <boost/tokenizer.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(evaluate_factors, "Messages specific for this benchmark");
+
+using simgrid::kernel::resource::FactorSet;
+using FactorLambda = std::function<double(std::vector<double> const&, double)>;
+
+/* The reference: a linear scan over the sorted intervals, with a lambda call per lookup */
+class LinearFactors {
+  std::vector<s_smpi_factor_t> factors_;
+  double default_value_;
+  FactorLambda lambda_;
+
+public:
+  LinearFactors(const std::string& spec, double default_value, const FactorLambda& lambda)
+      : default_value_(default_value), lambda_(lambda)
+  {
+    using Tokenizer = boost::tokenizer<boost::char_separator<char>>;
+    boost::char_separator<char> sep(";");
+    boost::char_separator<char> factor_separator(":");
+    for (auto const& chunk : Tokenizer(spec, sep)) {
+      s_smpi_factor_t fact;
+      bool first = true;
+      for (auto const& value : Tokenizer(chunk, factor_separator)) {
+        if (first)
+          fact.factor = std::stoul(value);
+        else
+          fact.values.push_back(std::stod(value));
+        first = false;
+      }
+      factors_.push_back(fact);
+    }
+    std::sort(factors_.begin(), factors_.end(),
+              [](const s_smpi_factor_t& pa, const s_smpi_factor_t& pb) { return pa.factor < pb.factor; });
+  }
+
+  size_t size() const { return factors_.size(); }
+
+  double operator()(double size) const
+  {
+    for (size_t i = 0; i < factors_.size(); i++)
+      if (size <= factors_[i].factor)
+        return i == 0 ? default_value_ : lambda_(factors_[i - 1].values, size);
+    return factors_.empty() ? default_value_ : lambda_(factors_.back().values, size);
+  }
+};
+
+template <typename F> static double time_per_lookup(const F& factors, const std::vector<double>& sizes, double& sum)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (double size : sizes)
+    sum += factors(size);
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(sizes.size());
+}
+
+static void evaluate(const char* path, const std::string& spec, double default_value, const FactorLambda& lambda,
+                     const std::vector<double>& sizes)
+{
+  FactorSet table(path, default_value, lambda);
+  table.parse(spec);
+  LinearFactors scan(spec, default_value, lambda);
+
+  for (double size : sizes)
+    xbt_assert(table(size) == scan(size), "%s: the factor of size %g differs (%g instead of %g)", path, size,
+               table(size), scan(size));
+
+  double table_sum = 0;
+  double scan_sum  = 0;
+  double scan_ns   = time_per_lookup(scan, sizes, scan_sum);
+  double table_ns  = time_per_lookup(table, sizes, table_sum);
+  xbt_assert(table_sum == scan_sum);
+  printf("%s,%zu,%zu,%.2f,%.2f\n", path, scan.size() + 1, sizes.size(), scan_ns, table_ns);
+}
+
+int main(int argc, char** argv)
+{
+  int lookups = 1000000;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    xbt_assert(arg.rfind("--lookups=", 0) == 0, "Usage: %s [--lookups=N]", argv[0]);
+    lookups = std::stoi(arg.substr(10));
+  }
+  xbt_assert(lookups > 0, "The amount of lookups must be positive");
+
+  /* Message sizes spread over 1 B to 16 MiB on a logarithmic scale, as in the typical MPI applications */
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> exponent(0, 24);
+  std::vector<double> sizes(lookups);
+  for (auto& size : sizes)
+    size = std::floor(std::exp2(exponent(gen)));
+
+  printf("path,intervals,lookups,scan_ns,table_ns\n");
+  evaluate("network/latency-factor",
+           "65472:11.6436;15424:3.48845;9376:2.59299;5776:2.18796;3484:1.88101;1426:1.61075;732:1.9503;257:1.95341;"
+           "0:2.01467",
+           1.0, &FactorSet::constant, sizes);
+  evaluate("network/bandwidth-factor",
+           "65472:0.940694;15424:0.697866;9376:0.58729;5776:1.08739;3484:0.77493;1426:0.608902;732:0.341987;"
+           "257:0.338112;0:0.812084",
+           1.0, &FactorSet::constant, sizes);
+  evaluate("smpi/os", "0:3.5e-06:1.5e-10;1420:4.1e-06:2.3e-10;33000:1.1e-05:3.1e-10;65536:1.6e-05:4.4e-10", 0.0,
+           &FactorSet::affine, sizes);
+  return 0;
+}
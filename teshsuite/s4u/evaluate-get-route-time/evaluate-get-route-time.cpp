@@ -8,12 +8,39 @@ for i in $(seq 1 20); do
   teshsuite/s4u/evaluate-get-route-time/evaluate-get-route-time examples/platforms/cluster_backbone.xml
   sleep 1
 done
+
+An optional second parameter gives the amount of lookups to time, between random pairs of hosts. The average time of
+one lookup is then displayed. The same vector is reused by all lookups, as a planner querying many routes would do.
+The average amount of memory allocations per lookup is displayed too: it should be 0 once the buffers of the routing
+have grown, on platforms without bypass routes.
 */
 
 #include "simgrid/s4u.hpp"
 #include "xbt/random.hpp"
 #include "xbt/xbt_os_time.h"
+#include <atomic>
 #include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+static std::atomic<long> allocation_count{0};
+
+void* operator new(std::size_t size)
+{
+  allocation_count++;
+  if (void* ptr = std::malloc(size > 0 ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
 
 int main(int argc, char** argv)
 {
@@ -29,22 +56,44 @@ int main(int argc, char** argv)
   /* Random number initialization */
   simgrid::xbt::random::set_mersenne_seed(static_cast<int>(xbt_os_time()));
 
-  /* Take random i and j, with i != j */
   xbt_assert(host_count > 1);
-  int i = simgrid::xbt::random::uniform_int(0, host_count - 1);
-  int j = simgrid::xbt::random::uniform_int(0, host_count - 2);
-  if (j >= i) // '>=' is not a bug: j is uniform on host_count-1 values, and shifted on need to maintain uniform random
-    j++;
+  int lookups = argc > 2 ? std::stoi(argv[2]) : 1;
+  xbt_assert(lookups > 0, "The amount of lookups must be positive");
 
-  printf("%d\tand\t%d\t\t", i, j);
+  /* Take random i and j, with i != j */
+  std::vector<std::pair<int, int>> pairs;
+  for (int n = 0; n < lookups; n++) {
+    int i = simgrid::xbt::random::uniform_int(0, host_count - 1);
+    int j = simgrid::xbt::random::uniform_int(0, host_count - 2);
+    if (j >= i) // '>=' is not a bug: j is uniform on host_count-1 values, and shifted on need to maintain uniform random
+      j++;
+    pairs.emplace_back(i, j);
+  }
 
   std::vector<simgrid::s4u::Link*> route;
 
-  xbt_os_cputimer_start(timer);
-  hosts[i]->route_to(hosts[j], route, nullptr);
-  xbt_os_cputimer_stop(timer);
+  if (lookups == 1) {
+    auto [i, j] = pairs.front();
+    printf("%d\tand\t%d\t\t", i, j);
+
+    xbt_os_cputimer_start(timer);
+    hosts[i]->route_to(hosts[j], route, nullptr);
+    xbt_os_cputimer_stop(timer);
+
+    printf("%f\n", xbt_os_timer_elapsed(timer));
+  } else {
+    long allocations_before = allocation_count;
+    xbt_os_cputimer_start(timer);
+    for (auto const& [i, j] : pairs) {
+      route.clear();
+      hosts[i]->route_to(hosts[j], route, nullptr);
+    }
+    xbt_os_cputimer_stop(timer);
+    double allocations = static_cast<double>(allocation_count - allocations_before);
 
-  printf("%f\n", xbt_os_timer_elapsed(timer));
+    printf("%d lookups\t\t%g\t%g allocations per lookup\n", lookups, xbt_os_timer_elapsed(timer) / lookups,
+           allocations / lookups);
+  }
 
   return 0;
 }
@@ -0,0 +1,84 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Benchmark of the InfiniBand network model on an all-to-all, where every comm start and end updates the penalties.
+ *
+ * teshsuite/s4u/evaluate-ib/evaluate-ib [--hosts=N] [--rounds=R] [--cfg=...]
+ *
+ * The N hosts of a star zone each send a message to every other host, R times in a row. One CSV line is displayed at
+ * the end, with the amount of comms, the simulated time and the wall-clock time of the simulation.
+ */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/asserts.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(evaluate_ib, "Messages specific for this benchmark");
+
+namespace sg4 = simgrid::s4u;
+
+static int rounds = 1;
+
+static void alltoall(int rank, std::vector<sg4::Host*> hosts)
+{
+  int size           = static_cast<int>(hosts.size());
+  sg4::Mailbox* mine = sg4::Mailbox::by_name(hosts[rank]->get_name());
+  for (int r = 0; r < rounds; r++) {
+    sg4::ActivitySet pending;
+    std::vector<int*> payloads(size - 1, nullptr);
+    for (int i = 1; i < size; i++)
+      pending.push(mine->get_async<int>(&payloads[i - 1]));
+    for (int i = 1; i < size; i++) // Every host starts with a different destination, as in MPI_Alltoall
+      pending.push(sg4::Mailbox::by_name(hosts[(rank + i) % size]->get_name())->put_async(new int(rank), 1e6));
+    pending.wait_all();
+    for (auto const* payload : payloads)
+      delete payload;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+  e.set_config("network/model:IB");
+
+  int nb_hosts = 64;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.rfind("--hosts=", 0) == 0)
+      nb_hosts = std::stoi(arg.substr(8));
+    else if (arg.rfind("--rounds=", 0) == 0)
+      rounds = std::stoi(arg.substr(9));
+    else
+      xbt_die("Usage: %s [--hosts=N] [--rounds=R]", argv[0]);
+  }
+  xbt_assert(nb_hosts > 1 && rounds > 0, "There must be at least 2 hosts and 1 round");
+
+  auto* zone = e.get_netzone_root()->add_netzone_star("cluster");
+  std::vector<sg4::Host*> hosts;
+  for (int i = 0; i < nb_hosts; i++) {
+    sg4::Host* host       = zone->add_host("host-" + std::to_string(i), 1e9);
+    const sg4::Link* link = zone->add_split_duplex_link("link-" + std::to_string(i), 1.25e9)->set_latency(1e-6);
+    zone->add_route(host, nullptr, {{link, sg4::LinkInRoute::Direction::UP}}, true);
+    if (i == 0)
+      zone->set_gateway(host);
+    hosts.push_back(host);
+  }
+  zone->seal();
+
+  for (int i = 0; i < nb_hosts; i++)
+    hosts[i]->add_actor("rank-" + std::to_string(i), alltoall, i, hosts);
+
+  auto start = std::chrono::steady_clock::now();
+  e.run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  printf("hosts,comms,simulated_time,wall_time\n");
+  printf("%d,%d,%f,%f\n", nb_hosts, nb_hosts * (nb_hosts - 1) * rounds, sg4::Engine::get_clock(), elapsed.count());
+  return 0;
+}
@@ -6,10 +6,19 @@
 // teshsuite/s4u/evaluate-parse-time/evaluate-parse-time examples/platforms/g5k.xml
 
 #include <cstdio>
+#include <sys/resource.h>
 
 #include "simgrid/s4u/Engine.hpp"
 #include "xbt/xbt_os_time.h"
 
+/* Peak resident set size of the process, in kiB (Linux) */
+static long get_peak_rss()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
 int main(int argc, char** argv)
 {
   xbt_os_timer_t timer = xbt_os_timer_new();
@@ -19,9 +28,18 @@ int main(int argc, char** argv)
   xbt_os_cputimer_start(timer);
   e.load_platform(argv[1]);
   xbt_os_cputimer_stop(timer);
+  double parse_time = xbt_os_timer_elapsed(timer);
+  long parse_rss    = get_peak_rss();
+
+  /* sealing of the platform (routing tables precomputation), timed. Wall-clock as it may use several threads */
+  xbt_os_walltimer_start(timer);
+  e.seal_platform();
+  xbt_os_walltimer_stop(timer);
 
   /* Display the result and exit after cleanup */
-  printf("%f\n", xbt_os_timer_elapsed(timer));
+  printf("%f\n", parse_time);
+  printf("Seal time: %f, peak memory: %ld kiB after parsing, %ld kiB after sealing\n", xbt_os_timer_elapsed(timer),
+         parse_rss, get_peak_rss());
   printf("Host number: %zu, link number: %zu\n", e.get_host_count(), e.get_link_count());
   if (argv[2]) {
     printf("Wait for %ss\n", argv[2]);
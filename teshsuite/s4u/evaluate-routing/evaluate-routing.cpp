@@ -0,0 +1,246 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Benchmark of the routing, for every kind of netzone and at several scales.
+ *
+ * teshsuite/s4u/evaluate-routing/evaluate-routing [--json] [--lookups=N] [kind:hosts ...] [--cfg=...]
+ *
+ * Each platform is generated through the NetZone API, sealed and then queried between random pairs of hosts. One
+ * line is displayed per platform, in CSV (the default) or in JSON lines, with the time to build and to seal the
+ * platform, the peak memory and the median and 99th percentile of the route lookup times.
+ *
+ * Kinds are full, floyd, dijkstra, dijkstracache, star, torus, fattree, dragonfly and hierarchical. The amount of
+ * hosts is rounded to fit the topology. Without any kind, a default sweep over all kinds is done. Every platform is
+ * evaluated in its own process (this program calls itself) so that the memory measurements do not interfere.
+ */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/random.hpp"
+#include "xbt/xbt_os_time.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(evaluate_routing, "Messages specific for this benchmark");
+
+namespace sg4 = simgrid::s4u;
+
+/* Peak resident set size of the process, in kiB (Linux) */
+static long get_peak_rss()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+static unsigned int side(unsigned long hosts, unsigned int power)
+{
+  return std::max(2U, static_cast<unsigned int>(std::lround(std::pow(static_cast<double>(hosts), 1.0 / power))));
+}
+
+/* A square mesh of hosts, each one connected to its right and lower neighbors (for graph-based zones) */
+static void build_mesh(sg4::NetZone* zone, unsigned long hosts)
+{
+  unsigned int a = side(hosts, 2);
+  std::vector<const sg4::Host*> grid;
+  for (unsigned int i = 0; i < a * a; i++)
+    grid.push_back(zone->add_host("host-" + std::to_string(i), 1e9));
+  for (unsigned int i = 0; i < a * a; i++) {
+    if ((i + 1) % a != 0)
+      zone->add_route(grid[i], grid[i + 1], {zone->add_link("right-" + std::to_string(i), 1e9)->set_latency(1e-6)});
+    if (i + a < a * a)
+      zone->add_route(grid[i], grid[i + a], {zone->add_link("down-" + std::to_string(i), 1e9)->set_latency(1e-6)});
+  }
+}
+
+/* Each host has a private link, and the route between two hosts goes through both private links */
+static void build_full(sg4::NetZone* zone, unsigned long hosts)
+{
+  std::vector<const sg4::Host*> all;
+  std::vector<const sg4::Link*> links;
+  for (unsigned long i = 0; i < hosts; i++) {
+    all.push_back(zone->add_host("host-" + std::to_string(i), 1e9));
+    links.push_back(zone->add_link("link-" + std::to_string(i), 1e9)->set_latency(1e-6));
+  }
+  for (unsigned long i = 0; i < hosts; i++)
+    for (unsigned long j = i + 1; j < hosts; j++)
+      zone->add_route(all[i], all[j], std::vector<const sg4::Link*>{links[i], links[j]});
+}
+
+static void build_star(sg4::NetZone* zone, unsigned long hosts, const std::string& prefix = "")
+{
+  for (unsigned long i = 0; i < hosts; i++) {
+    const sg4::Host* host = zone->add_host(prefix + "host-" + std::to_string(i), 1e9);
+    const sg4::Link* link = zone->add_link(prefix + "link-" + std::to_string(i), 1e9)->set_latency(1e-6);
+    zone->add_route(host, nullptr, {{link, sg4::LinkInRoute::Direction::NONE}}, true);
+    if (i == 0)
+      zone->set_gateway(host);
+  }
+}
+
+static sg4::Host* create_host(sg4::NetZone* zone, const std::vector<unsigned long>& /*coord*/, unsigned long id)
+{
+  return zone->add_host("host-" + std::to_string(id), 1e9);
+}
+
+/* Builds the requested platform in the root zone, without sealing it. Throws if the kind is unknown */
+static void build_platform(const sg4::Engine& e, const std::string& kind, unsigned long hosts)
+{
+  auto* root         = e.get_netzone_root();
+  const auto SHARED  = sg4::Link::SharingPolicy::SHARED;
+  sg4::NetZone* zone = nullptr;
+  if (kind == "full") {
+    zone = root->add_netzone_full("full");
+    build_full(zone, hosts);
+  } else if (kind == "floyd") {
+    zone = root->add_netzone_floyd("floyd");
+    build_mesh(zone, hosts);
+  } else if (kind == "dijkstra" || kind == "dijkstracache") {
+    zone = root->add_netzone_dijkstra(kind, kind == "dijkstracache");
+    build_mesh(zone, hosts);
+  } else if (kind == "star") {
+    zone = root->add_netzone_star("star");
+    build_star(zone, hosts);
+  } else if (kind == "torus") {
+    unsigned long a = side(hosts, 3);
+    zone            = root->add_netzone_torus("torus", {a, a, a}, 1e9, 1e-6, SHARED)->set_host_cb(create_host);
+  } else if (kind == "fattree") {
+    unsigned int a = side(hosts, 2);
+    zone           = root->add_netzone_fatTree("fattree", 2, {a, a}, {1, 2}, {1, 2}, 1e9, 1e-6, SHARED)
+               ->set_host_cb(create_host);
+  } else if (kind == "dragonfly") {
+    /* Each router of a group is connected to one other group, so there are as many routers as groups */
+    unsigned int groups = side(hosts / 8, 2);
+    zone = root->add_netzone_dragonfly("dragonfly", {groups, 1}, {2, 1}, {groups, 1}, 4, 1e9, 1e-6, SHARED)
+               ->set_host_cb(create_host);
+  } else if (kind == "hierarchical") {
+    /* A full zone interconnecting star zones */
+    unsigned int a = side(hosts, 2);
+    zone           = root->add_netzone_full("hierarchical");
+    std::vector<const sg4::NetZone*> children;
+    std::vector<const sg4::Link*> uplinks;
+    for (unsigned int i = 0; i < a; i++) {
+      auto* child = zone->add_netzone_star("star-" + std::to_string(i));
+      build_star(child, a, "star-" + std::to_string(i) + "-");
+      child->seal();
+      children.push_back(child);
+      uplinks.push_back(zone->add_link("uplink-" + std::to_string(i), 1e10)->set_latency(1e-5));
+    }
+    for (unsigned int i = 0; i < a; i++)
+      for (unsigned int j = i + 1; j < a; j++)
+        zone->add_route(children[i], children[j], std::vector<const sg4::Link*>{uplinks[i], uplinks[j]});
+  } else {
+    throw std::invalid_argument("Unknown kind of zone: " + kind);
+  }
+}
+
+static void evaluate(int* argc, char** argv, const std::string& kind, unsigned long hosts, int lookups, bool json,
+                     bool header)
+{
+  sg4::Engine e(argc, argv);
+  xbt_os_timer_t timer = xbt_os_timer_new();
+
+  xbt_os_walltimer_start(timer);
+  build_platform(e, kind, hosts);
+  xbt_os_walltimer_stop(timer);
+  double build_time = xbt_os_timer_elapsed(timer);
+
+  /* Wall-clock as sealing may use several threads */
+  xbt_os_walltimer_start(timer);
+  e.seal_platform();
+  xbt_os_walltimer_stop(timer);
+  double seal_time = xbt_os_timer_elapsed(timer);
+  long peak_rss    = get_peak_rss();
+  xbt_os_timer_free(timer);
+
+  std::vector<sg4::Host*> all_hosts = e.get_all_hosts();
+  auto host_count                   = static_cast<int>(all_hosts.size());
+  xbt_assert(host_count > 1, "Not enough hosts in this platform");
+
+  std::vector<double> times(lookups);
+  std::vector<sg4::Link*> route;
+  for (double& time : times) {
+    int i = simgrid::xbt::random::uniform_int(0, host_count - 1);
+    int j = simgrid::xbt::random::uniform_int(0, host_count - 2);
+    if (j >= i) // so that i != j while keeping j uniform
+      j++;
+    route.clear();
+    auto start = std::chrono::steady_clock::now();
+    all_hosts[i]->route_to(all_hosts[j], route, nullptr);
+    time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  }
+  std::sort(times.begin(), times.end());
+  double p50 = times[times.size() / 2];
+  double p99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+
+  if (json) {
+    printf("{\"zone\": \"%s\", \"hosts\": %d, \"links\": %zu, \"build_s\": %f, \"seal_s\": %f, \"peak_rss_kib\": %ld, "
+           "\"lookups\": %d, \"p50_us\": %f, \"p99_us\": %f}\n",
+           kind.c_str(), host_count, e.get_link_count(), build_time, seal_time, peak_rss, lookups, p50, p99);
+  } else {
+    if (header)
+      printf("zone,hosts,links,build_s,seal_s,peak_rss_kib,lookups,p50_us,p99_us\n");
+    printf("%s,%d,%zu,%f,%f,%ld,%d,%f,%f\n", kind.c_str(), host_count, e.get_link_count(), build_time, seal_time,
+           peak_rss, lookups, p50, p99);
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+  bool json   = false;
+  bool header = true;
+  int lookups = 10000;
+  std::vector<std::string> specs;
+  std::string forwarded; // the options given to the sub-processes
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--json")
+      json = true;
+    else if (arg == "--no-header")
+      header = false;
+    else if (arg.rfind("--lookups=", 0) == 0)
+      lookups = std::stoi(arg.substr(10));
+    else if (arg.rfind("--", 0) != 0)
+      specs.push_back(arg);
+    if (arg.rfind("--", 0) == 0 && arg != "--no-header")
+      forwarded += " '" + arg + "'";
+  }
+  xbt_assert(lookups > 0, "The amount of lookups must be positive");
+
+  if (specs.empty()) // Default sweep: all kinds at several scales
+    for (std::string kind : {"full", "floyd", "dijkstra", "dijkstracache", "star", "torus", "fattree", "dragonfly",
+                             "hierarchical"})
+      for (int hosts : {64, 256, 1024})
+        specs.push_back(kind + ":" + std::to_string(hosts));
+
+  if (specs.size() > 1) { // Evaluate each platform in a separate process
+    if (header && not json)
+      printf("zone,hosts,links,build_s,seal_s,peak_rss_kib,lookups,p50_us,p99_us\n");
+    fflush(stdout);
+    for (auto const& spec : specs) {
+      std::string cmd = std::string("'") + argv[0] + "' --no-header" + forwarded + " '" + spec + "'";
+      if (std::system(cmd.c_str()) != 0) {
+        fprintf(stderr, "Evaluation of %s failed\n", spec.c_str());
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  auto colon = specs.front().find(':');
+  xbt_assert(colon != std::string::npos, "Invalid platform '%s', expecting kind:hosts", specs.front().c_str());
+  std::string kind    = specs.front().substr(0, colon);
+  unsigned long hosts = std::stoul(specs.front().substr(colon + 1));
+
+  evaluate(&argc, argv, kind, hosts, lookups, json, header);
+  return 0;
+}
@@ -0,0 +1,123 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* The aggregated flows (see network/flow-aggregation) must complete at the same dates as separate flows.
+ * Four senders start several flows of different sizes to the same receiver at once, through their own link and a
+ * shared core link. The flows of each sender are aggregated, and leave their aggregate one after the other:
+ *  - the core link halves its bandwidth while the flows of the first round are running;
+ *  - the link of a sender is turned off (and then back on) while the flows of the second round are running. */
+
+#include "simgrid/Exception.hpp"
+#include "simgrid/s4u.hpp"
+
+#include <array>
+#include <map>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(flow_aggregation, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+constexpr int SENDER_COUNT = 4;
+constexpr int FLOW_COUNT   = 4;
+
+static void send_round()
+{
+  sg4::Mailbox* mailbox = sg4::Mailbox::by_name("receiver-" + sg4::this_actor::get_host()->get_name());
+  sg4::ActivitySet flows;
+  std::map<const sg4::Activity*, double> sizes;
+  std::map<const sg4::Activity*, double*> payloads; // The payloads of the failed flows are not received
+  for (int i = 1; i <= FLOW_COUNT; i++) {
+    auto* payload     = new double(i * 1e6);
+    sg4::CommPtr flow = mailbox->put_async(payload, *payload);
+    sizes[flow.get()]    = *payload;
+    payloads[flow.get()] = payload;
+    flows.push(flow);
+  }
+
+  while (not flows.empty()) {
+    try {
+      sg4::ActivityPtr flow = flows.wait_any();
+      XBT_INFO("Sent %.0f bytes", sizes[flow.get()]);
+    } catch (const simgrid::NetworkFailureException&) {
+      while (sg4::ActivityPtr flow = flows.get_failed_activity()) {
+        XBT_INFO("The flow of %.0f bytes failed", sizes[flow.get()]);
+        delete payloads[flow.get()];
+      }
+    }
+  }
+}
+
+static void sender()
+{
+  send_round();
+  sg4::this_actor::sleep_until(10);
+  send_round();
+}
+
+static void receiver(const std::string& name)
+{
+  sg4::Actor::self()->daemonize();
+  sg4::Mailbox* mailbox = sg4::Mailbox::by_name(name);
+  while (true) { // Accept all the flows of a round at once, so that they start together
+    std::array<double*, FLOW_COUNT> payloads;
+    std::map<const sg4::Activity*, double**> destinations;
+    sg4::ActivitySet flows;
+    for (auto& payload : payloads) {
+      sg4::CommPtr flow = mailbox->get_async<double>(&payload);
+      destinations[flow.get()] = &payload;
+      flows.push(flow);
+    }
+    while (not flows.empty()) {
+      try {
+        sg4::ActivityPtr flow = flows.wait_any();
+        delete *destinations[flow.get()];
+      } catch (const simgrid::NetworkFailureException&) {
+        while (flows.get_failed_activity()) // The sender reports the failures, and frees their payloads
+          ;
+      }
+    }
+  }
+}
+
+static void controller()
+{
+  sg4::this_actor::sleep_until(0.05);
+  XBT_INFO("Halve the bandwidth of the core link");
+  sg4::Link* core = sg4::Link::by_name("core");
+  core->set_bandwidth(core->get_bandwidth() / 2);
+
+  sg4::this_actor::sleep_until(10.05);
+  XBT_INFO("Turn off the link of sender-1");
+  sg4::Link* link = sg4::Link::by_name("link-1");
+  link->turn_off();
+  sg4::this_actor::sleep_until(11);
+  XBT_INFO("Turn it back on");
+  link->turn_on();
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+
+  auto* zone       = e.get_netzone_root()->add_netzone_full("zone");
+  sg4::Host* dest  = zone->add_host("receiver", 1e9);
+  const auto* core = zone->add_link("core", 1e8)->set_latency(1e-4);
+  std::vector<sg4::Host*> senders;
+  for (int i = 0; i < SENDER_COUNT; i++) {
+    senders.push_back(zone->add_host("sender-" + std::to_string(i), 1e9));
+    const auto* link = zone->add_link("link-" + std::to_string(i), 1e8)->set_latency(1e-4);
+    zone->add_route(senders.back(), dest, std::vector<const sg4::Link*>{link, core});
+  }
+  zone->seal();
+
+  for (auto* host : senders) {
+    host->add_actor("sender", sender);
+    dest->add_actor("receiver", receiver, "receiver-" + host->get_name());
+  }
+  dest->add_actor("controller", controller);
+
+  e.run();
+  XBT_INFO("Simulation ends");
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* The Packet network model on a chain of two links (A-B-C, 1MB/s and 1ms each), with packets of 1500 bytes:
+ *  - one packet pays the transmission and the latency of each link in turn (store and forward);
+ *  - the packets of a window are pipelined along the route;
+ *  - two flows that leave A together are served in FIFO order by the first link;
+ *  - a flow bounded by a rate is paced by that rate, and a suspended flow resumes where it stopped;
+ *  - the window of a long flow is halved when it fills the queues (see network/packet-queue-size);
+ *  - turning a link off fails the flows that cross it. */
+
+#include "simgrid/Exception.hpp"
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(network_packet, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+static void send(const char* dest, double size)
+{
+  double start = sg4::Engine::get_clock();
+  sg4::Mailbox::by_name(dest)->put(new double(size), size);
+  XBT_INFO("Sent %.0f bytes to %s in %f seconds", size, dest, sg4::Engine::get_clock() - start);
+}
+
+static void sender()
+{
+  send("B", 1000);
+  send("C", 1000);
+  send("C", 15000);
+
+  sg4::this_actor::sleep_until(1);
+  sg4::CommPtr to_b = sg4::Mailbox::by_name("B")->put_async(new double(15000), 15000);
+  sg4::CommPtr to_c = sg4::Mailbox::by_name("C")->put_async(new double(15000), 15000);
+  to_b->wait();
+  XBT_INFO("The concurrent flow to B is over");
+  to_c->wait();
+  XBT_INFO("The concurrent flow to C is over");
+
+  sg4::this_actor::sleep_until(2);
+  double start = sg4::Engine::get_clock();
+  sg4::Mailbox::by_name("B")->put_init(new double(15000), 15000)->set_rate(1e5)->wait();
+  XBT_INFO("Sent 15000 bytes to B at 100kB/s in %f seconds", sg4::Engine::get_clock() - start);
+
+  sg4::this_actor::sleep_until(3);
+  sg4::CommPtr suspended = sg4::Mailbox::by_name("C")->put_async(new double(150000), 150000);
+  sg4::this_actor::sleep_for(0.005);
+  suspended->suspend();
+  XBT_INFO("Suspend the flow to C with %.0f bytes left", suspended->get_remaining());
+  sg4::this_actor::sleep_for(1);
+  suspended->resume();
+  suspended->wait();
+  XBT_INFO("The suspended flow to C is over");
+
+  sg4::this_actor::sleep_until(5);
+  send("C", 1e6);
+
+  sg4::this_actor::sleep_until(10);
+  auto* payload       = new double(15000);
+  sg4::CommPtr doomed = sg4::Mailbox::by_name("C")->put_async(payload, 15000);
+  sg4::this_actor::sleep_for(0.005);
+  sg4::Link* bc = sg4::Link::by_name("BC");
+  bc->turn_off();
+  try {
+    doomed->wait();
+  } catch (const simgrid::NetworkFailureException&) {
+    XBT_INFO("The flow to C failed when BC was turned off");
+    delete payload;
+  }
+  bc->turn_on();
+}
+
+static void receiver(int count)
+{
+  sg4::Mailbox* mailbox = sg4::Mailbox::by_name(sg4::this_actor::get_host()->get_name());
+  for (int i = 0; i < count; i++) {
+    try {
+      mailbox->get_unique<double>();
+    } catch (const simgrid::NetworkFailureException&) {
+      XBT_INFO("The reception failed");
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+
+  auto* zone          = e.get_netzone_root()->add_netzone_full("zone");
+  sg4::Host* a        = zone->add_host("A", 1e9);
+  sg4::Host* b        = zone->add_host("B", 1e9);
+  sg4::Host* c        = zone->add_host("C", 1e9);
+  const sg4::Link* ab = zone->add_link("AB", 1e6)->set_latency(1e-3);
+  const sg4::Link* bc = zone->add_link("BC", 1e6)->set_latency(1e-3);
+  zone->add_route(a, b, {ab});
+  zone->add_route(b, c, {bc});
+  zone->add_route(a, c, std::vector<const sg4::Link*>{ab, bc});
+  zone->seal();
+
+  a->add_actor("sender", sender);
+  b->add_actor("receiver", receiver, 3);
+  c->add_actor("receiver", receiver, 6);
+  e.run();
+
+  return 0;
+}
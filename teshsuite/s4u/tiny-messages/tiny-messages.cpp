@@ -0,0 +1,55 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Two tiny messages share a split-duplex link with a large flow, that is either being set up (at time 0) or in progress
+ * (at time 0.5). Run it with --cfg=network/tiny-message-threshold to compare the analytic delays with the sharing
+ * system. */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(tiny_messages, "Messages specific for this test");
+namespace sg4 = simgrid::s4u;
+
+static void sender()
+{
+  sg4::Mailbox* tiny = sg4::Mailbox::by_name("tiny");
+  sg4::CommPtr large = sg4::Mailbox::by_name("large")->put_async(new int(0), 1e6);
+  tiny->put(new int(1), 100);
+  sg4::this_actor::sleep_until(0.5);
+  tiny->put(new int(2), 100);
+  large->wait();
+}
+
+static void receiver()
+{
+  int* payload       = nullptr;
+  sg4::CommPtr large = sg4::Mailbox::by_name("large")->get_async<int>(&payload);
+  sg4::Mailbox* tiny = sg4::Mailbox::by_name("tiny");
+  for (int i = 0; i < 2; i++) {
+    auto msg = tiny->get_unique<int>();
+    XBT_INFO("Got the tiny message #%d", *msg);
+  }
+  large->wait();
+  delete payload;
+  XBT_INFO("Got the large message");
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+
+  auto* zone           = e.get_netzone_root()->add_netzone_full("zone");
+  sg4::Host* src       = zone->add_host("src", 1e9);
+  sg4::Host* dst       = zone->add_host("dst", 1e9);
+  const auto* link     = zone->add_split_duplex_link("link", 1e6)->set_latency(1e-3);
+  zone->add_route(src, dst, {{link, sg4::LinkInRoute::Direction::UP}}, true);
+  zone->seal();
+
+  src->add_actor("sender", sender);
+  dst->add_actor("receiver", receiver);
+  e.run();
+
+  return 0;
+}
@@ -19,6 +19,7 @@ set(EXTRA_DIST
   src/kernel/resource/StandardLinkImpl.hpp
   src/kernel/resource/WifiLinkImpl.hpp
   src/kernel/resource/models/cpu_cas01.hpp
+  src/kernel/resource/models/cpu_multicore.hpp
   src/kernel/resource/models/cpu_ti.hpp
   src/kernel/resource/models/disk_s19.hpp
   src/kernel/resource/models/host_clm03.hpp
@@ -26,6 +27,7 @@ set(EXTRA_DIST
   src/kernel/resource/models/network_constant.hpp
   src/kernel/resource/models/network_ib.hpp
   src/kernel/resource/models/network_ns3.hpp
+  src/kernel/resource/models/network_packet.hpp
   src/kernel/resource/models/ns3/ns3_simulator.hpp
   src/kernel/resource/models/ptask_L07.hpp
 
@@ -55,6 +57,7 @@ set(EXTRA_DIST
   src/xbt/dict_private.h
   src/xbt/log_private.hpp
   src/xbt/mallocator_private.h
+  src/xbt/parallel.hpp
   src/xbt/parmap.hpp
   )
 
@@ -258,6 +261,7 @@ set(XBT_SRC
   src/xbt/dynar.cpp
   src/xbt/exception.cpp
   src/xbt/graph.c
+  src/xbt/intern.cpp
   src/xbt/log.cpp
   src/xbt/mallocator.c
   src/xbt/memory_map.cpp
@@ -364,11 +368,13 @@ set(KERNEL_SRC
   src/kernel/resource/WifiLinkImpl.cpp
 
   src/kernel/resource/models/cpu_cas01.cpp
+  src/kernel/resource/models/cpu_multicore.cpp
   src/kernel/resource/models/cpu_ti.cpp
   src/kernel/resource/models/disk_s19.cpp
   src/kernel/resource/models/host_clm03.cpp
   src/kernel/resource/models/network_cm02.cpp
   src/kernel/resource/models/network_constant.cpp
+  src/kernel/resource/models/network_packet.cpp
   src/kernel/resource/models/ptask_L07.cpp
 
   src/kernel/resource/profile/Event.hpp
@@ -389,6 +395,8 @@ set(KERNEL_SRC
   src/kernel/routing/FullZone.cpp
   src/kernel/routing/NetPoint.cpp
   src/kernel/routing/NetZoneImpl.cpp
+  src/kernel/routing/PlatformSnapshot.cpp
+  src/kernel/routing/PlatformSnapshot.hpp
   src/kernel/routing/RoutedZone.cpp
   src/kernel/routing/StarZone.cpp
   src/kernel/routing/TorusZone.cpp
@@ -725,6 +733,7 @@ set(headers_to_install
   include/xbt/functional.hpp
   include/xbt/function_types.h
   include/xbt/graph.h
+  include/xbt/intern.hpp
   include/xbt/log.h
   include/xbt/log.hpp
   include/xbt/mallocator.h
@@ -111,19 +111,23 @@ ENDMACRO()
 
 # New tests should use the Catch Framework
 set(UNIT_TESTS  src/xbt/unit-tests_main.cpp
+                src/kernel/resource/FactorSet_test.cpp
                 src/kernel/resource/NetworkModelFactors_test.cpp
                 src/kernel/resource/SplitDuplexLinkImpl_test.cpp
+                src/kernel/resource/models/cpu_ti_test.cpp
                 src/kernel/resource/profile/Profile_test.cpp
                 src/kernel/routing/DijkstraZone_test.cpp
                 src/kernel/routing/DragonflyZone_test.cpp
                 src/kernel/routing/FatTreeZone_test.cpp
                 src/kernel/routing/FloydZone_test.cpp
                 src/kernel/routing/FullZone_test.cpp
+                src/kernel/routing/PlatformSnapshot_test.cpp
                 src/kernel/routing/StarZone_test.cpp
                 src/kernel/routing/TorusZone_test.cpp
                 src/xbt/config_test.cpp
                 src/xbt/dict_test.cpp
                 src/xbt/dynar_test.cpp
+                src/xbt/intern_test.cpp
                 src/xbt/random_test.cpp
                 src/xbt/xbt_str_test.cpp
                 src/xbt/utils/iter/subsets_tests.cpp